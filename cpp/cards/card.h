@@ -1,13 +1,29 @@
 #ifndef CPP_CARDS_CARD_H
 #define CPP_CARDS_CARD_H
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
 namespace cards {
 
-enum class Suit { Clubs, Diamonds, Hearts, Spades };
-enum class Rank { Two, Three, Four, Five, Six, Seven, Eight, Nine, Ten, Jack, Queen, King, Ace };
+// One byte each, so that a Card is two bytes and piles of several decks stay small.
+enum class Suit : uint8_t { Clubs, Diamonds, Hearts, Spades };
+enum class Rank : uint8_t {
+  Two,
+  Three,
+  Four,
+  Five,
+  Six,
+  Seven,
+  Eight,
+  Nine,
+  Ten,
+  Jack,
+  Queen,
+  King,
+  Ace
+};
 
 class Card {
  public:
@@ -16,6 +32,12 @@ class Card {
   explicit Card(const int shuffleIndex)
       : suit(static_cast<Suit>(shuffleIndex % 4)), rank(static_cast<Rank>(shuffleIndex % 13)) {}
 
+  // The index in 0..51 that Card(int) maps to this card: congruent to the suit mod 4 and to the
+  // rank mod 13.
+  [[nodiscard]] int shuffleIndex() const {
+    return (40 * static_cast<int>(rank) + 13 * static_cast<int>(suit)) % 52;
+  }
+
   [[nodiscard]] const Suit& getSuit() const { return suit; }
   [[nodiscard]] const Rank& getRank() const { return rank; }
   bool operator==(const Card& o) const { return suit == o.suit && rank == o.rank; }
@@ -25,6 +47,9 @@ class Card {
   const Rank rank;
 };
 
+// Piles of Cards cost two bytes a card, only twice a Shoe's packed bytes.
+static_assert(sizeof(Card) == 2);
+
 };  // namespace cards
 
 #endif
@@ -0,0 +1,315 @@
+#include "cpp/cards/golf/bot_engine.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+#include "cpp/cards/golf/compact_game.h"
+#include "cpp/cards/golf/game_state.h"
+
+namespace golf {
+
+using std::chrono::steady_clock;
+
+TranspositionTable::TranspositionTable(int log2_entries)
+    : entries_(new Entry[size_t{1} << log2_entries]), mask_((uint64_t{1} << log2_entries) - 1) {}
+
+std::optional<float> TranspositionTable::probe(uint64_t key) const {
+  auto& entry = entries_[key & mask_];
+  uint64_t data = entry.data.load(std::memory_order_relaxed);
+  uint64_t check = entry.check.load(std::memory_order_relaxed);
+  if ((check ^ data) != key) {
+    return std::nullopt;
+  }
+  return std::bit_cast<float>(static_cast<uint32_t>(data));
+}
+
+void TranspositionTable::store(uint64_t key, float value) {
+  auto& entry = entries_[key & mask_];
+  uint64_t data = std::bit_cast<uint32_t>(value);
+  entry.data.store(data, std::memory_order_relaxed);
+  entry.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+namespace {
+constexpr int kRanks = 13;
+// Deeper than this the unseen-card model is too crude for the extra turns to mean much.
+constexpr int kMaxTurns = 6;
+
+// A hand as its ranks in ascending order.
+typedef std::array<uint8_t, kHandSize> Ranks;
+
+uint64_t Mix(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+int Score(const Ranks& hand) {
+  uint32_t odd_ranks = 0;
+  for (auto r : hand) {
+    odd_ranks ^= 1u << r;
+  }
+  int score = 0;
+  for (; odd_ranks != 0; odd_ranks &= odd_ranks - 1) {
+    score += kRankValues[std::countr_zero(odd_ranks)];
+  }
+  return score;
+}
+
+Ranks Replace(Ranks hand, int i, uint8_t rank) {
+  hand[i] = rank;
+  std::sort(hand.begin(), hand.end());
+  return hand;
+}
+
+// Swapping into either of two equal ranks gives the same hand.
+bool Distinct(const Ranks& hand, int i) { return i == 0 || hand[i] != hand[i - 1]; }
+
+class Search {
+ public:
+  Search(const std::array<uint8_t, kRanks>& unseen, TranspositionTable& table,
+         steady_clock::time_point deadline)
+      : unseen_(unseen), table_(table), deadline_(deadline) {
+    uint64_t packed = 0;
+    for (int r = 0; r < kRanks; r++) {
+      total_ += unseen[r];
+      // Up to 16 copies of a rank in a four-deck shoe, so base 17: exact within 64 bits.
+      packed = packed * 17 + unseen[r];
+    }
+    unseen_hash_ = Mix(packed);
+  }
+
+  // Only depth 1 runs without a deadline, so that there is always a move.
+  void setDeadline(bool enforce) { enforce_deadline_ = enforce; }
+  bool timedOut() const { return timed_out_; }
+  float probability(int rank) const { return static_cast<float>(unseen_[rank]) / total_; }
+
+  // Expected final score with `turns` turns left and the discard pile's top card not yet known.
+  float expected(const Ranks& hand, int turns) {
+    if (turns == 0 || total_ == 0) {
+      return static_cast<float>(Score(hand));
+    }
+    return cached(key(0, hand, turns, 0), [&] {
+      float value = 0;
+      for (int c = 0; c < kRanks; c++) {
+        if (unseen_[c] != 0) {
+          value += probability(c) * decide(hand, static_cast<uint8_t>(c), turns);
+        }
+      }
+      return value;
+    });
+  }
+
+  // Best expected score on a turn with `discard` on top of the discard pile, not counting knocks.
+  float decide(const Ranks& hand, uint8_t discard, int turns) {
+    return cached(key(1, hand, turns, discard), [&] {
+      float best = peek(hand, turns);
+      for (int i = 0; i < kHandSize; i++) {
+        if (Distinct(hand, i)) {
+          best = std::min(best, expected(Replace(hand, i, discard), turns - 1));
+        }
+      }
+      return best;
+    });
+  }
+
+  // Expected score of peeking at the draw pile and then keeping or discarding the card.
+  float peek(const Ranks& hand, int turns) {
+    float value = 0;
+    for (int x = 0; x < kRanks; x++) {
+      if (unseen_[x] != 0) {
+        value += probability(x) * afterPeek(hand, static_cast<uint8_t>(x), turns);
+      }
+    }
+    return value;
+  }
+
+  float afterPeek(const Ranks& hand, uint8_t drawn, int turns) {
+    float best = expected(hand, turns - 1);
+    for (int i = 0; i < kHandSize; i++) {
+      if (Distinct(hand, i)) {
+        best = std::min(best, expected(Replace(hand, i, drawn), turns - 1));
+      }
+    }
+    return best;
+  }
+
+ private:
+  uint64_t key(uint64_t kind, const Ranks& hand, int turns, uint8_t card) const {
+    uint64_t packed;
+    uint32_t ranks;
+    std::memcpy(&ranks, hand.data(), sizeof(ranks));
+    packed = ranks | uint64_t{static_cast<uint8_t>(turns)} << 32 | uint64_t{card} << 40 |
+             kind << 48;
+    // Key 0 would match an empty slot.
+    return (Mix(packed) ^ unseen_hash_) | 1;
+  }
+
+  template <typename F>
+  float cached(uint64_t k, F&& compute) {
+    if (auto hit = table_.probe(k)) {
+      return *hit;
+    }
+    if (enforce_deadline_ && (timed_out_ || (++nodes_ % 256 == 0 &&
+                                             steady_clock::now() >= deadline_))) {
+      timed_out_ = true;
+      return 0;
+    }
+    float value = compute();
+    // A value computed after the deadline hit is missing branches; never share it.
+    if (!timed_out_) {
+      table_.store(k, value);
+    }
+    return value;
+  }
+
+  const std::array<uint8_t, kRanks>& unseen_;
+  TranspositionTable& table_;
+  steady_clock::time_point deadline_;
+  int total_ = 0;
+  uint64_t unseen_hash_;
+  bool enforce_deadline_ = false;
+  bool timed_out_ = false;
+  uint32_t nodes_ = 0;
+};
+
+// What the player whose turn it is can see, taken from either kind of game. A GameState may hold
+// several decks and more players than a CompactGame, so the search never needs one.
+struct TableView {
+  // Ranks by hand position.
+  Ranks cards;
+  std::array<uint8_t, kRanks> unseen;
+  uint8_t discard_top = 0;
+  // The rank on top of the draw pile, once peeked at.
+  std::optional<uint8_t> drawn;
+  bool knocked = false;
+  int draw_size = 0;
+  int players = 0;
+};
+
+Action Choose(const TableView& view, TranspositionTable& table, float knock_margin,
+              steady_clock::time_point deadline) {
+  // Sorted ranks, and for each rank the position holding it.
+  Ranks hand = view.cards;
+  std::array<uint8_t, kRanks> position_of{};
+  for (int p = 0; p < kHandSize; p++) {
+    position_of[hand[p]] = static_cast<uint8_t>(p);
+  }
+  std::sort(hand.begin(), hand.end());
+
+  Search search(view.unseen, table, deadline);
+  int max_turns = view.knocked
+                      ? 1  // this is our last turn
+                      : std::clamp(view.draw_size / std::max(1, view.players), 1, kMaxTurns);
+
+  Action best_action{ActionType::Peek};
+  for (int turns = 1; turns <= max_turns; turns++) {
+    search.setDeadline(turns > 1);
+    Action action{ActionType::Peek};
+    float best = std::numeric_limits<float>::max();
+    auto consider = [&](float value, Action candidate) {
+      if (value < best) {
+        best = value;
+        action = candidate;
+      }
+    };
+
+    if (view.drawn) {
+      consider(search.expected(hand, turns - 1), {ActionType::SwapDrawForDiscard});
+      for (int i = 0; i < kHandSize; i++) {
+        if (Distinct(hand, i)) {
+          consider(search.expected(Replace(hand, i, *view.drawn), turns - 1),
+                   {ActionType::SwapForDraw, position_of[hand[i]]});
+        }
+      }
+    } else {
+      consider(search.peek(hand, turns), {ActionType::Peek});
+      for (int i = 0; i < kHandSize; i++) {
+        if (Distinct(hand, i)) {
+          consider(search.expected(Replace(hand, i, view.discard_top), turns - 1),
+                   {ActionType::SwapForDiscard, position_of[hand[i]]});
+        }
+      }
+      if (!view.knocked) {
+        consider(static_cast<float>(Score(hand)) - knock_margin, {ActionType::Knock});
+      }
+    }
+
+    if (search.timedOut()) {
+      break;
+    }
+    best_action = action;
+  }
+  return best_action;
+}
+
+}  // namespace
+
+Action BotEngine::chooseMove(const GameState& state, int player,
+                             std::chrono::microseconds budget) {
+  auto deadline = steady_clock::now() + budget;
+  auto& players = state.getPlayers();
+  auto& draw = state.getDrawPile();
+  auto& discard = state.getDiscardPile();
+
+  // GameManager deals from as many decks as the table needs; every card is somewhere.
+  size_t total = draw.size() + discard.size() + players.size() * kHandSize;
+  auto decks = static_cast<uint8_t>((total + 51) / 52);
+
+  TableView view;
+  view.unseen.fill(4 * decks);
+  for (int p = 0; p < kHandSize; p++) {
+    auto rank = static_cast<uint8_t>(players[player].cardAt(static_cast<Position>(p)).getRank());
+    view.cards[p] = rank;
+    view.unseen[rank]--;
+  }
+  for (auto& card : discard) {
+    view.unseen[static_cast<int>(card.getRank())]--;
+  }
+  if (!discard.empty()) {
+    view.discard_top = static_cast<uint8_t>(discard.back().getRank());
+  }
+  if (state.getPeekedAtDrawPile()) {
+    view.drawn = static_cast<uint8_t>(draw.back().getRank());
+    view.unseen[*view.drawn]--;
+  }
+  view.knocked = state.getWhoKnocked() != -1;
+  view.draw_size = static_cast<int>(draw.size());
+  view.players = static_cast<int>(players.size());
+  return Choose(view, table_, knock_margin_, deadline);
+}
+
+Action BotEngine::chooseMove(const CompactGame& game, int player,
+                             std::chrono::microseconds budget) {
+  auto deadline = steady_clock::now() + budget;
+
+  TableView view;
+  view.unseen.fill(4);
+  for (int p = 0; p < kHandSize; p++) {
+    auto rank = static_cast<uint8_t>(compactRank(game.hands[player][p]));
+    view.cards[p] = rank;
+    view.unseen[rank]--;
+  }
+  for (int i = 0; i < game.discard_size; i++) {
+    view.unseen[compactRank(game.discard[i])]--;
+  }
+  if (game.discard_size != 0) {
+    view.discard_top = static_cast<uint8_t>(compactRank(game.discardTop()));
+  }
+  if (game.peeked) {
+    view.drawn = static_cast<uint8_t>(compactRank(game.drawTop()));
+    view.unseen[*view.drawn]--;
+  }
+  view.knocked = game.who_knocked != -1;
+  view.draw_size = game.draw_size;
+  view.players = game.players;
+  return Choose(view, table_, knock_margin_, deadline);
+}
+
+}  // namespace golf
@@ -0,0 +1,60 @@
+#ifndef CPP_CARDS_GOLF_BOT_ENGINE_H
+#define CPP_CARDS_GOLF_BOT_ENGINE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include "cpp/cards/golf/compact_game.h"
+#include "cpp/cards/golf/game_state.h"
+
+namespace golf {
+
+// Fixed-size, lock-free cache of search values shared by every thread running a BotEngine. Each
+// slot stores key ^ data next to data, so a probe that races a store sees a key mismatch instead
+// of a torn value; the newest store to a slot always wins.
+class TranspositionTable {
+ public:
+  explicit TranspositionTable(int log2_entries);
+  std::optional<float> probe(uint64_t key) const;
+  void store(uint64_t key, float value);
+
+ private:
+  struct Entry {
+    std::atomic<uint64_t> check{0};
+    std::atomic<uint64_t> data{0};
+  };
+  std::unique_ptr<Entry[]> entries_;
+  uint64_t mask_;
+};
+
+// Picks moves for a seat by expectimax over the cards it cannot see. The bot knows its own hand
+// and the discard pile; the draw pile and the other hands are unseen, and every card it has not
+// seen is equally likely to be the next one drawn or discarded to it. It minimizes its expected
+// final score over its next few turns, deepening one turn at a time until the budget runs out, and
+// knocks when carrying on is not expected to gain `knock_margin` points.
+//
+// No rule reads a suit and a hand scores the same in any order, so search states are keyed on the
+// sorted ranks of the hand: all suit permutations and hand orderings share one table entry.
+class BotEngine {
+ public:
+  explicit BotEngine(int log2_table_entries = 20, float knock_margin = 1.5f)
+      : table_(log2_table_entries), knock_margin_(knock_margin) {}
+
+  // The move for `player`, whose turn it must be in a game that is not over. Returns within
+  // roughly `budget` plus one turn of depth-1 search, which always completes. Safe to call
+  // concurrently.
+  Action chooseMove(const GameState& state, int player, std::chrono::microseconds budget);
+  Action chooseMove(const CompactGame& game, int player, std::chrono::microseconds budget);
+
+ private:
+  TranspositionTable table_;
+  float knock_margin_;
+};
+
+}  // namespace golf
+
+#endif
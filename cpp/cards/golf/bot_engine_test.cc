@@ -0,0 +1,145 @@
+#include "cpp/cards/golf/bot_engine.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/compact_game.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/player.h"
+#include "cpp/cards/golf/simulator.h"
+#include "cpp/cards/golf/strategy.h"
+
+using namespace cards;
+using namespace golf;
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+namespace {
+GameState TwoPlayerGame(Player bot, std::deque<Card> discard, bool peeked, int who_knocked = -1) {
+  Player other{"human", Card(Suit::Clubs, Rank::King), Card(Suit::Diamonds, Rank::King),
+               Card(Suit::Hearts, Rank::Queen), Card(Suit::Spades, Rank::Queen)};
+  std::deque<Card> draw;
+  for (int i = 0; i < 20; i++) {
+    draw.emplace_back(Suit::Hearts, static_cast<Rank>(i % 8));
+  }
+  draw.emplace_back(Suit::Spades, Rank::Jack);  // top of the draw pile
+  return GameState{draw, discard, {bot, other}, peeked, 0, who_knocked};
+}
+
+// Plays a strategy that asks the engine for every move, so it can face other strategies in
+// PlayGame.
+class EngineStrategy final : public Strategy {
+ public:
+  Action choose(const CompactGame& game, SimRng&) const override {
+    return engine_.chooseMove(game, game.whose_turn, microseconds(200));
+  }
+  std::string name() const override { return "expectimax"; }
+
+ private:
+  mutable BotEngine engine_{16};
+};
+}  // namespace
+
+TEST(TranspositionTable, ProbeAfterStore) {
+  TranspositionTable table{4};
+  EXPECT_FALSE(table.probe(12345).has_value());
+  table.store(12345, 2.5f);
+  EXPECT_EQ(table.probe(12345), 2.5f);
+  // Same slot, different key.
+  EXPECT_FALSE(table.probe(12345 + 16).has_value());
+  table.store(12345 + 16, 1.0f);
+  EXPECT_FALSE(table.probe(12345).has_value());
+}
+
+TEST(BotEngine, TakesDiscardThatPairs) {
+  BotEngine engine{12};
+  Player bot{"bot-1", Card(Suit::Clubs, Rank::Ace), Card(Suit::Clubs, Rank::Two),
+             Card(Suit::Clubs, Rank::Three), Card(Suit::Clubs, Rank::King)};
+  auto state = TwoPlayerGame(bot, {Card(Suit::Hearts, Rank::Ace)}, false);
+
+  auto action = engine.chooseMove(state, 0, milliseconds(5));
+  EXPECT_EQ(action.type, ActionType::SwapForDiscard);
+  EXPECT_EQ(static_cast<Position>(action.position), Position::BottomRight);  // the king
+}
+
+TEST(BotEngine, KeepsGoodDrawnCard) {
+  BotEngine engine{12};
+  Player bot{"bot-1", Card(Suit::Clubs, Rank::Ace), Card(Suit::Clubs, Rank::Two),
+             Card(Suit::Clubs, Rank::Jack), Card(Suit::Clubs, Rank::King)};
+  // The peeked card is the jack on top of the draw pile; it pairs with the bot's jack.
+  auto state = TwoPlayerGame(bot, {Card(Suit::Hearts, Rank::Nine)}, true);
+
+  auto action = engine.chooseMove(state, 0, milliseconds(5));
+  EXPECT_EQ(action.type, ActionType::SwapForDraw);
+  EXPECT_EQ(static_cast<Position>(action.position), Position::BottomRight);
+}
+
+TEST(BotEngine, KnocksWithLowHand) {
+  BotEngine engine{12};
+  Player bot{"bot-1", Card(Suit::Clubs, Rank::Jack), Card(Suit::Diamonds, Rank::Jack),
+             Card(Suit::Clubs, Rank::Four), Card(Suit::Diamonds, Rank::Four)};
+  auto state = TwoPlayerGame(bot, {Card(Suit::Hearts, Rank::Nine)}, false);
+
+  EXPECT_EQ(engine.chooseMove(state, 0, milliseconds(5)).type, ActionType::Knock);
+
+  // After someone else knocks it can only improve its hand.
+  auto knocked = TwoPlayerGame(bot, {Card(Suit::Hearts, Rank::Nine)}, false, 1);
+  EXPECT_NE(engine.chooseMove(knocked, 0, milliseconds(5)).type, ActionType::Knock);
+}
+
+TEST(BotEngine, PlaysAtMultiDeckTable) {
+  BotEngine engine{12};
+  // Eight players dealt from two decks: more than a CompactGame holds.
+  Player bot{"bot-1", Card(Suit::Clubs, Rank::Ace), Card(Suit::Clubs, Rank::Two),
+             Card(Suit::Clubs, Rank::Three), Card(Suit::Clubs, Rank::King)};
+  std::vector<Player> players{bot};
+  for (int i = 1; i < 8; i++) {
+    players.emplace_back(Card(Suit::Hearts, Rank::Five), Card(Suit::Hearts, Rank::Six),
+                         Card(Suit::Hearts, Rank::Seven), Card(Suit::Hearts, Rank::Eight));
+  }
+  std::deque<Card> draw;
+  for (int i = 0; i < 71; i++) {
+    draw.emplace_back(i % 52);
+  }
+  GameState state{draw, {Card(Suit::Spades, Rank::Ace)}, players, false, 0, -1};
+
+  auto action = engine.chooseMove(state, 0, milliseconds(5));
+  EXPECT_EQ(action.type, ActionType::SwapForDiscard);
+  EXPECT_EQ(static_cast<Position>(action.position), Position::BottomRight);  // the king
+}
+
+TEST(BotEngine, RespectsBudget) {
+  BotEngine engine{20};
+  SimRng rng(11);
+  auto game = CompactGame::deal(2, rng);
+  auto start = std::chrono::steady_clock::now();
+  engine.chooseMove(game, 0, milliseconds(2));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, milliseconds(50));
+}
+
+TEST(BotEngine, BeatsGreedy) {
+  EngineStrategy bot;
+  GreedyStrategy greedy;
+  int bot_wins = 0;
+  int greedy_wins = 0;
+  for (uint64_t seed = 0; seed < 200; seed++) {
+    SimRng rng(seed);
+    auto game = CompactGame::deal(2, rng);
+    // Alternate who moves first.
+    std::array<const Strategy*, kMaxPlayers> seats{};
+    int bot_seat = static_cast<int>(seed % 2);
+    seats[bot_seat] = &bot;
+    seats[1 - bot_seat] = &greedy;
+    auto result = PlayGame(game, seats, rng, 1000);
+    ASSERT_FALSE(result.stalled);
+    auto winners = game.winners();
+    bot_wins += (winners >> bot_seat) & 1;
+    greedy_wins += (winners >> (1 - bot_seat)) & 1;
+  }
+  EXPECT_GT(bot_wins, greedy_wins);
+}
@@ -0,0 +1,175 @@
+#include "cpp/cards/golf/compact_game.h"
+
+#include <optional>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/rules.h"
+
+namespace golf {
+
+CompactCard toCompact(const Card& card) { return static_cast<CompactCard>(card.shuffleIndex()); }
+
+Card fromCompact(CompactCard card) { return Card{card % 52}; }
+
+template <typename R>
+  requires GolfRules<R>
+BasicCompactGame<R> BasicCompactGame<R>::fromDeck(int players,
+                                                  const std::array<CompactCard, kDeckSize>& deck) {
+  BasicCompactGame game{};
+  game.draw = deck;
+  game.players = static_cast<uint8_t>(players);
+
+  // Mirrors GameManager::newGame: each player gets a row, then the next row goes round.
+  auto dealtCard = [&](int i) { return deck[kDeckSize - 1 - i]; };
+  constexpr int rows = kHandSize / R::kRowSize;
+  for (int row = 0; row < rows; row++) {
+    for (int p = 0; p < players; p++) {
+      for (int c = 0; c < R::kRowSize; c++) {
+        game.hands[p][row * R::kRowSize + c] =
+            dealtCard(row * players * R::kRowSize + p * R::kRowSize + c);
+      }
+    }
+  }
+  game.draw_size = static_cast<uint8_t>(kDeckSize - players * kHandSize);
+  game.discard[0] = game.draw[--game.draw_size];
+  game.discard_size = 1;
+  return game;
+}
+
+template <typename R>
+  requires GolfRules<R>
+std::optional<BasicCompactGame<R>> BasicCompactGame<R>::from(const GameState& state)
+  requires std::same_as<R, FourCardRules>
+{
+  auto& players = state.getPlayers();
+  if (players.size() > kMaxPlayers || state.getDrawPile().size() > kDeckSize ||
+      state.getDiscardPile().size() > kDeckSize) {
+    return std::nullopt;
+  }
+  BasicCompactGame game{};
+  for (auto& card : state.getDrawPile()) {
+    game.draw[game.draw_size++] = toCompact(card);
+  }
+  for (auto& card : state.getDiscardPile()) {
+    game.discard[game.discard_size++] = toCompact(card);
+  }
+  for (auto& player : players) {
+    auto& hand = game.hands[game.players++];
+    for (int p = 0; p < kHandSize; p++) {
+      hand[p] = toCompact(player.cardAt(static_cast<Position>(p)));
+    }
+  }
+  game.whose_turn = static_cast<uint8_t>(state.getWhoseTurn());
+  game.who_knocked = static_cast<int8_t>(state.getWhoKnocked());
+  game.peeked = state.getPeekedAtDrawPile();
+  return game;
+}
+
+template <typename R>
+  requires GolfRules<R>
+uint32_t BasicCompactGame<R>::winners() const {
+  uint32_t winning = 0;
+  int min_score = maxScore<R>() + 1;
+  for (int p = 0; p < players; p++) {
+    int s = score(p);
+    if (s < min_score) {
+      min_score = s;
+      winning = 0;
+    }
+    if (s == min_score) {
+      winning |= 1u << p;
+    }
+  }
+  if (who_knocked >= 0 && (winning & (1u << who_knocked)) != 0) {
+    winning = 1u << who_knocked;
+  }
+  return winning;
+}
+
+template <typename R>
+  requires GolfRules<R>
+void BasicCompactGame<R>::endTurn() {
+  peeked = false;
+  whose_turn = static_cast<uint8_t>((whose_turn + 1) % players);
+}
+
+template <typename R>
+  requires GolfRules<R>
+bool BasicCompactGame<R>::peekAtDrawPile() {
+  if (isOver() || peeked) {
+    return false;
+  }
+  peeked = true;
+  return true;
+}
+
+template <typename R>
+  requires GolfRules<R>
+bool BasicCompactGame<R>::swapForDrawPile(int position) {
+  if (isOver()) {
+    return false;
+  }
+  auto& slot = hands[whose_turn][position];
+  discard[discard_size++] = slot;
+  slot = draw[--draw_size];
+  endTurn();
+  return true;
+}
+
+template <typename R>
+  requires GolfRules<R>
+bool BasicCompactGame<R>::swapDrawForDiscardPile() {
+  if (isOver()) {
+    return false;
+  }
+  discard[discard_size++] = draw[--draw_size];
+  endTurn();
+  return true;
+}
+
+template <typename R>
+  requires GolfRules<R>
+bool BasicCompactGame<R>::swapForDiscardPile(int position) {
+  if (isOver() || peeked || discard_size == 0) {
+    return false;
+  }
+  std::swap(hands[whose_turn][position], discard[discard_size - 1]);
+  endTurn();
+  return true;
+}
+
+template <typename R>
+  requires GolfRules<R>
+bool BasicCompactGame<R>::knock() {
+  if (!canKnock()) {
+    return false;
+  }
+  who_knocked = static_cast<int8_t>(whose_turn);
+  endTurn();
+  return true;
+}
+
+template <typename R>
+  requires GolfRules<R>
+bool BasicCompactGame<R>::apply(Action action) {
+  switch (action.type) {
+    case ActionType::Peek:
+      return peekAtDrawPile();
+    case ActionType::SwapForDraw:
+      return swapForDrawPile(action.position);
+    case ActionType::SwapDrawForDiscard:
+      return swapDrawForDiscardPile();
+    case ActionType::SwapForDiscard:
+      return swapForDiscardPile(action.position);
+    case ActionType::Knock:
+      return knock();
+  }
+  return false;
+}
+
+template struct BasicCompactGame<FourCardRules>;
+template struct BasicCompactGame<SixCardRules>;
+template struct BasicCompactGame<NineCardRules>;
+
+}  // namespace golf
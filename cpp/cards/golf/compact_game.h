@@ -0,0 +1,141 @@
+#ifndef CPP_CARDS_GOLF_COMPACT_GAME_H
+#define CPP_CARDS_GOLF_COMPACT_GAME_H
+
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/rules.h"
+
+namespace golf {
+
+// A card as its shuffle index within the shoe, 0..deckSize<R>()-1. Index i is the same card as
+// cards::Card(i % 52); a shoe of several decks holds 52 apart the copies of each card.
+typedef uint8_t CompactCard;
+
+// The four-card game that GameState plays.
+inline constexpr int kDeckSize = deckSize<FourCardRules>();
+inline constexpr int kHandSize = FourCardRules::kHandSize;
+inline constexpr int kMaxPlayers = FourCardRules::kMaxPlayers;
+inline constexpr std::array<uint8_t, 13> kRankValues = FourCardRules::kRankValues;
+
+inline constexpr int compactRank(CompactCard c) { return c % 13; }
+inline constexpr int compactSuit(CompactCard c) { return c % 4; }
+CompactCard toCompact(const Card& card);
+Card fromCompact(CompactCard card);
+
+// Player::score over compact cards: ranks held an even number of times cancel out.
+template <typename R = FourCardRules>
+int compactScore(const std::array<CompactCard, R::kHandSize>& hand) {
+  uint32_t odd_ranks = 0;
+  for (auto c : hand) {
+    odd_ranks ^= 1u << compactRank(c);
+  }
+  int score = 0;
+  for (; odd_ranks != 0; odd_ranks &= odd_ranks - 1) {
+    score += R::kRankValues[__builtin_ctz(odd_ranks)];
+  }
+  return score;
+}
+
+enum class ActionType : uint8_t { Peek, SwapForDraw, SwapDrawForDiscard, SwapForDiscard, Knock };
+
+struct Action {
+  ActionType type;
+  // Hand position for the swaps: the Position enum's value in the four-card game, and the index
+  // into the hand, row by row, in general.
+  uint8_t position = 0;
+};
+
+// The GameState rules on a fixed-size, trivially copyable value, for self-play and search where a
+// GameState per move (deques, vectors, strings) would dominate. Names, ids and versions are not
+// kept. Each transition checks the same preconditions as its GameState counterpart and returns
+// false, leaving the game unchanged, where GameState would return an error.
+//
+// R picks the variant; CompactGame is the four-card game GameState plays.
+template <typename R>
+  requires GolfRules<R>
+struct BasicCompactGame {
+  typedef R Rules;
+  static constexpr int kDeckSize = deckSize<R>();
+  static constexpr int kHandSize = R::kHandSize;
+  static constexpr int kMaxPlayers = R::kMaxPlayers;
+  typedef std::array<CompactCard, kHandSize> Hand;
+
+  // Piles are stacks: the top card is the last one.
+  std::array<CompactCard, kDeckSize> draw;
+  std::array<CompactCard, kDeckSize> discard;
+  std::array<Hand, kMaxPlayers> hands;
+  uint8_t draw_size = 0;
+  uint8_t discard_size = 0;
+  uint8_t players = 0;
+  uint8_t whose_turn = 0;
+  int8_t who_knocked = -1;
+  bool peeked = false;
+
+  // A shuffled shoe dealt the way GameManager::newGame deals it. Each rng() call must supply at
+  // least 32 random low bits.
+  template <typename Rng>
+  static BasicCompactGame deal(int players, Rng& rng);
+  // Deals from `deck`, whose last card is the top of the pile: a row of each hand at a time, then
+  // one card to start the discard pile.
+  static BasicCompactGame fromDeck(int players, const std::array<CompactCard, kDeckSize>& deck);
+
+  // The same game from a GameState; nullopt if it has more players or cards than fit.
+  static std::optional<BasicCompactGame> from(const GameState& state)
+    requires std::same_as<R, FourCardRules>;
+
+  bool isOver() const { return draw_size == 0 || whose_turn == who_knocked; }
+  CompactCard drawTop() const { return draw[draw_size - 1]; }
+  CompactCard discardTop() const { return discard[discard_size - 1]; }
+  int score(int player) const { return compactScore<R>(hands[player]); }
+  // Whether the player whose turn it is may knock now.
+  bool canKnock() const {
+    return !isOver() && !peeked && who_knocked == -1 && score(whose_turn) <= R::kKnockLimit;
+  }
+  // Bit i set for each winning player, with GameState::winners' tie-break for the knocker.
+  uint32_t winners() const;
+
+  bool peekAtDrawPile();
+  bool swapForDrawPile(int position);
+  bool swapDrawForDiscardPile();
+  bool swapForDiscardPile(int position);
+  bool knock();
+  // Applies `action` for the player whose turn it is.
+  bool apply(Action action);
+
+ private:
+  void endTurn();
+};
+
+typedef BasicCompactGame<FourCardRules> CompactGame;
+
+// Defined in compact_game.cc for each preset variant.
+extern template struct BasicCompactGame<FourCardRules>;
+extern template struct BasicCompactGame<SixCardRules>;
+extern template struct BasicCompactGame<NineCardRules>;
+
+template <typename R>
+  requires GolfRules<R>
+template <typename Rng>
+BasicCompactGame<R> BasicCompactGame<R>::deal(int players, Rng& rng) {
+  std::array<CompactCard, kDeckSize> deck;
+  for (int i = 0; i < kDeckSize; i++) {
+    deck[i] = static_cast<CompactCard>(i);
+  }
+  // Fisher-Yates with Lemire's multiply-shift bound, cheaper than uniform_int_distribution.
+  for (uint32_t i = kDeckSize - 1; i > 0; i--) {
+    auto bits = static_cast<uint64_t>(static_cast<uint32_t>(rng()));
+    auto j = static_cast<uint32_t>((bits * (i + 1)) >> 32);
+    std::swap(deck[i], deck[j]);
+  }
+  return fromDeck(players, deck);
+}
+
+}  // namespace golf
+
+#endif
@@ -0,0 +1,156 @@
+#include "cpp/cards/golf/compact_game.h"
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/player.h"
+#include "cpp/cards/golf/strategy.h"
+
+using namespace cards;
+using namespace golf;
+
+TEST(CompactGame, CardRoundTrip) {
+  for (int i = 0; i < kDeckSize; i++) {
+    Card card{i};
+    EXPECT_EQ(toCompact(card), i);
+    EXPECT_EQ(fromCompact(static_cast<CompactCard>(i)), card);
+  }
+}
+
+TEST(CompactGame, ScoreMatchesPlayer) {
+  SimRng rng(3);
+  for (int i = 0; i < 1000; i++) {
+    std::array<CompactCard, kHandSize> hand;
+    for (auto& c : hand) {
+      c = static_cast<CompactCard>(rng.below(kDeckSize));
+    }
+    Player player{fromCompact(hand[0]), fromCompact(hand[1]), fromCompact(hand[2]),
+                  fromCompact(hand[3])};
+    EXPECT_EQ(compactScore(hand), player.score());
+  }
+}
+
+TEST(CompactGame, DealsLikeGameManager) {
+  std::array<CompactCard, kDeckSize> deck;
+  for (int i = 0; i < kDeckSize; i++) {
+    deck[i] = static_cast<CompactCard>(i);
+  }
+  auto game = CompactGame::fromDeck(2, deck);
+
+  // Dealt from the back: 51, 50 up for player 0, 49, 48 up for player 1, then the down cards.
+  EXPECT_EQ(game.hands[0], (std::array<CompactCard, kHandSize>{51, 50, 47, 46}));
+  EXPECT_EQ(game.hands[1], (std::array<CompactCard, kHandSize>{49, 48, 45, 44}));
+  EXPECT_EQ(game.discard_size, 1);
+  EXPECT_EQ(game.discardTop(), 43);
+  EXPECT_EQ(game.draw_size, 43);
+  EXPECT_EQ(game.drawTop(), 42);
+}
+
+// Plays random moves on a GameState and a CompactGame side by side; every transition must agree
+// on legality and on the resulting game.
+TEST(CompactGame, MatchesGameStateRules) {
+  RandomStrategy strategy;
+  for (uint64_t seed = 0; seed < 200; seed++) {
+    SimRng rng(seed);
+    int players = 2 + static_cast<int>(seed % 4);
+    auto compact = CompactGame::deal(players, rng);
+
+    std::deque<Card> draw;
+    std::deque<Card> discard;
+    for (int i = 0; i < compact.draw_size; i++) {
+      draw.push_back(fromCompact(compact.draw[i]));
+    }
+    discard.push_back(fromCompact(compact.discardTop()));
+    std::vector<Player> hands;
+    for (int p = 0; p < players; p++) {
+      auto& h = compact.hands[p];
+      hands.emplace_back("p" + std::to_string(p), fromCompact(h[0]), fromCompact(h[1]),
+                         fromCompact(h[2]), fromCompact(h[3]));
+    }
+    // GameState is not assignable, so each transition re-emplaces it.
+    std::optional<GameState> state;
+    state.emplace(draw, discard, hands, false, 0, -1);
+
+    for (int move = 0; move < 300 && !state->isOver(); move++) {
+      auto action = strategy.choose(compact, rng);
+      auto position = static_cast<Position>(action.position);
+      int player = state->getWhoseTurn();
+      auto next = [&]() -> absl::StatusOr<GameState> {
+        switch (action.type) {
+          case ActionType::Peek:
+            return state->peekAtDrawPile(player);
+          case ActionType::SwapForDraw:
+            return state->swapForDrawPile(player, position);
+          case ActionType::SwapDrawForDiscard:
+            return state->swapDrawForDiscardPile(player);
+          case ActionType::SwapForDiscard:
+            return state->swapForDiscardPile(player, position);
+          case ActionType::Knock:
+            return state->knock(player);
+        }
+        return absl::UnknownError("unknown action");
+      }();
+      ASSERT_EQ(compact.apply(action), next.ok());
+      ASSERT_TRUE(next.ok());
+      state.emplace(*next);
+    }
+
+    auto expected = CompactGame::from(*state);
+    ASSERT_TRUE(expected.has_value());
+    EXPECT_EQ(compact.isOver(), state->isOver());
+    EXPECT_EQ(compact.whose_turn, expected->whose_turn);
+    EXPECT_EQ(compact.who_knocked, expected->who_knocked);
+    EXPECT_EQ(compact.draw_size, expected->draw_size);
+    EXPECT_EQ(compact.discard_size, expected->discard_size);
+    EXPECT_EQ(compact.hands, expected->hands);
+    uint32_t winners = 0;
+    for (int w : state->winners()) {
+      winners |= 1u << w;
+    }
+    EXPECT_EQ(compact.winners(), winners);
+  }
+}
+
+template <typename R>
+void ExpectFullShoeDealt() {
+  SimRng rng(11);
+  auto game = BasicCompactGame<R>::deal(R::kMaxPlayers, rng);
+  std::vector<int> seen(deckSize<R>());
+  for (int i = 0; i < game.draw_size; i++) {
+    seen[game.draw[i]]++;
+  }
+  for (int i = 0; i < game.discard_size; i++) {
+    seen[game.discard[i]]++;
+  }
+  for (int p = 0; p < game.players; p++) {
+    for (auto c : game.hands[p]) {
+      seen[c]++;
+    }
+  }
+  EXPECT_EQ(seen, std::vector<int>(deckSize<R>(), 1));
+  EXPECT_EQ(game.draw_size, deckSize<R>() - R::kMaxPlayers * R::kHandSize - 1);
+  EXPECT_LE(game.score(0), maxScore<R>());
+}
+
+TEST(CompactGame, VariantsDealWholeShoe) {
+  ExpectFullShoeDealt<FourCardRules>();
+  ExpectFullShoeDealt<SixCardRules>();
+  ExpectFullShoeDealt<NineCardRules>();
+  EXPECT_EQ(maxScore<SixCardRules>(), 54);
+  EXPECT_EQ(maxScore<NineCardRules>(), 69);
+}
+
+TEST(CompactGame, NineCardHandScoresPairsAcrossDecks) {
+  // Both copies of the two of clubs cancel, as two twos of different suits would.
+  std::array<CompactCard, 9> hand{0, 52, 1, 2, 3, 4, 5, 6, 7};
+  std::array<CompactCard, 9> without_pair{13, 26, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(compactScore<NineCardRules>(hand), compactScore<NineCardRules>(without_pair));
+  EXPECT_EQ(fromCompact(52), fromCompact(0));
+}
@@ -1,6 +1,8 @@
 #include "cpp/cards/golf/doc_db_game_store.h"
 
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "protos/golf/golf_model.pb.h"
 
@@ -40,16 +42,6 @@ StatusOr<std::unordered_set<string>> DocDbGameStore::GetUsers() const {
   return absl::UnimplementedError("todo");
 }
 
-static const unordered_map<const Rank, const golf_proto::Rank> PROTO_RANK_BY_RANK{
-    {Rank::Two, golf_proto::Rank::Two},     {Rank::Three, golf_proto::Rank::Three},
-    {Rank::Four, golf_proto::Rank::Four},   {Rank::Five, golf_proto::Rank::Five},
-    {Rank::Six, golf_proto::Rank::Six},     {Rank::Seven, golf_proto::Rank::Seven},
-    {Rank::Eight, golf_proto::Rank::Eight}, {Rank::Nine, golf_proto::Rank::Nine},
-    {Rank::Ten, golf_proto::Rank::Ten},     {Rank::Jack, golf_proto::Rank::Jack},
-    {Rank::Queen, golf_proto::Rank::Queen}, {Rank::King, golf_proto::Rank::King},
-    {Rank::Ace, golf_proto::Rank::Ace},
-};
-
 static const unordered_map<golf_proto::Rank, Rank> RANK_BY_PROTO_RANK{
     {golf_proto::Rank::Two, Rank::Two},     {golf_proto::Rank::Three, Rank::Three},
     {golf_proto::Rank::Four, Rank::Four},   {golf_proto::Rank::Five, Rank::Five},
@@ -60,68 +52,57 @@ static const unordered_map<golf_proto::Rank, Rank> RANK_BY_PROTO_RANK{
     {golf_proto::Rank::Ace, Rank::Ace},
 };
 
-static const unordered_map<Suit, golf_proto::Suit> PROTO_SUIT_BY_SUIT{
-    {Suit::Clubs, golf_proto::Suit::Clubs},
-    {Suit::Diamonds, golf_proto::Suit::Diamonds},
-    {Suit::Hearts, golf_proto::Suit::Hearts},
-    {Suit::Spades, golf_proto::Suit::Spades}};
-
 static const unordered_map<golf_proto::Suit, Suit> SUIT_BY_PROTO_SUIT{
     {golf_proto::Suit::Clubs, Suit::Clubs},
     {golf_proto::Suit::Diamonds, Suit::Diamonds},
     {golf_proto::Suit::Hearts, Suit::Hearts},
     {golf_proto::Suit::Spades, Suit::Spades}};
 
-auto card_to_proto(const Card& card) -> golf_proto::Card* {
-  golf_proto::Card* card_proto = new golf_proto::Card();
-  card_proto->set_rank(PROTO_RANK_BY_RANK.at(card.getRank()));
-  card_proto->set_suit(PROTO_SUIT_BY_SUIT.at(card.getSuit()));
-  return card_proto;
-}
-
 auto proto_to_card(const golf_proto::Card& proto) -> Card {
   return Card{SUIT_BY_PROTO_SUIT.at(proto.suit()), RANK_BY_PROTO_RANK.at(proto.rank())};
 }
 
+auto pack_card(const Card& card) -> char { return static_cast<char>(card.shuffleIndex()); }
+
+auto unpack_card(char c) -> Card { return Card{static_cast<unsigned char>(c) % 52}; }
+
 auto proto_to_player(const golf_proto::Player& proto) -> Player {
+  auto& packed = proto.packed_hand();
+  auto card = [&](int i, const golf_proto::Card& legacy) {
+    return proto.has_hand() ? proto_to_card(legacy) : unpack_card(packed[i]);
+  };
+  auto& hand = proto.hand();
+  Card tl = card(0, hand.top_left()), tr = card(1, hand.top_right()),
+       bl = card(2, hand.bottom_left()), br = card(3, hand.bottom_right());
   if (proto.has_name()) {
-    return Player{proto.name(), proto_to_card(proto.hand().top_left()),
-                  proto_to_card(proto.hand().top_right()),
-                  proto_to_card(proto.hand().bottom_left()),
-                  proto_to_card(proto.hand().bottom_right())};
+    return Player{proto.name(), tl, tr, bl, br};
   }
-
-  return Player{proto_to_card(proto.hand().top_left()), proto_to_card(proto.hand().top_right()),
-                proto_to_card(proto.hand().bottom_left()),
-                proto_to_card(proto.hand().bottom_right())};
+  return Player{tl, tr, bl, br};
 }
 
 auto game_to_proto(const GameStatePtr game_state) -> BackendGameState {
   BackendGameState game_proto;
-  game_proto.set_peeked_at_draw_pile(false);
-  game_proto.set_who_knocked(-1);
-  game_proto.set_whose_turn(0);
+  game_proto.set_peeked_at_draw_pile(game_state->getPeekedAtDrawPile());
+  game_proto.set_who_knocked(game_state->getWhoKnocked());
+  game_proto.set_whose_turn(game_state->getWhoseTurn());
+  auto* discard = game_proto.mutable_packed_discard_pile();
   for (auto& c : game_state->getDiscardPile()) {
-    golf_proto::Card* card_proto = game_proto.add_discard_pile();
-    card_proto->set_rank(PROTO_RANK_BY_RANK.at(c.getRank()));
-    card_proto->set_suit(PROTO_SUIT_BY_SUIT.at(c.getSuit()));
+    discard->push_back(pack_card(c));
   }
+  auto* draw = game_proto.mutable_packed_draw_pile();
   for (auto& c : game_state->getDrawPile()) {
-    golf_proto::Card* card_proto = game_proto.add_draw_pile();
-    card_proto->set_rank(PROTO_RANK_BY_RANK.at(c.getRank()));
-    card_proto->set_suit(PROTO_SUIT_BY_SUIT.at(c.getSuit()));
+    draw->push_back(pack_card(c));
   }
   for (auto& p : game_state->getPlayers()) {
     golf_proto::Player* player_proto = game_proto.add_players();
     if (p.getName().has_value()) {
       player_proto->set_name(p.getName().value());
     }
-    golf_proto::Hand* hand = new golf_proto::Hand();
-    hand->set_allocated_bottom_left(card_to_proto(p.cardAt(Position::BottomLeft)));
-    hand->set_allocated_bottom_right(card_to_proto(p.cardAt(Position::BottomRight)));
-    hand->set_allocated_top_left(card_to_proto(p.cardAt(Position::TopLeft)));
-    hand->set_allocated_top_right(card_to_proto(p.cardAt(Position::TopRight)));
-    player_proto->set_allocated_hand(hand);
+    auto* hand = player_proto->mutable_packed_hand();
+    for (auto position :
+         {Position::TopLeft, Position::TopRight, Position::BottomLeft, Position::BottomRight}) {
+      hand->push_back(pack_card(p.cardAt(position)));
+    }
   }
 
   return game_proto;
@@ -140,17 +121,51 @@ StatusOr<GameStatePtr> DocDbGameStore::NewGame(const GameStatePtr game_state) {
       game_state->withIdAndVersion(doc_id_and_version.id, doc_id_and_version.version));
 }
 
+// DocDb has neither bulk insert nor delete, so this is one InsertDoc per game, in order, and the
+// games before a failed one stay stored. They are remembered under `batch_key`, and a retry with
+// that key picks up after them.
+StatusOr<std::vector<GameStatePtr>> DocDbGameStore::NewGames(
+    const std::vector<GameStatePtr>& game_states, const string& batch_key) {
+  std::vector<GameStatePtr> stored;
+  if (!batch_key.empty()) {
+    std::scoped_lock lock{mutex_};
+    if (auto it = partial_batches_.find(batch_key); it != partial_batches_.end()) {
+      stored = std::move(it->second);
+      partial_batches_.erase(it);
+    }
+  }
+  stored.reserve(game_states.size());
+  for (size_t i = stored.size(); i < game_states.size(); i++) {
+    auto status = NewGame(game_states[i]);
+    if (!status.ok()) {
+      if (!batch_key.empty() && !stored.empty()) {
+        std::scoped_lock lock{mutex_};
+        partial_batches_[batch_key] = std::move(stored);
+      }
+      return status.status();
+    }
+    stored.push_back(*std::move(status));
+  }
+  return stored;
+}
+
 auto proto_to_game_state(const BackendGameState& proto, const string& game_id,
                          const string& version_id) -> GameState {
   std::deque<Card> mutableDrawPile{};
   for (auto& c : proto.draw_pile()) {
     mutableDrawPile.push_back(proto_to_card(c));
   }
+  for (auto c : proto.packed_draw_pile()) {
+    mutableDrawPile.push_back(unpack_card(c));
+  }
   const std::deque<Card> drawPile = std::move(mutableDrawPile);
   std::deque<Card> mutableDiscardPile{};
   for (auto& c : proto.discard_pile()) {
     mutableDiscardPile.push_back(proto_to_card(c));
   }
+  for (auto c : proto.packed_discard_pile()) {
+    mutableDiscardPile.push_back(unpack_card(c));
+  }
   const std::deque<Card> discardPile = std::move(mutableDiscardPile);
   std::vector<Player> mutablePlayers{};
   for (auto& p : proto.players()) {
@@ -173,10 +188,27 @@ StatusOr<GameStatePtr> DocDbGameStore::ReadGame(const string& game_id) const {
   if (!game_state_proto.ParseFromString(doc.bytes)) {
     return absl::InternalError("internal error");
   }
+  for (auto& player : game_state_proto.players()) {
+    if (!player.has_hand() && player.packed_hand().size() != 4) {
+      return absl::InternalError("internal error");
+    }
+  }
 
   return std::make_shared<GameState>(proto_to_game_state(game_state_proto, game_id, version_id));
 }
 
+StatusOr<GameStatePtr> DocDbGameStore::ReadGameForUser(const string& game_id,
+                                                       const string& user_id) const {
+  auto game = ReadGame(game_id);
+  if (!game.ok()) {
+    return game.status();
+  }
+  if ((*game)->playerIndex(user_id) < 0) {
+    return absl::PermissionDeniedError("not in this game");
+  }
+  return game;
+}
+
 StatusOr<GameStatePtr> DocDbGameStore::ReadGameByUserId(const string& user_id) const {
   return absl::UnimplementedError("todo");
 }
@@ -2,9 +2,11 @@
 #define CPP_CARDS_GOLF_DOC_DB_GAME_STORE_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -29,13 +31,20 @@ class DocDbGameStore final : public GameStoreInterface {
   Status RemoveUser(const string& user_id) override;
   StatusOr<std::unordered_set<string>> GetUsers() const override;
   StatusOr<GameStatePtr> NewGame(const GameStatePtr game_state) override;
+  StatusOr<std::vector<GameStatePtr>> NewGames(const std::vector<GameStatePtr>& game_states,
+                                               const string& batch_key) override;
   StatusOr<GameStatePtr> ReadGame(const string& game_id) const override;
   StatusOr<GameStatePtr> ReadGameByUserId(const string& user_id) const override;
+  StatusOr<GameStatePtr> ReadGameForUser(const string& game_id,
+                                         const string& user_id) const override;
   StatusOr<unordered_set<GameStatePtr>> ReadAllGames() const override;
   StatusOr<GameStatePtr> UpdateGame(const GameStatePtr game_state) override;
 
  private:
   std::shared_ptr<DocDbClient> client_;
+  std::mutex mutex_;
+  // The games a failed NewGames did store, by batch key.
+  std::unordered_map<string, std::vector<GameStatePtr>> partial_batches_;
 };
 }  // namespace golf
 
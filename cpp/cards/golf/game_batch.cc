@@ -0,0 +1,209 @@
+#include "cpp/cards/golf/game_batch.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "cpp/cards/golf/compact_game.h"
+
+namespace golf {
+
+GameBatch::GameBatch(size_t size)
+    : size_(size),
+      stride_((size + kChunk - 1) / kChunk * kChunk),
+      hands_(stride_ * kMaxPlayers * kHandSize),
+      draw_(size * kDeckSize),
+      discard_(size * kDeckSize),
+      draw_size_(size),
+      discard_size_(size),
+      discard_top_(size),
+      players_(stride_),
+      whose_turn_(size),
+      who_knocked_(size, -1),
+      peeked_(size) {}
+
+void GameBatch::set(size_t lane, const CompactGame& game) {
+  for (int seat = 0; seat < kMaxPlayers; seat++) {
+    for (int p = 0; p < kHandSize; p++) {
+      card(seat, p, lane) = seat < game.players ? game.hands[seat][p] : 0;
+    }
+  }
+  std::copy_n(game.draw.begin(), game.draw_size, drawPile(lane));
+  draw_size_[lane] = game.draw_size;
+  discard_size_[lane] = game.discard_size;
+  if (game.discard_size > 0) {
+    std::copy_n(game.discard.begin(), game.discard_size - 1, discardPile(lane));
+    discard_top_[lane] = game.discardTop();
+  }
+  players_[lane] = game.players;
+  whose_turn_[lane] = game.whose_turn;
+  who_knocked_[lane] = game.who_knocked;
+  peeked_[lane] = game.peeked;
+}
+
+CompactGame GameBatch::get(size_t lane) const {
+  CompactGame game{};
+  game.players = players_[lane];
+  for (int seat = 0; seat < game.players; seat++) {
+    for (int p = 0; p < kHandSize; p++) {
+      game.hands[seat][p] = card(seat, p, lane);
+    }
+  }
+  game.draw_size = draw_size_[lane];
+  std::copy_n(&draw_[lane * kDeckSize], game.draw_size, game.draw.begin());
+  game.discard_size = discard_size_[lane];
+  if (game.discard_size > 0) {
+    std::copy_n(&discard_[lane * kDeckSize], game.discard_size - 1, game.discard.begin());
+    game.discard[game.discard_size - 1] = discard_top_[lane];
+  }
+  game.whose_turn = whose_turn_[lane];
+  game.who_knocked = who_knocked_[lane];
+  game.peeked = peeked_[lane];
+  return game;
+}
+
+void GameBatch::pushDiscard(size_t lane, uint8_t c) {
+  if (discard_size_[lane] > 0) {
+    discardPile(lane)[discard_size_[lane] - 1] = discard_top_[lane];
+  }
+  discard_top_[lane] = c;
+  discard_size_[lane]++;
+}
+
+void GameBatch::apply(std::span<const Action> actions, std::span<uint8_t> ok) {
+  for (size_t lane = 0; lane < size_; lane++) {
+    const Action action = actions[lane];
+    const int seat = whose_turn_[lane];
+    const bool over = draw_size_[lane] == 0 || seat == who_knocked_[lane];
+    const bool peeked = peeked_[lane];
+    bool accepted = false;
+    switch (action.type) {
+      case ActionType::Peek:
+        if ((accepted = !over && !peeked)) {
+          peeked_[lane] = 1;
+        }
+        break;
+      case ActionType::SwapForDraw:
+        if ((accepted = !over)) {
+          uint8_t& slot = card(seat, action.position, lane);
+          pushDiscard(lane, slot);
+          slot = drawPile(lane)[--draw_size_[lane]];
+        }
+        break;
+      case ActionType::SwapDrawForDiscard:
+        if ((accepted = !over)) {
+          pushDiscard(lane, drawPile(lane)[--draw_size_[lane]]);
+        }
+        break;
+      case ActionType::SwapForDiscard:
+        if ((accepted = !over && !peeked && discard_size_[lane] != 0)) {
+          std::swap(card(seat, action.position, lane), discard_top_[lane]);
+        }
+        break;
+      case ActionType::Knock:
+        if ((accepted = !over && !peeked && who_knocked_[lane] == -1)) {
+          who_knocked_[lane] = static_cast<int8_t>(seat);
+        }
+        break;
+    }
+    ok[lane] = accepted;
+    // Every accepted move but a peek ends the turn.
+    if (accepted && action.type != ActionType::Peek) {
+      peeked_[lane] = 0;
+      whose_turn_[lane] = static_cast<uint8_t>(seat + 1 == players_[lane] ? 0 : seat + 1);
+    }
+  }
+}
+
+void GameBatch::isOver(std::span<uint8_t> out) const {
+  for (size_t lane = 0; lane < size_; lane++) {
+    out[lane] = draw_size_[lane] == 0 || whose_turn_[lane] == who_knocked_[lane];
+  }
+}
+
+void GameBatch::scores(std::span<uint8_t> out) const {
+  // Lanes past size_ are empty seats in every pass, so each pass is a whole chunk and every loop
+  // has a constant trip count, which is what lets -O2 vectorize them.
+  constexpr size_t n = kChunk;
+  uint8_t ranks[kHandSize][kChunk];
+  uint8_t count[kChunk];
+  uint8_t first[kChunk];
+  uint8_t score[kChunk];
+  for (size_t base = 0; base < size_; base += kChunk) {
+    for (int seat = 0; seat < kMaxPlayers; seat++) {
+      for (int p = 0; p < kHandSize; p++) {
+        const uint8_t* slot = &hands_[(seat * kHandSize + p) * stride_ + base];
+        for (size_t i = 0; i < n; i++) {
+          ranks[p][i] = slot[i] % 13;
+        }
+      }
+      // compactScore without its rank bitmask, whose variable shifts and table lookup do not
+      // vectorize: a card scores if it is the first of its rank in the hand and that rank is held
+      // an odd number of times. Every loop below is byte compares and adds across lanes.
+      std::fill_n(score, n, uint8_t{0});
+      for (int p = 0; p < kHandSize; p++) {
+        std::fill_n(count, n, uint8_t{1});
+        std::fill_n(first, n, uint8_t{1});
+        for (int q = 0; q < kHandSize; q++) {
+          if (q == p) {
+            continue;
+          }
+          for (size_t i = 0; i < n; i++) {
+            uint8_t same = ranks[q][i] == ranks[p][i];
+            count[i] += same;
+            first[i] &= q > p || !same;
+          }
+        }
+        for (size_t i = 0; i < n; i++) {
+          // kRankValues as arithmetic: Two..Ten are 2..10, Jack 0, Queen and King 10, Ace 1.
+          uint8_t r = ranks[p][i];
+          uint8_t value = (r < 9) * (r + 2) + (r == 10 || r == 11) * 10 + (r == 12);
+          score[i] += (first[i] & count[i]) * value;
+        }
+      }
+      uint8_t* row = &out[seat * size_ + base];
+      const size_t valid = std::min(kChunk, size_ - base);
+      for (size_t i = 0; i < valid; i++) {
+        row[i] = seat < players_[base + i] ? score[i] : 0;
+      }
+    }
+  }
+}
+
+void GameBatch::winners(std::span<uint32_t> out) const {
+  std::vector<uint8_t> all(size_ * kMaxPlayers);
+  scores(all);
+  uint8_t min_score[kChunk];
+  for (size_t base = 0; base < size_; base += kChunk) {
+    const size_t n = std::min(kChunk, size_ - base);
+    std::fill_n(min_score, n, uint8_t{40});  // max score is 9 10 Q K == 39
+    for (int seat = 0; seat < kMaxPlayers; seat++) {
+      const uint8_t* row = &all[seat * size_ + base];
+      for (size_t i = 0; i < n; i++) {
+        uint8_t s = seat < players_[base + i] ? row[i] : 40;
+        min_score[i] = std::min(min_score[i], s);
+      }
+    }
+    for (size_t i = 0; i < n; i++) {
+      out[base + i] = 0;
+    }
+    for (int seat = 0; seat < kMaxPlayers; seat++) {
+      const uint8_t* row = &all[seat * size_ + base];
+      for (size_t i = 0; i < n; i++) {
+        bool wins = seat < players_[base + i] && row[i] == min_score[i];
+        out[base + i] |= static_cast<uint32_t>(wins) << seat;
+      }
+    }
+    // The knocker wins ties.
+    for (size_t i = 0; i < n; i++) {
+      int knocker = who_knocked_[base + i];
+      if (knocker >= 0 && (out[base + i] >> knocker & 1) != 0) {
+        out[base + i] = 1u << knocker;
+      }
+    }
+  }
+}
+
+}  // namespace golf
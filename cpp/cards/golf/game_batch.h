@@ -0,0 +1,76 @@
+#ifndef CPP_CARDS_GOLF_GAME_BATCH_H
+#define CPP_CARDS_GOLF_GAME_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "cpp/cards/golf/compact_game.h"
+
+namespace golf {
+
+// Many CompactGames in struct-of-arrays form, for work that touches every game at once: self-play,
+// bot rollouts and rescoring archived games. Each hand slot, pile top, turn and knock index is a
+// byte lane across the batch, so scoring is a few straight-line passes over lanes that the
+// compiler vectorizes, and a batch transition reads each field as one contiguous array.
+//
+// Lane i behaves exactly like the CompactGame stored with set(i, ...): the same transitions are
+// accepted and rejected, and get(i) returns the game as it would have been played alone.
+class GameBatch {
+ public:
+  explicit GameBatch(size_t size);
+
+  size_t size() const { return size_; }
+  void set(size_t lane, const CompactGame& game);
+  CompactGame get(size_t lane) const;
+
+  int players(size_t lane) const { return players_[lane]; }
+  int whoseTurn(size_t lane) const { return whose_turn_[lane]; }
+  int whoKnocked(size_t lane) const { return who_knocked_[lane]; }
+
+  // Applies actions[lane] for the player whose turn it is in each lane. ok[lane] is 0 where the
+  // action was rejected and the lane left unchanged.
+  void apply(std::span<const Action> actions, std::span<uint8_t> ok);
+
+  // out[lane] is 1 where the game is over.
+  void isOver(std::span<uint8_t> out) const;
+  // out[seat * size() + lane] is the score of `seat`'s hand, for seats 0..kMaxPlayers-1; seats a
+  // lane does not use score 0.
+  void scores(std::span<uint8_t> out) const;
+  // out[lane] is CompactGame::winners() for each lane.
+  void winners(std::span<uint32_t> out) const;
+
+ private:
+  // Lanes per scoring pass, small enough for the pass's temporaries to stay in L1.
+  static constexpr size_t kChunk = 256;
+
+  uint8_t& card(int seat, int position, size_t lane) {
+    return hands_[(seat * kHandSize + position) * stride_ + lane];
+  }
+  uint8_t card(int seat, int position, size_t lane) const {
+    return hands_[(seat * kHandSize + position) * stride_ + lane];
+  }
+  // Runs of kDeckSize cards per lane. The discard run holds the cards under discard_top_.
+  uint8_t* drawPile(size_t lane) { return &draw_[lane * kDeckSize]; }
+  uint8_t* discardPile(size_t lane) { return &discard_[lane * kDeckSize]; }
+  void pushDiscard(size_t lane, uint8_t c);
+
+  size_t size_;
+  // size_ rounded up to whole chunks; the lanes past size_ have no players.
+  size_t stride_;
+  std::vector<uint8_t> hands_;
+  std::vector<uint8_t> draw_;
+  std::vector<uint8_t> discard_;
+  std::vector<uint8_t> draw_size_;
+  std::vector<uint8_t> discard_size_;
+  std::vector<uint8_t> discard_top_;
+  std::vector<uint8_t> players_;
+  std::vector<uint8_t> whose_turn_;
+  std::vector<int8_t> who_knocked_;
+  std::vector<uint8_t> peeked_;
+};
+
+}  // namespace golf
+
+#endif
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "cpp/cards/golf/compact_game.h"
+#include "cpp/cards/golf/game_batch.h"
+#include "cpp/cards/golf/strategy.h"
+
+using namespace golf;
+
+namespace {
+std::vector<CompactGame> DealGames(size_t n) {
+  SimRng rng(7);
+  std::vector<CompactGame> games;
+  games.reserve(n);
+  for (size_t i = 0; i < n; i++) {
+    games.push_back(CompactGame::deal(4, rng));
+  }
+  return games;
+}
+}  // namespace
+
+// Scoring one game at a time, the way Simulate does.
+static void BM_ScoreCompactGames(benchmark::State& state) {
+  auto games = DealGames(state.range(0));
+  std::vector<uint8_t> scores(games.size() * kMaxPlayers);
+  for (auto _ : state) {
+    for (size_t i = 0; i < games.size(); i++) {
+      for (int p = 0; p < games[i].players; p++) {
+        scores[p * games.size() + i] = static_cast<uint8_t>(games[i].score(p));
+      }
+    }
+    benchmark::DoNotOptimize(scores.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScoreCompactGames)->Range(1 << 10, 1 << 18);
+
+static void BM_ScoreGameBatch(benchmark::State& state) {
+  auto games = DealGames(state.range(0));
+  GameBatch batch(games.size());
+  for (size_t i = 0; i < games.size(); i++) {
+    batch.set(i, games[i]);
+  }
+  std::vector<uint8_t> scores(games.size() * kMaxPlayers);
+  for (auto _ : state) {
+    batch.scores(scores);
+    benchmark::DoNotOptimize(scores.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ScoreGameBatch)->Range(1 << 10, 1 << 18);
+
+static void BM_ApplyGameBatch(benchmark::State& state) {
+  auto games = DealGames(state.range(0));
+  GameBatch batch(games.size());
+  std::vector<Action> actions(games.size(), Action{ActionType::SwapForDiscard, 2});
+  std::vector<uint8_t> ok(games.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (size_t i = 0; i < games.size(); i++) {
+      batch.set(i, games[i]);
+    }
+    state.ResumeTiming();
+    batch.apply(actions, ok);
+    benchmark::DoNotOptimize(ok.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ApplyGameBatch)->Range(1 << 10, 1 << 18);
+
+BENCHMARK_MAIN();
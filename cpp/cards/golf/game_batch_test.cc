@@ -0,0 +1,84 @@
+#include "cpp/cards/golf/game_batch.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "cpp/cards/golf/compact_game.h"
+#include "cpp/cards/golf/strategy.h"
+
+using namespace golf;
+
+namespace {
+void ExpectSameGame(const CompactGame& expected, const CompactGame& actual) {
+  ASSERT_EQ(expected.players, actual.players);
+  for (int p = 0; p < expected.players; p++) {
+    EXPECT_EQ(expected.hands[p], actual.hands[p]);
+  }
+  ASSERT_EQ(expected.draw_size, actual.draw_size);
+  EXPECT_TRUE(std::equal(expected.draw.begin(), expected.draw.begin() + expected.draw_size,
+                         actual.draw.begin()));
+  ASSERT_EQ(expected.discard_size, actual.discard_size);
+  EXPECT_TRUE(std::equal(expected.discard.begin(),
+                         expected.discard.begin() + expected.discard_size,
+                         actual.discard.begin()));
+  EXPECT_EQ(expected.whose_turn, actual.whose_turn);
+  EXPECT_EQ(expected.who_knocked, actual.who_knocked);
+  EXPECT_EQ(expected.peeked, actual.peeked);
+}
+}  // namespace
+
+TEST(GameBatch, SetThenGet) {
+  SimRng rng(1);
+  GameBatch batch(3);
+  for (int players = 2; players <= 4; players++) {
+    auto game = CompactGame::deal(players, rng);
+    batch.set(players - 2, game);
+    ExpectSameGame(game, batch.get(players - 2));
+  }
+}
+
+TEST(GameBatch, MatchesCompactGame) {
+  // More lanes than one scoring chunk, with a mix of table sizes and some illegal moves.
+  constexpr size_t kLanes = 300;
+  SimRng rng(7);
+  RandomStrategy random;
+  std::vector<CompactGame> games;
+  GameBatch batch(kLanes);
+  for (size_t lane = 0; lane < kLanes; lane++) {
+    games.push_back(CompactGame::deal(2 + static_cast<int>(lane % 4), rng));
+    batch.set(lane, games.back());
+  }
+
+  std::vector<Action> actions(kLanes);
+  std::vector<uint8_t> ok(kLanes);
+  std::vector<uint8_t> over(kLanes);
+  std::vector<uint8_t> scores(kLanes * kMaxPlayers);
+  std::vector<uint32_t> winners(kLanes);
+  for (int step = 0; step < 200; step++) {
+    for (size_t lane = 0; lane < kLanes; lane++) {
+      actions[lane] = rng.below(8) == 0
+                          ? Action{static_cast<ActionType>(rng.below(5)),
+                                   static_cast<uint8_t>(rng.below(kHandSize))}
+                          : random.choose(games[lane], rng);
+    }
+    batch.apply(actions, ok);
+    batch.isOver(over);
+    batch.scores(scores);
+    batch.winners(winners);
+    for (size_t lane = 0; lane < kLanes; lane++) {
+      ASSERT_EQ(games[lane].apply(actions[lane]), ok[lane] != 0) << lane;
+      ASSERT_EQ(games[lane].isOver(), over[lane] != 0) << lane;
+      for (int p = 0; p < kMaxPlayers; p++) {
+        int expected = p < games[lane].players ? games[lane].score(p) : 0;
+        ASSERT_EQ(expected, scores[p * kLanes + lane]) << lane;
+      }
+      ASSERT_EQ(games[lane].winners(), winners[lane]) << lane;
+    }
+  }
+  for (size_t lane = 0; lane < kLanes; lane++) {
+    ExpectSameGame(games[lane], batch.get(lane));
+  }
+}
@@ -0,0 +1,63 @@
+#include "cpp/cards/golf/game_id.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "absl/strings/numbers.h"
+
+namespace golf {
+namespace {
+// 2024-01-01T00:00:00Z.
+constexpr auto kEpoch = std::chrono::milliseconds(1704067200000);
+
+constexpr char kDigits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+}  // namespace
+
+uint32_t GameIdGenerator::NodeIdFromEnvironment() {
+  const char* env_p = std::getenv("GOLF_NODE_ID");
+  if (!env_p) {
+    return 0;
+  }
+  uint32_t node_id;
+  if (!absl::SimpleAtoi(env_p, &node_id) || node_id > kMaxNodeId) {
+    // Any id picked in its place could be another worker's.
+    std::cerr << "GOLF_NODE_ID must be 0 to " << kMaxNodeId << ", not " << env_p << std::endl;
+    std::abort();
+  }
+  return node_id;
+}
+
+uint64_t GameIdGenerator::nextRaw() {
+  auto since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         now_().time_since_epoch() - kEpoch)
+                         .count();
+  uint64_t now = static_cast<uint64_t>(std::max<int64_t>(since_epoch, 0)) << kSequenceBits;
+  uint64_t last = last_.load(std::memory_order_relaxed);
+  uint64_t next;
+  do {
+    // Never behind the last id, even if the clock steps back.
+    next = std::max(now, last + 1);
+  } while (!last_.compare_exchange_weak(last, next, std::memory_order_relaxed));
+
+  uint64_t millis = next >> kSequenceBits;
+  uint64_t sequence = next & ((1u << kSequenceBits) - 1);
+  return (millis << (kNodeBits + kSequenceBits)) | (uint64_t{node_id_} << kSequenceBits) | sequence;
+}
+
+std::string GameIdGenerator::Encode(uint64_t id) {
+  std::string encoded(kEncodedSize, '0');
+  for (size_t i = kEncodedSize; i-- > 0 && id > 0; id /= 62) {
+    encoded[i] = kDigits[id % 62];
+  }
+  return encoded;
+}
+
+GameIdGenerator::Clock::time_point GameIdGenerator::CreatedAt(uint64_t id) {
+  return Clock::time_point{kEpoch + std::chrono::milliseconds(id >> (kNodeBits + kSequenceBits))};
+}
+
+}  // namespace golf
@@ -0,0 +1,62 @@
+#ifndef CPP_CARDS_GOLF_GAME_ID_H
+#define CPP_CARDS_GOLF_GAME_ID_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+namespace golf {
+
+// Game ids that are unique without locks or store lookups and that sort by creation time, so a
+// range of ids is a range of time. An id packs, from the top bit down:
+//
+//   41 bits  milliseconds since 2024-01-01 UTC (good until 2093)
+//   10 bits  node id, distinct for every process minting ids at once
+//   12 bits  sequence within the millisecond
+//
+// and is written as 11 base62 digits, most significant first, in an alphabet that is in ASCII
+// order, so ids compare as strings the way they do as numbers.
+//
+// A process that mints more than 4096 ids in a millisecond borrows the next millisecond rather
+// than wrapping, so ids stay unique and ordered. Across restarts, ids stay unique as long as the
+// clock has moved past the last id the previous run minted.
+//
+// Thread-safe.
+class GameIdGenerator {
+ public:
+  using Clock = std::chrono::system_clock;
+
+  static constexpr int kSequenceBits = 12;
+  static constexpr int kNodeBits = 10;
+  static constexpr uint32_t kMaxNodeId = (1u << kNodeBits) - 1;
+  static constexpr size_t kEncodedSize = 11;
+
+  // `node_id` is taken modulo kMaxNodeId + 1.
+  explicit GameIdGenerator(uint32_t node_id, std::function<Clock::time_point()> now = Clock::now)
+      : node_id_(node_id & kMaxNodeId), now_(std::move(now)) {}
+
+  // The GOLF_NODE_ID environment variable, or 0 if it is unset. Nothing else tells processes
+  // apart reliably, so each of several workers sharing a port through SO_REUSEPORT, or running on
+  // several hosts, must be given its own. Aborts if it is not a number from 0 to kMaxNodeId.
+  static uint32_t NodeIdFromEnvironment();
+
+  [[nodiscard]] uint64_t nextRaw();
+  [[nodiscard]] std::string next() { return Encode(nextRaw()); }
+
+  [[nodiscard]] static std::string Encode(uint64_t id);
+  // When `id` was minted.
+  [[nodiscard]] static Clock::time_point CreatedAt(uint64_t id);
+
+ private:
+  const uint32_t node_id_;
+  const std::function<Clock::time_point()> now_;
+  // The last (milliseconds << kSequenceBits | sequence) handed out.
+  std::atomic<uint64_t> last_{0};
+};
+
+}  // namespace golf
+
+#endif
@@ -0,0 +1,95 @@
+#include "cpp/cards/golf/game_id.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace golf;
+using namespace std::chrono_literals;
+
+namespace {
+// 2025-01-01T00:00:00Z.
+const GameIdGenerator::Clock::time_point kSomeTime{std::chrono::milliseconds(1735689600000)};
+}  // namespace
+
+TEST(GameIdGenerator, EncodesInOrder) {
+  EXPECT_EQ(GameIdGenerator::Encode(0), "00000000000");
+  EXPECT_EQ(GameIdGenerator::Encode(61), "0000000000z");
+  EXPECT_EQ(GameIdGenerator::Encode(62), "00000000010");
+  EXPECT_EQ(GameIdGenerator::Encode(UINT64_MAX).size(), GameIdGenerator::kEncodedSize);
+  EXPECT_LT(GameIdGenerator::Encode(9), GameIdGenerator::Encode(10));
+  EXPECT_LT(GameIdGenerator::Encode(35), GameIdGenerator::Encode(36));
+  EXPECT_LT(GameIdGenerator::Encode(UINT64_MAX - 1), GameIdGenerator::Encode(UINT64_MAX));
+}
+
+TEST(GameIdGenerator, OrdersByTimeThenNode) {
+  auto now = kSomeTime;
+  GameIdGenerator a{1, [&now] { return now; }};
+  GameIdGenerator b{2, [&now] { return now; }};
+
+  auto a1 = a.nextRaw();
+  auto b1 = b.nextRaw();
+  EXPECT_NE(a1, b1);
+  EXPECT_EQ(GameIdGenerator::CreatedAt(a1), kSomeTime);
+  now += 1ms;
+  auto a2 = a.nextRaw();
+  EXPECT_LT(b1, a2);
+  EXPECT_EQ(GameIdGenerator::CreatedAt(a2), kSomeTime + 1ms);
+  EXPECT_LT(GameIdGenerator::Encode(b1), GameIdGenerator::Encode(a2));
+}
+
+TEST(GameIdGenerator, NeverRepeatsWhenTheClockStallsOrStepsBack) {
+  auto now = kSomeTime;
+  GameIdGenerator ids{7, [&now] { return now; }};
+  std::vector<uint64_t> minted;
+  // More than one millisecond's worth of sequence numbers.
+  for (int i = 0; i < 5000; i++) {
+    minted.push_back(ids.nextRaw());
+  }
+  now -= 1s;
+  minted.push_back(ids.nextRaw());
+  EXPECT_TRUE(std::is_sorted(minted.begin(), minted.end()));
+  EXPECT_EQ(std::set<uint64_t>(minted.begin(), minted.end()).size(), minted.size());
+  EXPECT_EQ(GameIdGenerator::CreatedAt(minted[4999]), kSomeTime + 1ms);
+}
+
+TEST(GameIdGenerator, UniqueAcrossThreads) {
+  GameIdGenerator ids{GameIdGenerator::NodeIdFromEnvironment()};
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 10000;
+  std::vector<std::vector<std::string>> minted(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < kPerThread; i++) {
+        minted[t].push_back(ids.next());
+      }
+    });
+  }
+  std::set<std::string> all;
+  for (int t = 0; t < kThreads; t++) {
+    threads[t].join();
+    EXPECT_TRUE(std::is_sorted(minted[t].begin(), minted[t].end()));
+    all.insert(minted[t].begin(), minted[t].end());
+  }
+  EXPECT_EQ(all.size(), kThreads * kPerThread);
+}
+
+TEST(GameIdGenerator, NodeIdFromEnvironment) {
+  unsetenv("GOLF_NODE_ID");
+  EXPECT_EQ(GameIdGenerator::NodeIdFromEnvironment(), 0u);
+  setenv("GOLF_NODE_ID", "1023", 1);
+  EXPECT_EQ(GameIdGenerator::NodeIdFromEnvironment(), 1023u);
+  // Wrapping or guessing an id could collide with another worker's.
+  setenv("GOLF_NODE_ID", "1024", 1);
+  EXPECT_DEATH(GameIdGenerator::NodeIdFromEnvironment(), "GOLF_NODE_ID");
+  setenv("GOLF_NODE_ID", "worker-1", 1);
+  EXPECT_DEATH(GameIdGenerator::NodeIdFromEnvironment(), "GOLF_NODE_ID");
+  unsetenv("GOLF_NODE_ID");
+}
@@ -5,10 +5,13 @@
 #include <unordered_set>
 #include <vector>
 
+#include "absl/log/log.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "cpp/cards/card.h"
 #include "cpp/cards/golf/game_state.h"
 #include "cpp/cards/golf/player.h"
+#include "cpp/cards/shoe.h"
 
 namespace golf {
 using namespace cards;
@@ -48,25 +51,14 @@ StatusOr<string> GameManager::registerUser(const string& user_id) {
   return save_status;
 }
 
-deque<Card> GameManager::shuffleNewDeck() {
-  vector<int> cards{};
-  cards.reserve(52);
-  for (int i = 0; i < 52; i++) {
-    cards.push_back(i);
-  }
-
-  std::random_device rd;
-  std::mt19937 g(rd());
-  std::shuffle(cards.begin(), cards.end(), g);
-
-  deque<Card> deck{};
-  for (auto c : cards) {
-    deck.emplace_back(c);
-  }
-  return deck;
+Status GameManager::unregisterUser(const string& user_id) {
+  return game_store_->RemoveUser(user_id);
 }
 
-// TODO: support multiple decks for many players?
+static const string kPlayerCountError =
+    absl::StrCat("2 to ", GameManager::kMaxPlayers, " players, dealt from up to ",
+                 GameManager::kMaxDecks, " decks");
+
 StatusOr<GameStatePtr> GameManager::newGame(const string& user_id, int number_of_players) {
   auto user_exists_status = game_store_->UserExists(user_id);
   if (!user_exists_status.ok()) {
@@ -76,16 +68,22 @@ StatusOr<GameStatePtr> GameManager::newGame(const string& user_id, int number_of
     return InvalidArgumentError("unknown user");
   }
 
-  if (number_of_players < 2 || number_of_players > 5) {
-    return InvalidArgumentError("2 to 5 players");
+  if (number_of_players < 2 || number_of_players > kMaxPlayers) {
+    return InvalidArgumentError(kPlayerCountError);
   }
 
-  deque<Card> mutableDrawPile = shuffleNewDeck();
+  auto game_state = std::make_shared<GameState>(dealHand({user_id}, number_of_players));
+  return game_store_->NewGame(game_state);
+}
+
+GameState GameManager::dealHand(const vector<string>& user_ids, int number_of_players) {
+  Shoe shoe{(number_of_players + kPlayersPerDeck - 1) / kPlayersPerDeck};
+  shoe.shuffle(rng_);
 
   vector<Card> allDealt{};
-  for (int i = 0; i < number_of_players * 4; i++) {
-    allDealt.push_back(mutableDrawPile.back());
-    mutableDrawPile.pop_back();
+  allDealt.reserve(number_of_players * Player::kHandSize);
+  for (int i = 0; i < number_of_players * Player::kHandSize; i++) {
+    allDealt.push_back(shoe.deal());
   }
 
   vector<Player> mutablePlayers;
@@ -97,8 +95,8 @@ StatusOr<GameStatePtr> GameManager::newGame(const string& user_id, int number_of
     auto& tr = allDealt.at(2 * i + 1);
     auto& bl = allDealt.at(2 * i + halfway);
     auto& br = allDealt.at(2 * i + halfway + 1);
-    if (i == 0) {
-      mutablePlayers.emplace_back(user_id, tl, tr, bl, br);
+    if (i < static_cast<int>(user_ids.size())) {
+      mutablePlayers.emplace_back(user_ids[i], tl, tr, bl, br);
     } else {
       mutablePlayers.emplace_back(tl, tr, bl, br);
     }
@@ -106,15 +104,200 @@ StatusOr<GameStatePtr> GameManager::newGame(const string& user_id, int number_of
 
   const vector<Player> players = std::move(mutablePlayers);
 
-  deque<Card> mutableDiscardPile{mutableDrawPile.back()};
-  mutableDrawPile.pop_back();
+  const deque<Card> discardPile{shoe.deal()};
+  const deque<Card> drawPile = shoe.remaining();
 
-  const deque<Card> drawPile = std::move(mutableDrawPile);
-  const deque<Card> discardPile = std::move(mutableDiscardPile);
+  return GameState{drawPile, discardPile, players, false, 0, -1};
+}
 
-  auto game_state =
-      std::make_shared<GameState>(GameState{drawPile, discardPile, players, false, 0, -1});
-  return game_store_->NewGame(game_state);
+StatusOr<MatchPtr> GameManager::newMatch(const string& user_id, int number_of_players,
+                                         int holes) {
+  if (holes < 1) {
+    return InvalidArgumentError("at least one hole");
+  }
+  auto first_hand = newGame(user_id, number_of_players);
+  if (!first_hand.ok()) {
+    return first_hand.status();
+  }
+  auto& game_id = (*first_hand)->getGameId();
+  auto match = std::make_shared<const Match>(game_id, holes);
+  matches_by_id_[game_id] = match;
+  match_id_by_game_id_[game_id] = game_id;
+  return match;
+}
+
+StatusOr<MatchPtr> GameManager::getMatch(const string& match_id) const {
+  auto it = matches_by_id_.find(match_id);
+  if (it == matches_by_id_.end()) {
+    return InvalidArgumentError("unknown match id");
+  }
+  return it->second;
+}
+
+Status GameManager::advanceMatch(const GameState& hand) {
+  auto match_id = match_id_by_game_id_.find(hand.getGameId());
+  if (match_id == match_id_by_game_id_.end()) {
+    return absl::OkStatus();
+  }
+  auto match = std::make_shared<Match>(*matches_by_id_.at(match_id->second));
+  auto status = match->recordHand(hand, leaderboard_);
+  if (!status.ok()) {
+    return status;
+  }
+  match_id_by_game_id_.erase(match_id);
+  matches_by_id_[match->getMatchId()] = match;
+  if (match->isOver()) {
+    return absl::OkStatus();
+  }
+  auto deal_status = dealNextHand(*match);
+  if (!deal_status.ok()) {
+    matches_awaiting_hand_.insert(match->getMatchId());
+  }
+  return deal_status;
+}
+
+Status GameManager::dealNextHand(Match& match) {
+  auto seating = match.nextSeating();
+  auto next = std::make_shared<GameState>(dealHand(seating, static_cast<int>(seating.size())));
+  auto new_game_status = game_store_->NewGame(next);
+  if (!new_game_status.ok()) {
+    return new_game_status.status();
+  }
+  auto& next_game_id = (*new_game_status)->getGameId();
+  match.nextHand(next_game_id);
+  match_id_by_game_id_[next_game_id] = match.getMatchId();
+  return absl::OkStatus();
+}
+
+StatusOr<TournamentPtr> GameManager::newTournament(const vector<string>& user_ids,
+                                                   int table_size) {
+  if (table_size < 2 || table_size > kMaxPlayers) {
+    return InvalidArgumentError(kPlayerCountError);
+  }
+  if (user_ids.size() < 2) {
+    return InvalidArgumentError("at least two entrants");
+  }
+  auto registered = game_store_->GetUsers();
+  if (!registered.ok()) {
+    return registered.status();
+  }
+  std::unordered_set<string> entered;
+  entered.reserve(user_ids.size());
+  for (auto& user_id : user_ids) {
+    if (!registered->contains(user_id)) {
+      return InvalidArgumentError("unknown user");
+    }
+    if (!entered.insert(user_id).second) {
+      return InvalidArgumentError("entrant listed twice");
+    }
+  }
+
+  // No tournament yet to key the first round on; a failure here goes back to the caller.
+  auto game_ids = dealRound(user_ids, table_size, "");
+  if (!game_ids.ok()) {
+    return game_ids.status();
+  }
+  auto tournament = std::make_shared<Tournament>(*std::move(game_ids), table_size);
+  for (auto& game_id : tournament->getGameIds()) {
+    tournament_id_by_game_id_[game_id] = tournament->getTournamentId();
+  }
+  tournaments_by_id_[tournament->getTournamentId()] = tournament;
+  return tournament;
+}
+
+StatusOr<TournamentPtr> GameManager::getTournament(const string& tournament_id) const {
+  auto it = tournaments_by_id_.find(tournament_id);
+  if (it == tournaments_by_id_.end()) {
+    return InvalidArgumentError("unknown tournament id");
+  }
+  return it->second;
+}
+
+StatusOr<vector<string>> GameManager::dealRound(const vector<string>& entrants, int table_size,
+                                                const string& round_key) {
+  auto seating = Tournament::seatTables(entrants, table_size);
+  vector<GameStatePtr> tables;
+  tables.reserve(seating.size());
+  for (auto& seats : seating) {
+    tables.push_back(std::make_shared<GameState>(dealHand(seats, static_cast<int>(seats.size()))));
+  }
+  auto stored = game_store_->NewGames(tables, round_key);
+  if (!stored.ok()) {
+    return stored.status();
+  }
+  vector<string> game_ids;
+  game_ids.reserve(stored->size());
+  for (auto& table : *stored) {
+    game_ids.push_back(table->getGameId());
+  }
+  return game_ids;
+}
+
+Status GameManager::advanceTournament(const GameState& table) {
+  auto tournament_id = tournament_id_by_game_id_.find(table.getGameId());
+  if (tournament_id == tournament_id_by_game_id_.end()) {
+    return absl::OkStatus();
+  }
+  auto& tournament = tournaments_by_id_.at(tournament_id->second);
+  tournament_id_by_game_id_.erase(tournament_id);
+  if (tournament.use_count() > 1) {
+    tournament = std::make_shared<Tournament>(*tournament);
+  }
+  auto status = tournament->recordTable(table);
+  if (!status.ok()) {
+    return status;
+  }
+  if (!tournament->isRoundOver() || tournament->isOver()) {
+    return absl::OkStatus();
+  }
+  auto deal_status = dealNextRound(*tournament);
+  if (!deal_status.ok()) {
+    tournaments_awaiting_round_.insert(tournament->getTournamentId());
+  }
+  return deal_status;
+}
+
+Status GameManager::dealNextRound(Tournament& tournament) {
+  auto game_ids =
+      dealRound(tournament.nextEntrants(), tournament.getTableSize(),
+                absl::StrCat(tournament.getTournamentId(), "/", tournament.getRound() + 1));
+  if (!game_ids.ok()) {
+    return game_ids.status();
+  }
+  for (auto& game_id : *game_ids) {
+    tournament_id_by_game_id_[game_id] = tournament.getTournamentId();
+  }
+  tournament.nextRound(*std::move(game_ids));
+  return absl::OkStatus();
+}
+
+Status GameManager::dealPending() {
+  Status first_failure;
+  for (auto it = matches_awaiting_hand_.begin(); it != matches_awaiting_hand_.end();) {
+    auto match = std::make_shared<Match>(*matches_by_id_.at(*it));
+    auto status = dealNextHand(*match);
+    if (!status.ok()) {
+      first_failure.Update(status);
+      ++it;
+      continue;
+    }
+    matches_by_id_[*it] = match;
+    it = matches_awaiting_hand_.erase(it);
+  }
+  for (auto it = tournaments_awaiting_round_.begin(); it != tournaments_awaiting_round_.end();) {
+    auto& tournament = tournaments_by_id_.at(*it);
+    if (tournament.use_count() > 1) {
+      tournament = std::make_shared<Tournament>(*tournament);
+    }
+    auto status = dealNextRound(*tournament);
+    if (!status.ok()) {
+      first_failure.Update(status);
+      ++it;
+      continue;
+    }
+    it = tournaments_awaiting_round_.erase(it);
+  }
+  return first_failure;
 }
 
 StatusOr<GameStatePtr> GameManager::joinGame(const string& game_id, const string& user_id) {
@@ -156,16 +339,8 @@ StatusOr<GameStatePtr> GameManager::joinGame(const string& game_id, const string
 
 StatusOr<GameStatePtr> GameManager::getGameStateForUser(const string& game_id,
                                                         const string& user_id) const {
-  auto user_exists_status = game_store_->UserExists(user_id);
-  if (!user_exists_status.ok()) {
-    return absl::InternalError("internal error");
-  }
-  if (!*user_exists_status) {
-    return InvalidArgumentError("unknown user");
-  }
-
-  // TODO: validate user is in this game
-  return game_store_->ReadGame(game_id);
+  // A seat in the game is proof enough that the user registered, so one read answers both.
+  return game_store_->ReadGameForUser(game_id, user_id);
 }
 
 StatusOr<GameStatePtr> GameManager::updateGameState(StatusOr<GameState> updateResult,
@@ -175,7 +350,27 @@ StatusOr<GameStatePtr> GameManager::updateGameState(StatusOr<GameState> updateRe
   }
 
   auto game_state = std::make_shared<GameState>(*updateResult);
-  return game_store_->UpdateGame(game_state);
+  auto update_status = game_store_->UpdateGame(game_state);
+  if (update_status.ok() && (*update_status)->isOver()) {
+    // The move is committed whatever happens next, so its caller gets the stored state and a deal
+    // that fails here is left pending. This game ending may be what lets an earlier failed deal
+    // through, e.g. by freeing a player who had sat down here, so those are retried first.
+    auto pending_status = dealPending();
+    if (!pending_status.ok()) {
+      LOG(WARNING) << "pending deals still failing: " << pending_status;
+    }
+    auto match_status = advanceMatch(**update_status);
+    if (!match_status.ok()) {
+      LOG(WARNING) << "next hand of the match with hand " << gameId
+                   << " not dealt: " << match_status;
+    }
+    auto tournament_status = advanceTournament(**update_status);
+    if (!tournament_status.ok()) {
+      LOG(WARNING) << "next round of the tournament with table " << gameId
+                   << " not dealt: " << tournament_status;
+    }
+  }
+  return update_status;
 }
 
 StatusOr<GameStatePtr> GameManager::peekAtDrawPile(const string& game_id, const string& user_id) {
@@ -241,6 +436,59 @@ StatusOr<GameStatePtr> GameManager::knock(const string& game_id, const string& u
   return updateGameState(game->knock(playerIndex), game->getGameId());
 }
 
+static StatusOr<GameState> applyAction(const GameState& game, int player, Action action) {
+  if (action.position > static_cast<uint8_t>(Position::BottomRight)) {
+    return InvalidArgumentError("no such position");
+  }
+  auto position = static_cast<Position>(action.position);
+  switch (action.type) {
+    case ActionType::Peek:
+      return game.peekAtDrawPile(player);
+    case ActionType::SwapForDraw:
+      return game.swapForDrawPile(player, position);
+    case ActionType::SwapDrawForDiscard:
+      return game.swapDrawForDiscardPile(player);
+    case ActionType::SwapForDiscard:
+      return game.swapForDiscardPile(player, position);
+    case ActionType::Knock:
+      return game.knock(player);
+  }
+  return InvalidArgumentError("unknown action");
+}
+
+BatchResult GameManager::applyBatch(const string& game_id, const string& user_id,
+                                    std::span<const Action> actions) {
+  BatchResult result{{}, InvalidArgumentError("no actions")};
+  if (actions.empty()) {
+    return result;
+  }
+  result.steps.reserve(actions.size());
+  auto game_res = getGameStateForUser(game_id, user_id);
+  if (!game_res.ok()) {
+    result.committed = game_res.status();
+    result.steps.resize(actions.size(), absl::AbortedError("game not read"));
+    return result;
+  }
+
+  GameStatePtr game = *game_res;
+  int player_index = game->playerIndex(user_id);
+  for (size_t i = 0; i < actions.size(); i++) {
+    auto next = applyAction(*game, player_index, actions[i]);
+    if (!next.ok()) {
+      result.committed =
+          Status(next.status().code(), absl::StrCat("action ", i, ": ", next.status().message()));
+      result.steps.push_back(result.committed.status());
+      result.steps.resize(actions.size(), absl::AbortedError("an earlier action was illegal"));
+      return result;
+    }
+    game = std::make_shared<const GameState>(*std::move(next));
+    result.steps.push_back(game);
+  }
+
+  result.committed = updateGameState(*game, game_id);
+  return result;
+}
+
 std::unordered_set<string> GameManager::getUsersOnline() const {
   auto read_users_status = game_store_->GetUsers();
   if (!read_users_status.ok()) {
@@ -4,15 +4,22 @@
 #include <deque>
 #include <memory>
 #include <random>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "cpp/cards/card.h"
+#include "cpp/cards/golf/compact_game.h"
 #include "cpp/cards/golf/game_state.h"
 #include "cpp/cards/golf/game_store.h"
+#include "cpp/cards/golf/leaderboard.h"
+#include "cpp/cards/golf/match.h"
 #include "cpp/cards/golf/player.h"
+#include "cpp/cards/golf/tournament.h"
+#include "cpp/cards/shoe.h"
 
 namespace golf {
 
@@ -21,13 +28,31 @@ using absl::Status;
 using absl::StatusOr;
 using std::string;
 
+struct BatchResult {
+  // One entry per action: the state it led to, or why it was illegal, with the action's index in
+  // the message. Actions after an illegal one are not tried and report AbortedError.
+  std::vector<StatusOr<GameStatePtr>> steps;
+  // The stored state after the last action, or why nothing was stored.
+  StatusOr<GameStatePtr> committed;
+};
+
 // Not thread-safe. requires external synchronization
 class GameManager {
  public:
+  static constexpr int kMaxPlayers = 12;
+  // newGame deals from one deck per this many players, so every table keeps a long draw pile.
+  static constexpr int kPlayersPerDeck = Player::Rules::kMaxPlayers / Player::Rules::kDecks;
+  // The most decks a table is dealt from, which a Shoe must be able to hold.
+  static constexpr int kMaxDecks = (kMaxPlayers + kPlayersPerDeck - 1) / kPlayersPerDeck;
+  static_assert(kMaxDecks <= cards::Shoe::kMaxDecks);
+
   explicit GameManager(std::shared_ptr<GameStoreInterface> game_store)
       : game_store_(std::move(game_store)) {}
+  // Deals from a generator seeded with `seed`, so that the same commands deal the same cards.
+  GameManager(std::shared_ptr<GameStoreInterface> game_store, std::mt19937::result_type seed)
+      : game_store_(std::move(game_store)), rng_(seed) {}
   [[nodiscard]] StatusOr<string> registerUser(const string& user_id);
-  void unregisterUser(const string& name);
+  [[nodiscard]] Status unregisterUser(const string& user_id);
   [[nodiscard]] StatusOr<GameStatePtr> newGame(const string& user_id, int players);
   [[nodiscard]] StatusOr<GameStatePtr> joinGame(const string& game_id, const string& name);
   [[nodiscard]] StatusOr<GameStatePtr> leaveGame(const string& game_id, const string& user_id);
@@ -39,23 +64,79 @@ class GameManager {
   [[nodiscard]] StatusOr<GameStatePtr> swapForDiscardPile(const string& game_id,
                                                           const string& user_id, Position position);
   [[nodiscard]] StatusOr<GameStatePtr> knock(const string& game_id, const string& user_id);
+  // Plays `actions` in order as `user_id`, e.g. a peek and then a swap, with one read and one
+  // write for the lot. The intermediate states are never stored; if any action is illegal nothing
+  // is, and the game stays as it was.
+  [[nodiscard]] BatchResult applyBatch(const string& game_id, const string& user_id,
+                                       std::span<const Action> actions);
+
+  // Starts a match of `holes` hands. Its first hand is a new game that others join as usual; when
+  // a hand ends the next is dealt with the same players seated, and the match id stays the first
+  // hand's game id.
+  [[nodiscard]] StatusOr<MatchPtr> newMatch(const string& user_id, int players,
+                                            int holes = Match::kDefaultHoles);
+  [[nodiscard]] StatusOr<MatchPtr> getMatch(const string& match_id) const;
+  // Starts a knockout tournament between `user_ids`, who must be registered and not in an
+  // unfinished game, at tables of up to `table_size` seated by Tournament::seatTables. A round's
+  // tables are all dealt at once and stored in one write, the first round now and each later one
+  // as soon as the last table of the round before ends, or by dealPending if that deal fails. The
+  // tournament id is the first table's game id.
+  [[nodiscard]] StatusOr<TournamentPtr> newTournament(const std::vector<string>& user_ids,
+                                                      int table_size);
+  [[nodiscard]] StatusOr<TournamentPtr> getTournament(const string& tournament_id) const;
+  // Deals the next hand of every match, and the next round of every tournament, whose deal failed
+  // when the game before it ended, e.g. on a store error or because a player had since sat down
+  // in another game. Runs by itself whenever a game ends; returns the first failure, and whatever
+  // failed stays pending for the next try.
+  [[nodiscard]] Status dealPending();
+  // Hands won in matches, by every user who has finished one, most first.
+  [[nodiscard]] const Leaderboard& getLeaderboard() const { return leaderboard_; }
 
   // do these methods belong here?
   [[nodiscard]] std::unordered_set<string> getUsersOnline() const;
   [[nodiscard]] std::unordered_map<string, string> getGameIdsByUserId() const;
   [[nodiscard]] std::unordered_set<GameStatePtr> getGames() const;
   [[nodiscard]] std::unordered_set<string> getUsersByGameId(const string& game_id) const;
-
- private:
+  // `game_id` if `user_id` is seated in it. Each move is this one read and then one write, which
+  // the store rejects if the game has changed since.
   [[nodiscard]] StatusOr<GameStatePtr> getGameStateForUser(const string& game_id,
                                                            const string& user_id) const;
+
+ private:
   [[nodiscard]] StatusOr<GameStatePtr> updateGameState(StatusOr<GameState> update_result,
                                                        const string& game_id);
-  [[nodiscard]] std::mt19937 randomGenerator() const;
-  [[nodiscard]] string generateRandomAlphanumericString(std::size_t len) const;
-  [[nodiscard]] std::optional<string> generateUnusedRandomId() const;
-  [[nodiscard]] static std::deque<Card> shuffleNewDeck();
+  // A shuffled deal with `user_ids` in the first seats and the rest open.
+  [[nodiscard]] GameState dealHand(const std::vector<string>& user_ids, int players);
+  // Records `hand`, which has just ended, in its match if it has one, and deals the next hand.
+  // If the deal fails the hand stays recorded and the match waits in matches_awaiting_hand_.
+  [[nodiscard]] Status advanceMatch(const GameState& hand);
+  // Deals and stores the next hand of `match`, which has recorded its current hand and is not over.
+  [[nodiscard]] Status dealNextHand(Match& match);
+  // Deals and stores a table for each group of Tournament::seatTables(entrants, table_size).
+  // Retrying a failed deal with the same non-empty `round_key` reuses the tables it did store.
+  [[nodiscard]] StatusOr<std::vector<string>> dealRound(const std::vector<string>& entrants,
+                                                        int table_size, const string& round_key);
+  // Records `table`, which has just ended, in its tournament if it has one, and deals the next
+  // round once it was the last table of its round. If that deal fails the round stays over and the
+  // tournament waits in tournaments_awaiting_round_.
+  [[nodiscard]] Status advanceTournament(const GameState& table);
+  // Deals and stores the next round of `tournament`, whose round is over and which is not.
+  [[nodiscard]] Status dealNextRound(Tournament& tournament);
   std::shared_ptr<GameStoreInterface> game_store_;
+  // Replaced, not modified, as hands end, so a MatchPtr handed out stays as it was.
+  std::unordered_map<string, MatchPtr> matches_by_id_;
+  std::unordered_map<string, string> match_id_by_game_id_;
+  Leaderboard leaderboard_{Leaderboard::Order::HighestFirst};
+  // Changed in place unless a TournamentPtr handed out still shares it, which is copied first and
+  // so stays as it was. A round of N tables then costs O(N) to record, not O(N^2).
+  std::unordered_map<string, std::shared_ptr<Tournament>> tournaments_by_id_;
+  // Only tables still being played.
+  std::unordered_map<string, string> tournament_id_by_game_id_;
+  // Ids of matches and tournaments whose next deal failed and is retried by dealPending.
+  std::unordered_set<string> matches_awaiting_hand_;
+  std::unordered_set<string> tournaments_awaiting_round_;
+  // Seeded once: a burst of deals should not each wait on std::random_device.
+  std::mt19937 rng_{std::random_device{}()};
 };
 
 }  // namespace golf
@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "cpp/cards/golf/game_store.h"
@@ -85,11 +89,38 @@ TEST(GameManager, NewGameWithWrongPlayerCount) {
 
   auto res2 = gm.newGame("user1", 0);
   EXPECT_FALSE(res2.ok());
-  EXPECT_EQ(res2.status().message(), "2 to 5 players");
+  EXPECT_EQ(res2.status().message(), "2 to 12 players, dealt from up to 3 decks");
 
-  auto res3 = gm.newGame("user1", 6);
+  auto res3 = gm.newGame("user1", 13);
   EXPECT_FALSE(res3.ok());
-  EXPECT_EQ(res3.status().message(), "2 to 5 players");
+  EXPECT_EQ(res3.status().message(), "2 to 12 players, dealt from up to 3 decks");
+}
+
+TEST(GameManager, NewGameDealsFromOneDeckPerFivePlayers) {
+  auto store = std::make_shared<InMemoryGameStore>();
+  GameManager gm{store};
+  EXPECT_TRUE(gm.registerUser("user1").ok());
+
+  auto res = gm.newGame("user1", 12);
+  ASSERT_TRUE(res.ok());
+  auto gameState = res->get();
+  EXPECT_EQ(gameState->getPlayers().size(), 12);
+  EXPECT_EQ(gameState->getDrawPile().size(), 107);  // three decks, 48 cards dealt, 1 in discard
+
+  std::map<std::pair<Suit, Rank>, int> copies;
+  auto count = [&](const Card& card) { copies[{card.getSuit(), card.getRank()}]++; };
+  std::for_each(gameState->getDrawPile().begin(), gameState->getDrawPile().end(), count);
+  std::for_each(gameState->getDiscardPile().begin(), gameState->getDiscardPile().end(), count);
+  for (auto& player : gameState->getPlayers()) {
+    for (auto position :
+         {Position::TopLeft, Position::TopRight, Position::BottomLeft, Position::BottomRight}) {
+      count(player.cardAt(position));
+    }
+  }
+  EXPECT_EQ(copies.size(), 52);
+  for (auto& [card, n] : copies) {
+    EXPECT_EQ(n, 3);
+  }
 }
 
 TEST(GameManager, NewGameWithUnknownUser) {
@@ -147,3 +178,337 @@ TEST(GameManager, Knock) {
   auto after_knock = good_knock_status.value();
   EXPECT_EQ(after_knock->getWhoKnocked(), 0);
 }
+
+namespace {
+// Counts the game reads and writes that reach the store.
+class CountingStore final : public GameStoreInterface {
+ public:
+  Status AddUser(const string& user_id) override { return store.AddUser(user_id); }
+  StatusOr<bool> UserExists(const string& user_id) const override {
+    reads++;
+    return store.UserExists(user_id);
+  }
+  Status RemoveUser(const string& user_id) override { return store.RemoveUser(user_id); }
+  StatusOr<std::unordered_set<string>> GetUsers() const override { return store.GetUsers(); }
+  StatusOr<GameStatePtr> NewGame(const GameStatePtr game_state) override {
+    writes++;
+    if (fail_new_games) {
+      return absl::UnavailableError("store unavailable");
+    }
+    return store.NewGame(game_state);
+  }
+  StatusOr<std::vector<GameStatePtr>> NewGames(const std::vector<GameStatePtr>& game_states,
+                                               const string& batch_key) override {
+    writes++;
+    batch_keys.push_back(batch_key);
+    if (fail_new_games) {
+      return absl::UnavailableError("store unavailable");
+    }
+    return store.NewGames(game_states, batch_key);
+  }
+  StatusOr<GameStatePtr> ReadGame(const string& game_id) const override {
+    reads++;
+    return store.ReadGame(game_id);
+  }
+  StatusOr<GameStatePtr> ReadGameByUserId(const string& user_id) const override {
+    reads++;
+    return store.ReadGameByUserId(user_id);
+  }
+  StatusOr<GameStatePtr> ReadGameForUser(const string& game_id,
+                                         const string& user_id) const override {
+    reads++;
+    return store.ReadGameForUser(game_id, user_id);
+  }
+  StatusOr<std::unordered_set<GameStatePtr>> ReadAllGames() const override {
+    return store.ReadAllGames();
+  }
+  StatusOr<GameStatePtr> UpdateGame(const GameStatePtr game_state) override {
+    writes++;
+    return store.UpdateGame(game_state);
+  }
+
+  InMemoryGameStore store;
+  mutable int reads = 0;
+  int writes = 0;
+  std::vector<string> batch_keys;
+  bool fail_new_games = false;
+};
+}  // namespace
+
+TEST(GameManager, MoveIsOneReadAndOneWrite) {
+  auto store = std::make_shared<CountingStore>();
+  GameManager gm{store};
+  EXPECT_TRUE(gm.registerUser("user1").ok());
+  EXPECT_TRUE(gm.registerUser("user2").ok());
+  EXPECT_TRUE(gm.registerUser("user3").ok());
+  auto game = gm.newGame("user1", 2);
+  ASSERT_TRUE(game.ok());
+  auto game_id = (*game)->getGameId();
+  ASSERT_TRUE(gm.joinGame(game_id, "user2").ok());
+
+  store->reads = 0;
+  store->writes = 0;
+  auto moved = gm.knock(game_id, "user1");
+  ASSERT_TRUE(moved.ok());
+  EXPECT_EQ(store->reads, 1);
+  EXPECT_EQ(store->writes, 1);
+  // The result carries everyone to tell.
+  EXPECT_EQ((*moved)->getPlayer(1).getName(), "user2");
+
+  // Registered but not seated: turned away by that same read.
+  auto outsider = gm.swapDrawForDiscardPile(game_id, "user3");
+  EXPECT_EQ(outsider.status().message(), "not in this game");
+  EXPECT_EQ(store->reads, 2);
+  EXPECT_EQ(store->writes, 1);
+}
+
+TEST(GameManager, BatchIsOneReadAndOneWrite) {
+  auto store = std::make_shared<CountingStore>();
+  GameManager gm{store};
+  EXPECT_TRUE(gm.registerUser("user1").ok());
+  EXPECT_TRUE(gm.registerUser("user2").ok());
+  auto game = gm.newGame("user1", 2);
+  ASSERT_TRUE(game.ok());
+  auto game_id = (*game)->getGameId();
+  ASSERT_TRUE(gm.joinGame(game_id, "user2").ok());
+
+  store->reads = 0;
+  store->writes = 0;
+  const Action turn[] = {{ActionType::Peek}, {ActionType::SwapForDraw, 2}};
+  auto batch = gm.applyBatch(game_id, "user1", turn);
+  ASSERT_TRUE(batch.committed.ok()) << batch.committed.status();
+  ASSERT_EQ(batch.steps.size(), 2);
+  EXPECT_TRUE(batch.steps[0].ok());
+  EXPECT_TRUE((*batch.steps[0])->getPeekedAtDrawPile());
+  EXPECT_EQ((*batch.committed)->getWhoseTurn(), 1);
+  EXPECT_EQ(store->reads, 1);
+  EXPECT_EQ(store->writes, 1);
+}
+
+TEST(GameManager, IllegalActionRollsBackBatch) {
+  auto store = std::make_shared<CountingStore>();
+  GameManager gm{store};
+  EXPECT_TRUE(gm.registerUser("user1").ok());
+  EXPECT_TRUE(gm.registerUser("user2").ok());
+  auto game = gm.newGame("user1", 2);
+  ASSERT_TRUE(game.ok());
+  auto game_id = (*game)->getGameId();
+  auto joined = gm.joinGame(game_id, "user2");
+  ASSERT_TRUE(joined.ok());
+
+  store->writes = 0;
+  // The swap ends user1's turn, so the knock is out of turn.
+  const Action moves[] = {
+      {ActionType::SwapForDiscard, 0}, {ActionType::Knock}, {ActionType::Peek}};
+  auto batch = gm.applyBatch(game_id, "user1", moves);
+  EXPECT_FALSE(batch.committed.ok());
+  ASSERT_EQ(batch.steps.size(), 3);
+  EXPECT_TRUE(batch.steps[0].ok());
+  EXPECT_EQ(batch.steps[1].status().code(), absl::StatusCode::kFailedPrecondition);
+  EXPECT_EQ(batch.steps[1].status().message(), "action 1: not your turn");
+  EXPECT_EQ(batch.committed.status(), batch.steps[1].status());
+  EXPECT_EQ(batch.steps[2].status().code(), absl::StatusCode::kAborted);
+  EXPECT_EQ(store->writes, 0);
+  auto stored = store->ReadGame(game_id);
+  ASSERT_TRUE(stored.ok());
+  EXPECT_EQ((*stored)->getVersionId(), (*joined)->getVersionId());
+
+  const Action off_the_hand[] = {{ActionType::SwapForDraw, 4}};
+  EXPECT_EQ(gm.applyBatch(game_id, "user1", off_the_hand).committed.status().code(),
+            absl::StatusCode::kInvalidArgument);
+  // A failed read keeps its own code.
+  EXPECT_EQ(gm.applyBatch("nosuchgame", "user1", moves).committed.status().code(),
+            absl::StatusCode::kNotFound);
+  EXPECT_FALSE(gm.applyBatch(game_id, "user1", {}).committed.ok());
+  EXPECT_EQ(store->writes, 0);
+}
+
+TEST(GameManager, TournamentDealsEachRoundInOneWrite) {
+  auto store = std::make_shared<CountingStore>();
+  GameManager gm{store};
+  std::vector<string> entrants;
+  for (int i = 0; i < 9; i++) {
+    entrants.push_back("player" + std::to_string(i));
+    EXPECT_TRUE(gm.registerUser(entrants.back()).ok());
+  }
+  EXPECT_FALSE(gm.newTournament(entrants, 1).ok());
+  EXPECT_FALSE(gm.newTournament({"player0", "player0"}, 2).ok());
+  EXPECT_FALSE(gm.newTournament({"player0", "nobody"}, 2).ok());
+
+  store->writes = 0;
+  auto tournament = gm.newTournament(entrants, 4);
+  ASSERT_TRUE(tournament.ok()) << tournament.status();
+  EXPECT_EQ(store->writes, 1);
+  auto first_round = (*tournament)->getGameIds();
+  ASSERT_EQ(first_round.size(), 3);
+  EXPECT_EQ((*tournament)->getTournamentId(), first_round[0]);
+  auto table = store->ReadGame(first_round[2]);
+  ASSERT_TRUE(table.ok());
+  EXPECT_TRUE((*table)->allPlayersPresent());
+  EXPECT_EQ((*table)->getPlayer(0).getName(), "player6");
+  // Seated players are in a game until it ends.
+  EXPECT_FALSE(gm.newGame("player0", 2).ok());
+
+  // Each table ends with its first seat knocking and everyone else taking a turn.
+  auto finish = [&](const string& game_id) {
+    auto game = store->ReadGame(game_id);
+    ASSERT_TRUE(game.ok());
+    auto& players = (*game)->getPlayers();
+    ASSERT_TRUE(gm.knock(game_id, *players[0].getName()).ok());
+    for (size_t seat = 1; seat < players.size(); seat++) {
+      ASSERT_TRUE(gm.swapDrawForDiscardPile(game_id, *players[seat].getName()).ok());
+    }
+  };
+  finish(first_round[0]);
+  finish(first_round[1]);
+  EXPECT_EQ((*gm.getTournament(first_round[0]))->getTablesLeft(), 1);
+  store->writes = 0;
+  finish(first_round[2]);
+  // The table's three moves, then the whole next round.
+  EXPECT_EQ(store->writes, 4);
+
+  auto second = gm.getTournament(first_round[0]);
+  ASSERT_TRUE(second.ok());
+  EXPECT_EQ((*second)->getRound(), 2);
+  ASSERT_EQ((*second)->getGameIds().size(), 1);
+  // A handed out tournament stays as it was.
+  EXPECT_EQ((*tournament)->getRound(), 1);
+
+  auto final_table = (*second)->getGameIds()[0];
+  finish(final_table);
+  auto over = gm.getTournament(first_round[0]);
+  ASSERT_TRUE(over.ok());
+  EXPECT_TRUE((*over)->isOver());
+  auto final_game = store->ReadGame(final_table);
+  ASSERT_TRUE(final_game.ok());
+  auto winners = (*final_game)->winners();
+  int winner = *std::ranges::min_element(winners);
+  EXPECT_EQ((*over)->getChampion(), (*final_game)->getPlayer(winner).getName());
+}
+
+TEST(GameManager, MatchDealsNextHandWhenOneEnds) {
+  auto store = std::make_shared<InMemoryGameStore>();
+  GameManager gm{store};
+  EXPECT_TRUE(gm.registerUser("user1").ok());
+  EXPECT_TRUE(gm.registerUser("user2").ok());
+
+  EXPECT_FALSE(gm.newMatch("user1", 2, 0).ok());
+  auto match_res = gm.newMatch("user1", 2, 2);
+  ASSERT_TRUE(match_res.ok());
+  auto match_id = (*match_res)->getMatchId();
+  EXPECT_TRUE(gm.joinGame(match_id, "user2").ok());
+
+  // user1 knocks and the hand ends after user2's turn.
+  ASSERT_TRUE(gm.knock(match_id, "user1").ok());
+  auto last_move = gm.swapDrawForDiscardPile(match_id, "user2");
+  ASSERT_TRUE(last_move.ok());
+  ASSERT_TRUE((*last_move)->isOver());
+
+  auto match = *gm.getMatch(match_id);
+  EXPECT_EQ(match->getHolesPlayed(), 1);
+  EXPECT_EQ(match->getStandings().total("user1"), (*last_move)->getPlayer(0).score());
+  EXPECT_EQ(match->getStandings().total("user2"), (*last_move)->getPlayer(1).score());
+  EXPECT_EQ(gm.getLeaderboard().size(), 2);
+
+  // Everyone is seated in the next hand, and user2 goes first.
+  auto next_id = match->getCurrentGameId();
+  ASSERT_NE(next_id, match_id);
+  auto next = *store->ReadGame(next_id);
+  EXPECT_TRUE(next->allPlayersPresent());
+  EXPECT_EQ(next->playerIndex("user2"), 0);
+
+  ASSERT_TRUE(gm.knock(next_id, "user2").ok());
+  ASSERT_TRUE(gm.swapDrawForDiscardPile(next_id, "user1").ok());
+  auto finished = *gm.getMatch(match_id);
+  EXPECT_TRUE(finished->isOver());
+  EXPECT_EQ(finished->getGameIds().size(), 2);
+  // The earlier snapshot is unchanged.
+  EXPECT_EQ(match->getHolesPlayed(), 1);
+
+  int hands_won = *gm.getLeaderboard().total("user1") + *gm.getLeaderboard().total("user2");
+  EXPECT_EQ(hands_won, 2);
+}
+
+TEST(GameManager, TournamentRoundWaitsForAWinnerSeatedElsewhere) {
+  auto store = std::make_shared<CountingStore>();
+  GameManager gm{store};
+  std::vector<string> entrants{"player0", "player1", "player2", "player3"};
+  for (auto& user_id : entrants) {
+    EXPECT_TRUE(gm.registerUser(user_id).ok());
+  }
+  EXPECT_TRUE(gm.registerUser("outsider").ok());
+  auto tournament = gm.newTournament(entrants, 2);
+  ASSERT_TRUE(tournament.ok()) << tournament.status();
+  auto first_round = (*tournament)->getGameIds();
+  ASSERT_EQ(first_round.size(), 2);
+
+  auto finish = [&](const string& game_id) -> GameStatePtr {
+    auto game = *store->ReadGame(game_id);
+    EXPECT_TRUE(gm.knock(game_id, *game->getPlayer(0).getName()).ok());
+    auto last = gm.swapDrawForDiscardPile(game_id, *game->getPlayer(1).getName());
+    EXPECT_TRUE(last.ok());
+    return last.ok() ? *last : nullptr;
+  };
+
+  // The first table's winner sits down in another game before the round is over.
+  auto first_table = finish(first_round[0]);
+  ASSERT_NE(first_table, nullptr);
+  auto winners = first_table->winners();
+  auto winner = *first_table->getPlayer(*std::ranges::min_element(winners)).getName();
+  auto side_game = gm.newGame(winner, 2);
+  ASSERT_TRUE(side_game.ok());
+  auto side_game_id = (*side_game)->getGameId();
+  ASSERT_TRUE(gm.joinGame(side_game_id, "outsider").ok());
+
+  // The last table's move stands even though the next round cannot be seated yet.
+  auto last_table = finish(first_round[1]);
+  ASSERT_NE(last_table, nullptr);
+  EXPECT_TRUE(last_table->isOver());
+  auto waiting = *gm.getTournament(first_round[0]);
+  EXPECT_TRUE(waiting->isRoundOver());
+  EXPECT_EQ(waiting->getRound(), 1);
+  EXPECT_FALSE(gm.dealPending().ok());
+  // Every attempt at the round is keyed alike, so a store that stored some tables reuses them.
+  std::vector<string> round_two_keys(2, first_round[0] + "/2");
+  EXPECT_EQ(std::vector<string>(store->batch_keys.end() - 2, store->batch_keys.end()),
+            round_two_keys);
+
+  // The side game ending frees the winner, and the round is dealt.
+  finish(side_game_id);
+  auto second = *gm.getTournament(first_round[0]);
+  EXPECT_EQ(second->getRound(), 2);
+  ASSERT_EQ(second->getGameIds().size(), 1);
+  EXPECT_TRUE((*store->ReadGame(second->getGameIds()[0]))->allPlayersPresent());
+  EXPECT_TRUE(gm.dealPending().ok());
+}
+
+TEST(GameManager, MatchMoveStandsWhenNextHandCannotBeDealt) {
+  auto store = std::make_shared<CountingStore>();
+  GameManager gm{store};
+  EXPECT_TRUE(gm.registerUser("user1").ok());
+  EXPECT_TRUE(gm.registerUser("user2").ok());
+  auto match_res = gm.newMatch("user1", 2, 2);
+  ASSERT_TRUE(match_res.ok());
+  auto match_id = (*match_res)->getMatchId();
+  ASSERT_TRUE(gm.joinGame(match_id, "user2").ok());
+  ASSERT_TRUE(gm.knock(match_id, "user1").ok());
+
+  store->fail_new_games = true;
+  auto last_move = gm.swapDrawForDiscardPile(match_id, "user2");
+  ASSERT_TRUE(last_move.ok()) << last_move.status();
+  EXPECT_TRUE((*last_move)->isOver());
+  EXPECT_TRUE((*store->ReadGame(match_id))->isOver());
+  // The hand is recorded, and the match waits for its next one.
+  auto waiting = *gm.getMatch(match_id);
+  EXPECT_EQ(waiting->getHolesPlayed(), 1);
+  EXPECT_EQ(waiting->getGameIds().size(), 1);
+  EXPECT_EQ(gm.dealPending().code(), absl::StatusCode::kUnavailable);
+
+  store->fail_new_games = false;
+  EXPECT_TRUE(gm.dealPending().ok());
+  auto dealt = *gm.getMatch(match_id);
+  ASSERT_EQ(dealt->getGameIds().size(), 2);
+  auto next = *store->ReadGame(dealt->getCurrentGameId());
+  EXPECT_TRUE(next->allPlayersPresent());
+  EXPECT_EQ(next->playerIndex("user2"), 0);
+}
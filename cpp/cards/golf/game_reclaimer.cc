@@ -0,0 +1,45 @@
+#include "cpp/cards/golf/game_reclaimer.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "absl/log/log.h"
+
+namespace golf {
+
+GameReclaimer::GameReclaimer(std::shared_ptr<InMemoryGameStore> store,
+                             std::chrono::milliseconds interval)
+    : store_(std::move(store)), interval_(interval), thread_([this] { run(); }) {}
+
+GameReclaimer::~GameReclaimer() {
+  {
+    std::scoped_lock lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void GameReclaimer::run() {
+  std::unique_lock lock{mutex_};
+  while (!cv_.wait_for(lock, interval_, [this] { return stopping_; })) {
+    lock.unlock();
+    // A full batch means there may be more due. The store keeps the games a failing sink
+    // refused, so try them again at the next interval rather than straight away.
+    for (;;) {
+      auto evicted = store_->EvictExpired();
+      if (!evicted.ok()) {
+        LOG(WARNING) << "archiving evicted games failed: " << evicted.status();
+        break;
+      }
+      if (*evicted < InMemoryGameStore::kEvictBatch) {
+        break;
+      }
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace golf
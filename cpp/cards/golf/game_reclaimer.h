@@ -0,0 +1,36 @@
+#ifndef CPP_CARDS_GOLF_GAME_RECLAIMER_H
+#define CPP_CARDS_GOLF_GAME_RECLAIMER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "cpp/cards/golf/in_memory_game_store.h"
+
+namespace golf {
+
+// Periodically evicts a store's expired games. Each pass takes the store's lock for one batch at a
+// time, so requests interleave with a large backlog of evictions. Stops and joins on destruction.
+class GameReclaimer {
+ public:
+  GameReclaimer(std::shared_ptr<InMemoryGameStore> store, std::chrono::milliseconds interval);
+  ~GameReclaimer();
+  GameReclaimer(const GameReclaimer&) = delete;
+  GameReclaimer& operator=(const GameReclaimer&) = delete;
+
+ private:
+  void run();
+
+  std::shared_ptr<InMemoryGameStore> store_;
+  const std::chrono::milliseconds interval_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
+
+}  // namespace golf
+
+#endif
@@ -22,10 +22,28 @@ using std::vector;
 
 bool GameState::isOver() const { return drawPile.empty() || whoseTurn == whoKnocked; }
 
-bool GameState::allPlayersPresent() const {
+bool GameState::computeAllPresent() const {
   return std::all_of(players.begin(), players.end(), [](const Player& p) { return p.isPresent(); });
 }
 
+LegalActions GameState::computeTurnActions() const {
+  if (isOver() || !allPresent) {
+    return 0;
+  }
+  constexpr LegalActions allPositions = 0xf;
+  LegalActions actions = kSwapDrawForDiscardPile | allPositions << kSwapForDrawPileShift;
+  if (!peekedAtDrawPile) {
+    actions |= kPeekAtDrawPile;
+    if (!discardPile.empty()) {
+      actions |= allPositions << kSwapForDiscardPileShift;
+    }
+    if (whoKnocked == -1) {
+      actions |= kKnock;
+    }
+  }
+  return actions;
+}
+
 unordered_set<int> GameState::winners() const {
   unordered_set<int> winningPlayers;
   int minScore = 40;  // max score is 9 10 Q K == 39
@@ -165,6 +183,9 @@ absl::StatusOr<GameState> GameState::swapForDiscardPile(int player, Position pos
   if (peekedAtDrawPile) {
     return FailedPreconditionError("cannot swap for discard after peeking");
   }
+  if (discardPile.empty()) {
+    return FailedPreconditionError("discard pile is empty");
+  }
 
   // remove top card from discard pile
   deque<Card> mutableDiscardPile{discardPile};
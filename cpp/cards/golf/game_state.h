@@ -1,6 +1,7 @@
 #ifndef CPP_CARDS_GOLF_GAME_STATE_H
 #define CPP_CARDS_GOLF_GAME_STATE_H
 
+#include <cstdint>
 #include <deque>
 #include <string>
 #include <unordered_set>
@@ -15,6 +16,21 @@ namespace golf {
 using namespace cards;
 using std::string;
 
+// A set of moves as bits. The swaps that take a hand position have one bit per Position, at the
+// Position's value above their shift.
+typedef uint32_t LegalActions;
+inline constexpr LegalActions kPeekAtDrawPile = 1u << 0;
+inline constexpr LegalActions kSwapDrawForDiscardPile = 1u << 1;
+inline constexpr LegalActions kKnock = 1u << 2;
+inline constexpr int kSwapForDrawPileShift = 4;
+inline constexpr int kSwapForDiscardPileShift = 8;
+inline constexpr LegalActions swapForDrawPileBit(Position position) {
+  return 1u << (kSwapForDrawPileShift + static_cast<int>(position));
+}
+inline constexpr LegalActions swapForDiscardPileBit(Position position) {
+  return 1u << (kSwapForDiscardPileShift + static_cast<int>(position));
+}
+
 class GameState {
  public:
   GameState(std::deque<Card> _drawPile, std::deque<Card> _discardPile, std::vector<Player> _players,
@@ -24,7 +40,9 @@ class GameState {
         players(std::move(_players)),
         peekedAtDrawPile(_peekedAtDrawPile),
         whoseTurn(_whoseTurn),
-        whoKnocked(_whoKnocked) {}
+        whoKnocked(_whoKnocked),
+        allPresent(computeAllPresent()),
+        turnActions(computeTurnActions()) {}
 
   GameState(std::deque<Card> _drawPile, std::deque<Card> _discardPile, std::vector<Player> _players,
             bool _peekedAtDrawPile, int _whoseTurn, int _whoKnocked, string _gameId,
@@ -36,9 +54,16 @@ class GameState {
         whoseTurn(_whoseTurn),
         whoKnocked(_whoKnocked),
         gameId(std::move(_gameId)),
-        version_id(std::move(_version_id)) {}
+        version_id(std::move(_version_id)),
+        allPresent(computeAllPresent()),
+        turnActions(computeTurnActions()) {}
   [[nodiscard]] bool isOver() const;
-  [[nodiscard]] bool allPlayersPresent() const;
+  [[nodiscard]] bool allPlayersPresent() const { return allPresent; }
+  // The moves `player` may make now: exactly those whose transition would not fail. Computed once
+  // per state, so this is a comparison and a load.
+  [[nodiscard]] LegalActions legalActions(int player) const {
+    return player == whoseTurn ? turnActions : 0;
+  }
   [[nodiscard]] std::unordered_set<int> winners() const;  // winning player indices
   [[nodiscard]] absl::StatusOr<GameState> peekAtDrawPile(int player) const;
   [[nodiscard]] absl::StatusOr<GameState> swapForDrawPile(int player, Position Position) const;
@@ -68,6 +93,8 @@ class GameState {
   [[nodiscard]] const string& getVersionId() const { return version_id; }
 
  private:
+  // Still Cards rather than a Shoe's packed bytes. Even four decks fit in one of libstdc++'s
+  // 512-byte deque blocks, so a game's piles cost about the same at any table size.
   const std::deque<Card> drawPile;
   const std::deque<Card> discardPile;
   const std::vector<Player> players;
@@ -76,6 +103,12 @@ class GameState {
   const int whoKnocked;
   const std::string gameId;
   const std::string version_id;
+  // Cached phase flags, which depend only on the members above.
+  const bool allPresent;
+  const LegalActions turnActions;
+
+  [[nodiscard]] bool computeAllPresent() const;
+  [[nodiscard]] LegalActions computeTurnActions() const;
 };
 
 typedef std::shared_ptr<const GameState> GameStatePtr;
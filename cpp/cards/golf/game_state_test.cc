@@ -305,3 +305,71 @@ TEST(GameState, KnockIsOnlyAllowedOnce) {
   EXPECT_FALSE(g2.ok());
   EXPECT_EQ(g2.status().message(), "someone already knocked");
 }
+
+TEST(GameState, LegalActions) {
+  const Player p0{"Andy", Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+                  Card(Suit::Hearts, Rank::Two), Card(Suit::Spades, Rank::Two)};
+  const Player p1{"Mercy", Card(Suit::Clubs, Rank::Three), Card(Suit::Diamonds, Rank::Three),
+                  Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+
+  const std::deque<Card> drawPile{Card{Suit::Diamonds, Rank::Ten}};
+  const std::deque<Card> discardPile{Card{Suit::Hearts, Rank::Four}};
+  const std::vector<Player> players{p0, p1};
+
+  const GameState fresh{drawPile, discardPile, players, false, 0, -1, "foo", "bar"};
+  EXPECT_EQ(fresh.legalActions(0),
+            kPeekAtDrawPile | kSwapDrawForDiscardPile | kKnock | 0xf0 | 0xf00);
+  EXPECT_EQ(fresh.legalActions(1), 0);
+  EXPECT_EQ(fresh.legalActions(-1), 0);
+
+  const GameState peeked{drawPile, discardPile, players, true, 0, -1, "foo", "bar"};
+  EXPECT_EQ(peeked.legalActions(0), kSwapDrawForDiscardPile | 0xf0);
+
+  const GameState knocked{drawPile, discardPile, players, false, 1, 0, "foo", "bar"};
+  EXPECT_FALSE(knocked.legalActions(1) & kKnock);
+  EXPECT_TRUE(knocked.legalActions(1) & swapForDiscardPileBit(Position::BottomRight));
+
+  const GameState over{{}, discardPile, players, false, 0, -1, "foo", "bar"};
+  EXPECT_EQ(over.legalActions(0), 0);
+
+  const Player empty{Card(Suit::Clubs, Rank::Four), Card(Suit::Diamonds, Rank::Four),
+                     Card(Suit::Hearts, Rank::Four), Card(Suit::Spades, Rank::Four)};
+  const GameState waiting{drawPile, discardPile, {p0, empty}, false, 0, -1, "foo", "bar"};
+  EXPECT_EQ(waiting.legalActions(0), 0);
+}
+
+TEST(GameState, LegalActionsMatchTransitions) {
+  const Player p0{"Andy", Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+                  Card(Suit::Hearts, Rank::Two), Card(Suit::Spades, Rank::Two)};
+  const Player p1{"Mercy", Card(Suit::Clubs, Rank::Three), Card(Suit::Diamonds, Rank::Three),
+                  Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+  const std::deque<Card> drawPile{Card{Suit::Diamonds, Rank::Ten}};
+  const Player empty{Card(Suit::Clubs, Rank::Four), Card(Suit::Diamonds, Rank::Four),
+                     Card(Suit::Hearts, Rank::Four), Card(Suit::Spades, Rank::Four)};
+
+  for (const auto& discardPile : {std::deque<Card>{Card{Suit::Hearts, Rank::Four}},
+                                  std::deque<Card>{}}) {
+    for (bool peeked : {false, true}) {
+      for (int whoKnocked : {-1, 0, 1}) {
+        for (const auto& players :
+             {std::vector<Player>{p0, p1}, std::vector<Player>{p0, empty}}) {
+          const GameState g{drawPile, discardPile, players, peeked, 0, whoKnocked, "foo", "bar"};
+          for (int player : {0, 1}) {
+            LegalActions legal = g.legalActions(player);
+            EXPECT_EQ(g.peekAtDrawPile(player).ok(), (legal & kPeekAtDrawPile) != 0);
+            EXPECT_EQ(g.swapDrawForDiscardPile(player).ok(),
+                      (legal & kSwapDrawForDiscardPile) != 0);
+            EXPECT_EQ(g.knock(player).ok(), (legal & kKnock) != 0);
+            for (auto position : {Position::TopLeft, Position::TopRight, Position::BottomLeft,
+                                  Position::BottomRight}) {
+              EXPECT_EQ(g.swapForDrawPile(player, position).ok(),
+                        (legal & swapForDrawPileBit(position)) != 0);
+              EXPECT_EQ(g.swapForDiscardPile(player, position).ok(),
+                        (legal & swapForDiscardPileBit(position)) != 0);
+            }
+          }
+        }
+      }
+    }
+  }
+}
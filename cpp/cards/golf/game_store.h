@@ -3,6 +3,7 @@
 
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -23,9 +24,21 @@ class GameStoreInterface {
   virtual Status RemoveUser(const string& user_id) = 0;
   virtual StatusOr<std::unordered_set<string>> GetUsers() const = 0;
   virtual StatusOr<GameStatePtr> NewGame(const GameStatePtr game_state) = 0;
+  // NewGame for each of `game_states`, e.g. every table of a tournament round. The stored games
+  // come back in the same order. A store that cannot write them all at once remembers the games a
+  // failed call did store under a non-empty `batch_key`, and a retry with the same key stores
+  // only the rest rather than storing them twice.
+  virtual StatusOr<std::vector<GameStatePtr>> NewGames(const std::vector<GameStatePtr>& game_states,
+                                                       const string& batch_key) = 0;
   virtual StatusOr<GameStatePtr> ReadGame(const string& game_id) const = 0;
   virtual StatusOr<GameStatePtr> ReadGameByUserId(const string& user_id) const = 0;
+  // The game if `user_id` holds a seat in it, checked against the game itself in the same read:
+  // NotFoundError if there is no such game, PermissionDeniedError if the user is not seated.
+  virtual StatusOr<GameStatePtr> ReadGameForUser(const string& game_id,
+                                                 const string& user_id) const = 0;
   virtual StatusOr<std::unordered_set<GameStatePtr>> ReadAllGames() const = 0;
+  // Stores `game_state`, which must carry the version id of the state it was made from, and
+  // returns it with a new one. Fails if the game has been updated since that version was read.
   virtual StatusOr<GameStatePtr> UpdateGame(const GameStatePtr game_state) = 0;
 };
 }  // namespace golf
@@ -1,11 +1,16 @@
 #include "cpp/cards/golf/in_memory_game_store.h"
 
+#include <chrono>
+#include <functional>
 #include <mutex>
 #include <ranges>
 #include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "absl/status/statusor.h"
+#include "cpp/lock_profiling/profiled_mutex.h"
 
 namespace golf {
 using absl::Status;
@@ -13,10 +18,11 @@ using absl::StatusOr;
 using std::string;
 using std::unordered_set;
 
-std::mutex users_mutex{};
-std::mutex game_state_mutex{};
+lock_profiling::ProfiledMutex users_mutex{"golf.InMemoryGameStore.users"};
+lock_profiling::ProfiledMutex game_state_mutex{"golf.InMemoryGameStore.games"};
 
-static int counter = 0;
+InMemoryGameStore::InMemoryGameStore(EvictionPolicy policy, std::function<Clock::time_point()> now)
+    : policy_(std::move(policy)), now_(std::move(now)) {}
 
 Status InMemoryGameStore::AddUser(const string& user_id) {
   std::scoped_lock lock{users_mutex};
@@ -45,29 +51,90 @@ StatusOr<unordered_set<string>> InMemoryGameStore::GetUsers() const {
 }
 
 StatusOr<GameStatePtr> InMemoryGameStore::NewGame(const GameStatePtr game_state_no_id) {
+  string game_id = ids_.next();
   std::scoped_lock lock{game_state_mutex};
-  string game_id = std::to_string(counter++);
-  auto game_state = std::make_shared<GameState>(game_state_no_id->withIdAndVersion(game_id, "foo"));
+  auto game_state =
+      std::make_shared<GameState>(game_state_no_id->withIdAndVersion(game_id, nextVersion()));
   auto user_id_maybe = game_state->getPlayer(0).getName();
   if (user_id_maybe->empty()) {
     return absl::InternalError(
         "game_state cannot be created without a player. This should have been validated upstream.");
   }
-  auto user_id = user_id_maybe.value();
 
-  if (game_ids_by_user_id.contains(user_id)) {
-    return absl::InvalidArgumentError("already in game");
+  // A player whose last game has ended may start another, as every player does between the hands
+  // of a match.
+  for (auto& p : game_state->getPlayers()) {
+    if (!p.getName().has_value()) {
+      continue;
+    }
+    auto existing = game_ids_by_user_id.find(p.getName().value());
+    if (existing != game_ids_by_user_id.end() && !games_by_id.at(existing->second)->isOver()) {
+      return absl::InvalidArgumentError("already in game");
+    }
   }
 
   auto emplaceWorked = games_by_id.emplace(game_state->getGameId(), game_state);
   if (!emplaceWorked.second) {
-    return absl::InvalidArgumentError("could not generate unused game id");
+    return absl::InternalError("generated game id already in use");
   }
 
-  game_ids_by_user_id[user_id] = game_id;
+  for (auto& p : game_state->getPlayers()) {
+    if (p.getName().has_value()) {
+      game_ids_by_user_id[p.getName().value()] = game_id;
+    }
+  }
+  touch(*game_state);
   return games_by_id.at(game_id);
 }
 
+// All or nothing, so the batch key is not needed.
+StatusOr<std::vector<GameStatePtr>> InMemoryGameStore::NewGames(
+    const std::vector<GameStatePtr>& game_states_no_id, const string&) {
+  std::vector<GameStatePtr> game_states;
+  game_states.reserve(game_states_no_id.size());
+  std::scoped_lock lock{game_state_mutex};
+  for (auto& game_state : game_states_no_id) {
+    if (!game_state->getPlayer(0).getName().has_value()) {
+      return absl::InternalError(
+          "game_state cannot be created without a player. This should have been validated "
+          "upstream.");
+    }
+    game_states.push_back(
+        std::make_shared<GameState>(game_state->withIdAndVersion(ids_.next(), nextVersion())));
+  }
+
+  // All or nothing: every check is made before the first game goes in.
+  unordered_set<string> seated;
+  for (auto& game_state : game_states) {
+    for (auto& p : game_state->getPlayers()) {
+      if (!p.getName().has_value()) {
+        continue;
+      }
+      auto& user_id = p.getName().value();
+      auto existing = game_ids_by_user_id.find(user_id);
+      if (!seated.insert(user_id).second ||
+          (existing != game_ids_by_user_id.end() && !games_by_id.at(existing->second)->isOver())) {
+        return absl::InvalidArgumentError("already in game");
+      }
+    }
+    if (games_by_id.contains(game_state->getGameId())) {
+      return absl::InternalError("generated game id already in use");
+    }
+  }
+
+  games_by_id.reserve(games_by_id.size() + game_states.size());
+  for (auto& game_state : game_states) {
+    games_by_id.emplace(game_state->getGameId(), game_state);
+    for (auto& p : game_state->getPlayers()) {
+      if (p.getName().has_value()) {
+        game_ids_by_user_id[p.getName().value()] = game_state->getGameId();
+      }
+    }
+    touch(*game_state);
+  }
+  return game_states;
+}
+
 StatusOr<GameStatePtr> InMemoryGameStore::ReadGame(const string& game_id) const {
   std::scoped_lock lock{game_state_mutex};
   if (games_by_id.contains(game_id)) {
@@ -84,23 +151,44 @@ StatusOr<GameStatePtr> InMemoryGameStore::ReadGameByUserId(const string& user_id
   return absl::NotFoundError("game not found");
 }
 
-StatusOr<GameStatePtr> InMemoryGameStore::UpdateGame(const GameStatePtr game_state) {
+StatusOr<GameStatePtr> InMemoryGameStore::ReadGameForUser(const string& game_id,
+                                                          const string& user_id) const {
   std::scoped_lock lock{game_state_mutex};
-  auto game_id = game_state->getGameId();
-  if (!games_by_id.contains(game_id)) {
+  auto it = games_by_id.find(game_id);
+  if (it == games_by_id.end()) {
+    return absl::NotFoundError("game not found");
+  }
+  if (it->second->playerIndex(user_id) < 0) {
+    return absl::PermissionDeniedError("not in this game");
+  }
+  return it->second;
+}
+
+StatusOr<GameStatePtr> InMemoryGameStore::UpdateGame(const GameStatePtr game_state_read) {
+  std::scoped_lock lock{game_state_mutex};
+  auto& game_id = game_state_read->getGameId();
+  auto stored = games_by_id.find(game_id);
+  if (stored == games_by_id.end()) {
     return absl::InvalidArgumentError("game does not exist");
   }
-  if (games_by_id.at(game_id)->isOver()) {
+  if (stored->second->isOver()) {
     return absl::InvalidArgumentError("game is over");
   }
+  // Compare-and-set, as DocDb does: the update must be based on the version stored now.
+  if (stored->second->getVersionId() != game_state_read->getVersionId()) {
+    return absl::AbortedError("game has changed since it was read");
+  }
 
+  auto game_state =
+      std::make_shared<GameState>(game_state_read->withIdAndVersion(game_id, nextVersion()));
   for (auto p : game_state->getPlayers()) {
     if (p.isPresent() && p.getName().has_value()) {
       game_ids_by_user_id[p.getName().value()] = game_id;
     }
   }
 
-  games_by_id[game_id] = game_state;
+  stored->second = game_state;
+  touch(*game_state);
   return game_state;
 }
 
@@ -115,4 +203,67 @@ StatusOr<unordered_set<GameStatePtr>> InMemoryGameStore::ReadAllGames() const {
   }
   return games;
 }
+
+string InMemoryGameStore::nextVersion() { return std::to_string(++last_version_); }
+
+void InMemoryGameStore::touch(const GameState& game) {
+  if (!policy_) {
+    return;
+  }
+  auto deadline = now_() + (game.isOver() ? policy_->finished_ttl : policy_->idle_ttl);
+  auto [it, inserted] = deadline_by_game_id_.try_emplace(game.getGameId(), deadline);
+  if (!inserted) {
+    expiry_index_.erase({it->second, game.getGameId()});
+    it->second = deadline;
+  }
+  expiry_index_.emplace(deadline, game.getGameId());
+}
+
+StatusOr<int> InMemoryGameStore::EvictExpired(int max_games) {
+  if (!policy_) {
+    return 0;
+  }
+  int evicted = 0;
+  std::vector<EvictedGame> finished;
+  {
+    std::scoped_lock lock{game_state_mutex};
+    auto now = now_();
+    while (evicted < max_games && !expiry_index_.empty() && expiry_index_.begin()->first <= now) {
+      auto node = expiry_index_.extract(expiry_index_.begin());
+      auto& [deadline, game_id] = node.value();
+      deadline_by_game_id_.erase(game_id);
+      auto game = games_by_id.extract(game_id);
+      evicted++;
+      for (auto& p : game.mapped()->getPlayers()) {
+        if (!p.getName().has_value()) {
+          continue;
+        }
+        // The player may have moved on to a newer game already.
+        auto mapped = game_ids_by_user_id.find(p.getName().value());
+        if (mapped != game_ids_by_user_id.end() && mapped->second == game_id) {
+          game_ids_by_user_id.erase(mapped);
+        }
+      }
+      if (game.mapped()->isOver()) {
+        finished.push_back({game.mapped(), deadline - policy_->finished_ttl});
+      }
+    }
+  }
+
+  if (policy_->sink && !finished.empty()) {
+    if (auto status = policy_->sink->Archive(finished); !status.ok()) {
+      // Put the finished games back, still due, so that the next call offers them again. Their
+      // players stay free to start new games.
+      std::scoped_lock lock{game_state_mutex};
+      for (auto& [game, finished_at] : finished) {
+        auto deadline = finished_at + policy_->finished_ttl;
+        games_by_id.emplace(game->getGameId(), game);
+        deadline_by_game_id_.emplace(game->getGameId(), deadline);
+        expiry_index_.emplace(deadline, game->getGameId());
+      }
+      return status;
+    }
+  }
+  return evicted;
+}
 }  // namespace golf
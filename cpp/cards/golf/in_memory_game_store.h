@@ -1,13 +1,21 @@
 #ifndef CPP_CARDS_GOLF_IN_MEMORY_GAME_STORE_H
 #define CPP_CARDS_GOLF_IN_MEMORY_GAME_STORE_H
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "cpp/cards/golf/game_id.h"
 #include "cpp/cards/golf/game_state.h"
 #include "cpp/cards/golf/game_store.h"
 
@@ -18,22 +26,81 @@ using absl::StatusOr;
 using std::string;
 using std::unordered_set;
 
+struct EvictedGame {
+  GameStatePtr game;
+  // When the game's last move was stored.
+  std::chrono::system_clock::time_point finished_at;
+};
+
+// Cold storage for finished games once the store lets go of them, e.g. an archive file.
+class GameSinkInterface {
+ public:
+  virtual ~GameSinkInterface() {}
+  // Called without any of the store's locks held.
+  virtual Status Archive(const std::vector<EvictedGame>& games) = 0;
+};
+
+struct EvictionPolicy {
+  // How long a finished game stays readable after its last move.
+  std::chrono::milliseconds finished_ttl = std::chrono::minutes(10);
+  // How long an unfinished game may go without a move before it counts as abandoned.
+  std::chrono::milliseconds idle_ttl = std::chrono::hours(2);
+  // Evicted finished games are handed here when set. Abandoned games are dropped.
+  std::shared_ptr<GameSinkInterface> sink;
+};
+
 class InMemoryGameStore final : public GameStoreInterface {
  public:
+  using Clock = std::chrono::system_clock;
+
+  // Most games EvictExpired() removes under one hold of the lock.
+  static constexpr int kEvictBatch = 256;
+
+  // Keeps every game forever.
+  InMemoryGameStore() = default;
+  // Lets games go once `policy`'s TTLs have passed and EvictExpired() runs. The clock is the
+  // wall clock so that the times handed to the sink mean something outside this process.
+  explicit InMemoryGameStore(EvictionPolicy policy,
+                             std::function<Clock::time_point()> now = Clock::now);
+
   Status AddUser(const string& user_id) override;
   StatusOr<bool> UserExists(const string& user_id) const override;
   Status RemoveUser(const string& user_id) override;
   StatusOr<std::unordered_set<string>> GetUsers() const override;
   StatusOr<GameStatePtr> NewGame(const GameStatePtr game_state) override;
+  StatusOr<std::vector<GameStatePtr>> NewGames(const std::vector<GameStatePtr>& game_states,
+                                               const string& batch_key) override;
   StatusOr<GameStatePtr> ReadGame(const string& game_id) const override;
   StatusOr<GameStatePtr> ReadGameByUserId(const string& user_id) const override;
+  StatusOr<GameStatePtr> ReadGameForUser(const string& game_id,
+                                         const string& user_id) const override;
   StatusOr<unordered_set<GameStatePtr>> ReadAllGames() const override;
   StatusOr<GameStatePtr> UpdateGame(const GameStatePtr game_state) override;
 
+  // Removes up to `max_games` games whose TTL has passed, earliest deadline first, and unmaps
+  // their players so they can start new games. Finished ones then go to the policy's sink. Returns
+  // how many were removed, or the sink's error, in which case the finished games stay in the store
+  // and are handed to the sink again by the next call.
+  StatusOr<int> EvictExpired(int max_games = kEvictBatch);
+
  private:
+  // Restarts `game`'s TTL from now. Requires game_state_mutex.
+  void touch(const GameState& game);
+  // A version id no game in this store has had before. Requires game_state_mutex.
+  string nextVersion();
+
   std::unordered_set<string> users_online;
   std::unordered_map<string, string> game_ids_by_user_id;
   std::unordered_map<string, GameStatePtr> games_by_id;
+  GameIdGenerator ids_{GameIdGenerator::NodeIdFromEnvironment()};
+  uint64_t last_version_ = 0;
+
+  std::optional<EvictionPolicy> policy_;
+  std::function<Clock::time_point()> now_;
+  // Each game's eviction deadline, and the same deadlines in order so that eviction only ever
+  // looks at games that are due.
+  std::unordered_map<string, Clock::time_point> deadline_by_game_id_;
+  std::set<std::pair<Clock::time_point, string>> expiry_index_;
 };
 }  // namespace golf
 
@@ -0,0 +1,162 @@
+#include "cpp/cards/golf/in_memory_game_store.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/player.h"
+
+using namespace cards;
+using namespace golf;
+using namespace std::chrono_literals;
+
+namespace {
+class FakeSink final : public GameSinkInterface {
+ public:
+  Status Archive(const std::vector<EvictedGame>& games) override {
+    if (fail) {
+      return absl::UnavailableError("archive is down");
+    }
+    archived.insert(archived.end(), games.begin(), games.end());
+    return absl::OkStatus();
+  }
+
+  std::vector<EvictedGame> archived;
+  bool fail = false;
+};
+
+// alice and bob mid-game, or with the draw pile used up and the game over. An update must carry
+// the version it replaces.
+GameStatePtr Game(bool over, const std::string& game_id = "", const std::string& version = "") {
+  Player alice{"alice", Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+               Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+  Player bob{"bob", Card(Suit::Clubs, Rank::Five), Card(Suit::Diamonds, Rank::Six),
+             Card(Suit::Hearts, Rank::Seven), Card(Suit::Spades, Rank::Eight)};
+  std::deque<Card> draw;
+  if (!over) {
+    draw.emplace_back(Suit::Clubs, Rank::Ace);
+  }
+  return std::make_shared<GameState>(GameState{
+      draw, {Card(Suit::Clubs, Rank::Four)}, {alice, bob}, false, 0, -1, game_id, version});
+}
+
+struct Fixture {
+  InMemoryGameStore::Clock::time_point now{std::chrono::hours(1000)};
+  std::shared_ptr<FakeSink> sink = std::make_shared<FakeSink>();
+  InMemoryGameStore store{EvictionPolicy{10min, 60min, sink}, [this] { return now; }};
+};
+}  // namespace
+
+TEST(InMemoryGameStore, EvictsFinishedGamesToTheSink) {
+  Fixture f;
+  auto game = f.store.NewGame(Game(false));
+  ASSERT_TRUE(game.ok());
+  auto id = (*game)->getGameId();
+  f.now += 5min;
+  ASSERT_TRUE(f.store.UpdateGame(Game(true, id, (*game)->getVersionId())).ok());
+  auto finished_at = f.now;
+
+  f.now += 9min;
+  EXPECT_EQ(*f.store.EvictExpired(), 0);
+  EXPECT_TRUE(f.store.ReadGame(id).ok());
+
+  f.now += 1min;
+  EXPECT_EQ(*f.store.EvictExpired(), 1);
+  EXPECT_EQ(f.store.ReadGame(id).status().code(), absl::StatusCode::kNotFound);
+  EXPECT_EQ(f.store.ReadGameByUserId("bob").status().code(), absl::StatusCode::kNotFound);
+  ASSERT_EQ(f.sink->archived.size(), 1);
+  EXPECT_EQ(f.sink->archived[0].game->getGameId(), id);
+  EXPECT_EQ(f.sink->archived[0].finished_at, finished_at);
+}
+
+TEST(InMemoryGameStore, KeepsFinishedGamesTheSinkRefuses) {
+  Fixture f;
+  auto game = f.store.NewGame(Game(false));
+  ASSERT_TRUE(game.ok());
+  auto id = (*game)->getGameId();
+  ASSERT_TRUE(f.store.UpdateGame(Game(true, id, (*game)->getVersionId())).ok());
+  auto finished_at = f.now;
+
+  f.now += 10min;
+  f.sink->fail = true;
+  EXPECT_EQ(f.store.EvictExpired().status().code(), absl::StatusCode::kUnavailable);
+  EXPECT_TRUE(f.store.ReadGame(id).ok());
+  EXPECT_TRUE(f.store.NewGame(Game(false)).ok());
+
+  f.sink->fail = false;
+  EXPECT_EQ(*f.store.EvictExpired(), 1);
+  EXPECT_EQ(f.store.ReadGame(id).status().code(), absl::StatusCode::kNotFound);
+  ASSERT_EQ(f.sink->archived.size(), 1);
+  EXPECT_EQ(f.sink->archived[0].game->getGameId(), id);
+  EXPECT_EQ(f.sink->archived[0].finished_at, finished_at);
+}
+
+TEST(InMemoryGameStore, DropsAbandonedGamesAndFreesTheirPlayers) {
+  Fixture f;
+  auto game = f.store.NewGame(Game(false));
+  ASSERT_TRUE(game.ok());
+  f.now += 59min;
+  EXPECT_EQ(f.store.NewGame(Game(false)).status().message(), "already in game");
+
+  // A move restarts the clock.
+  ASSERT_TRUE(
+      f.store.UpdateGame(Game(false, (*game)->getGameId(), (*game)->getVersionId())).ok());
+  f.now += 59min;
+  EXPECT_EQ(*f.store.EvictExpired(), 0);
+
+  f.now += 1min;
+  EXPECT_EQ(*f.store.EvictExpired(), 1);
+  EXPECT_TRUE(f.sink->archived.empty());
+  EXPECT_TRUE(f.store.NewGame(Game(false)).ok());
+}
+
+TEST(InMemoryGameStore, EvictsInBatchesByDeadline) {
+  Fixture f;
+  std::vector<std::string> ids;
+  for (int i = 0; i < 3; i++) {
+    auto game = f.store.NewGame(Game(false));
+    ASSERT_TRUE(game.ok());
+    ids.push_back((*game)->getGameId());
+    ASSERT_TRUE(f.store.UpdateGame(Game(true, ids.back(), (*game)->getVersionId())).ok());
+    f.now += 1min;
+  }
+
+  f.now += 10min;
+  EXPECT_EQ(*f.store.EvictExpired(2), 2);
+  ASSERT_EQ(f.sink->archived.size(), 2);
+  EXPECT_EQ(f.sink->archived[0].game->getGameId(), ids[0]);
+  EXPECT_EQ(f.sink->archived[1].game->getGameId(), ids[1]);
+  EXPECT_TRUE(f.store.ReadGame(ids[2]).ok());
+  EXPECT_EQ(*f.store.EvictExpired(2), 1);
+}
+
+TEST(InMemoryGameStore, KeepsEverythingWithoutAPolicy) {
+  InMemoryGameStore store;
+  auto game = store.NewGame(Game(false));
+  ASSERT_TRUE(game.ok());
+  ASSERT_TRUE(store.UpdateGame(Game(true, (*game)->getGameId(), (*game)->getVersionId())).ok());
+  EXPECT_EQ(*store.EvictExpired(), 0);
+  EXPECT_TRUE(store.ReadGame((*game)->getGameId()).ok());
+}
+
+TEST(InMemoryGameStore, RejectsUpdatesToAStaleVersion) {
+  InMemoryGameStore store;
+  auto game = store.NewGame(Game(false));
+  ASSERT_TRUE(game.ok());
+  auto& id = (*game)->getGameId();
+
+  auto first = store.UpdateGame(Game(false, id, (*game)->getVersionId()));
+  ASSERT_TRUE(first.ok());
+  EXPECT_NE((*first)->getVersionId(), (*game)->getVersionId());
+  // A second writer that read the same version loses.
+  EXPECT_EQ(store.UpdateGame(Game(true, id, (*game)->getVersionId())).status().code(),
+            absl::StatusCode::kAborted);
+  EXPECT_FALSE((*store.ReadGame(id))->isOver());
+
+  EXPECT_TRUE(store.UpdateGame(Game(true, id, (*first)->getVersionId())).ok());
+}
@@ -0,0 +1,170 @@
+#include "cpp/cards/golf/leaderboard.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace golf {
+
+namespace {
+// splitmix64's finalizer: spreads node numbers into priorities that are random enough to keep the
+// treap balanced, and the same on every run.
+uint32_t Priority(uint64_t z) {
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return static_cast<uint32_t>(z ^ (z >> 31));
+}
+}  // namespace
+
+void Leaderboard::add(const string& user_id, int points) {
+  int delta = order_ == Order::LowestFirst ? points : -points;
+  auto it = index_.find(user_id);
+  if (it == index_.end()) {
+    int node = static_cast<int>(nodes_.size());
+    nodes_.push_back(Node{user_id, delta, Priority(nodes_.size())});
+    index_.emplace(user_id, node);
+    root_ = insert(root_, node);
+    return;
+  }
+  if (points == 0) {
+    return;
+  }
+  // Take the node out, move it, and put it back where its new total belongs.
+  int node = it->second;
+  root_ = erase(root_, node);
+  nodes_[node].key += delta;
+  nodes_[node].left = nodes_[node].right = -1;
+  nodes_[node].size = 1;
+  root_ = insert(root_, node);
+}
+
+std::optional<int> Leaderboard::total(const string& user_id) const {
+  auto it = index_.find(user_id);
+  if (it == index_.end()) {
+    return std::nullopt;
+  }
+  int key = nodes_[it->second].key;
+  return order_ == Order::LowestFirst ? key : -key;
+}
+
+std::optional<int> Leaderboard::rank(const string& user_id) const {
+  auto it = index_.find(user_id);
+  if (it == index_.end()) {
+    return std::nullopt;
+  }
+  return 1 + countBefore(nodes_[it->second].key);
+}
+
+std::vector<Leaderboard::Standing> Leaderboard::top(size_t n) const {
+  std::vector<Standing> standings;
+  standings.reserve(std::min(n, size()));
+  // In-order walk that stops after n nodes.
+  std::vector<int> path;
+  int node = root_;
+  while (standings.size() < n && (node != -1 || !path.empty())) {
+    for (; node != -1; node = nodes_[node].left) {
+      path.push_back(node);
+    }
+    node = path.back();
+    path.pop_back();
+    auto& entry = nodes_[node];
+    int rank = standings.empty() || standings.back().total != entry.key
+                   ? static_cast<int>(standings.size()) + 1
+                   : standings.back().rank;
+    standings.push_back(Standing{entry.user_id, entry.key, rank});
+    node = entry.right;
+  }
+  if (order_ == Order::HighestFirst) {
+    for (auto& standing : standings) {
+      standing.total = -standing.total;
+    }
+  }
+  return standings;
+}
+
+bool Leaderboard::before(int a, int b) const {
+  auto& x = nodes_[a];
+  auto& y = nodes_[b];
+  return x.key != y.key ? x.key < y.key : x.user_id < y.user_id;
+}
+
+void Leaderboard::resize(int node) {
+  nodes_[node].size = 1 + size(nodes_[node].left) + size(nodes_[node].right);
+}
+
+void Leaderboard::split(int tree, int node, int& left, int& right) {
+  if (tree == -1) {
+    left = right = -1;
+    return;
+  }
+  if (before(tree, node)) {
+    split(nodes_[tree].right, node, nodes_[tree].right, right);
+    left = tree;
+  } else {
+    split(nodes_[tree].left, node, left, nodes_[tree].left);
+    right = tree;
+  }
+  resize(tree);
+}
+
+int Leaderboard::merge(int left, int right) {
+  if (left == -1 || right == -1) {
+    return left == -1 ? right : left;
+  }
+  if (nodes_[left].priority > nodes_[right].priority) {
+    nodes_[left].right = merge(nodes_[left].right, right);
+    resize(left);
+    return left;
+  }
+  nodes_[right].left = merge(left, nodes_[right].left);
+  resize(right);
+  return right;
+}
+
+int Leaderboard::insert(int tree, int node) {
+  if (tree == -1) {
+    return node;
+  }
+  if (nodes_[node].priority > nodes_[tree].priority) {
+    split(tree, node, nodes_[node].left, nodes_[node].right);
+    resize(node);
+    return node;
+  }
+  if (before(node, tree)) {
+    nodes_[tree].left = insert(nodes_[tree].left, node);
+  } else {
+    nodes_[tree].right = insert(nodes_[tree].right, node);
+  }
+  resize(tree);
+  return tree;
+}
+
+int Leaderboard::erase(int tree, int node) {
+  if (tree == node) {
+    return merge(nodes_[node].left, nodes_[node].right);
+  }
+  if (before(node, tree)) {
+    nodes_[tree].left = erase(nodes_[tree].left, node);
+  } else {
+    nodes_[tree].right = erase(nodes_[tree].right, node);
+  }
+  resize(tree);
+  return tree;
+}
+
+int Leaderboard::countBefore(int key) const {
+  int count = 0;
+  for (int node = root_; node != -1;) {
+    if (nodes_[node].key < key) {
+      count += size(nodes_[node].left) + 1;
+      node = nodes_[node].right;
+    } else {
+      node = nodes_[node].left;
+    }
+  }
+  return count;
+}
+
+}  // namespace golf
@@ -0,0 +1,78 @@
+#ifndef CPP_CARDS_GOLF_LEADERBOARD_H
+#define CPP_CARDS_GOLF_LEADERBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace golf {
+
+using std::string;
+
+// Users ranked by a running total that is updated one user at a time. Totals live in a treap
+// ordered by (total, user id) in which every node counts its subtree, so an update, a rank query
+// and finding the n-th user are O(log n) however many users there are, and nothing is recomputed
+// from history.
+//
+// Not thread-safe. requires external synchronization
+class Leaderboard {
+ public:
+  enum class Order { LowestFirst, HighestFirst };
+
+  struct Standing {
+    string user_id;
+    int total;
+    int rank;
+    bool operator==(const Standing& o) const {
+      return user_id == o.user_id && total == o.total && rank == o.rank;
+    }
+  };
+
+  explicit Leaderboard(Order order = Order::LowestFirst) : order_(order) {}
+
+  // Adds `points` to the user's total, entering them at 0 first if they are new.
+  void add(const string& user_id, int points);
+
+  [[nodiscard]] size_t size() const { return index_.size(); }
+  [[nodiscard]] std::optional<int> total(const string& user_id) const;
+  // 1 plus the number of users ahead of this one; users with equal totals share a rank.
+  [[nodiscard]] std::optional<int> rank(const string& user_id) const;
+  // The first n users in order, ties broken by user id.
+  [[nodiscard]] std::vector<Standing> top(size_t n) const;
+
+ private:
+  struct Node {
+    string user_id;
+    // The total as ordered: negated for HighestFirst, so the tree is always ascending.
+    int key;
+    uint32_t priority;
+    int size = 1;
+    int left = -1;
+    int right = -1;
+  };
+
+  // Whether node a is ordered before node b.
+  [[nodiscard]] bool before(int a, int b) const;
+  [[nodiscard]] int size(int node) const { return node == -1 ? 0 : nodes_[node].size; }
+  void resize(int node);
+  // Splits the subtree at `tree` into the nodes ordered before `node` and the rest.
+  void split(int tree, int node, int& left, int& right);
+  // These return the root of the resulting subtree.
+  int merge(int left, int right);
+  int insert(int tree, int node);
+  int erase(int tree, int node);
+  // How many users are strictly ahead of `key`.
+  [[nodiscard]] int countBefore(int key) const;
+
+  Order order_;
+  std::vector<Node> nodes_;
+  std::unordered_map<string, int> index_;
+  int root_ = -1;
+};
+
+}  // namespace golf
+
+#endif
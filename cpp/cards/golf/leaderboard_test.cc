@@ -0,0 +1,91 @@
+#include "cpp/cards/golf/leaderboard.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace golf;
+using Standing = Leaderboard::Standing;
+
+TEST(Leaderboard, RanksLowestFirst) {
+  Leaderboard board;
+  board.add("alice", 12);
+  board.add("bob", 5);
+  board.add("carol", 12);
+  board.add("dave", 20);
+
+  EXPECT_EQ(board.size(), 4);
+  EXPECT_EQ(board.rank("bob"), 1);
+  EXPECT_EQ(board.rank("alice"), 2);
+  EXPECT_EQ(board.rank("carol"), 2);  // tied with alice
+  EXPECT_EQ(board.rank("dave"), 4);
+  EXPECT_EQ(board.rank("erin"), std::nullopt);
+  EXPECT_EQ(board.total("carol"), 12);
+
+  std::vector<Standing> expected{{"bob", 5, 1}, {"alice", 12, 2}, {"carol", 12, 2}};
+  EXPECT_EQ(board.top(3), expected);
+  EXPECT_EQ(board.top(10).size(), 4);
+}
+
+TEST(Leaderboard, AddMovesUser) {
+  Leaderboard board;
+  board.add("alice", 12);
+  board.add("bob", 5);
+  board.add("bob", 10);
+
+  EXPECT_EQ(board.size(), 2);
+  EXPECT_EQ(board.total("bob"), 15);
+  EXPECT_EQ(board.rank("alice"), 1);
+  EXPECT_EQ(board.rank("bob"), 2);
+}
+
+TEST(Leaderboard, HighestFirst) {
+  Leaderboard board{Leaderboard::Order::HighestFirst};
+  board.add("alice", 1);
+  board.add("bob", 0);
+  board.add("alice", 1);
+  board.add("bob", 3);
+
+  EXPECT_EQ(board.rank("bob"), 1);
+  EXPECT_EQ(board.total("alice"), 2);
+  std::vector<Standing> expected{{"bob", 3, 1}, {"alice", 2, 2}};
+  EXPECT_EQ(board.top(2), expected);
+}
+
+TEST(Leaderboard, MatchesSortedTotals) {
+  // Random updates checked against sorting every total after each one.
+  std::mt19937 g(3);
+  Leaderboard board;
+  std::map<std::string, int> totals;
+  for (int i = 0; i < 2000; i++) {
+    auto user = "user" + std::to_string(g() % 150);
+    int points = static_cast<int>(g() % 40);
+    board.add(user, points);
+    totals[user] += points;
+
+    ASSERT_EQ(board.size(), totals.size());
+    int lower = 0;
+    for (auto& [_, total] : totals) {
+      lower += total < totals[user] ? 1 : 0;
+    }
+    ASSERT_EQ(board.rank(user), lower + 1);
+  }
+
+  std::vector<std::pair<int, std::string>> sorted;
+  for (auto& [user, total] : totals) {
+    sorted.emplace_back(total, user);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  auto top = board.top(sorted.size());
+  ASSERT_EQ(top.size(), sorted.size());
+  for (size_t i = 0; i < sorted.size(); i++) {
+    EXPECT_EQ(top[i].user_id, sorted[i].second);
+    EXPECT_EQ(top[i].total, sorted[i].first);
+    EXPECT_EQ(top[i].rank, board.rank(top[i].user_id));
+  }
+}
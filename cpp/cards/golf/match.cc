@@ -0,0 +1,52 @@
+#include "cpp/cards/golf/match.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/leaderboard.h"
+
+namespace golf {
+
+absl::Status Match::recordHand(const GameState& hand, Leaderboard& hands_won) {
+  if (isOver()) {
+    return absl::FailedPreconditionError("match is over");
+  }
+  if (hand.getGameId() != getCurrentGameId()) {
+    return absl::InvalidArgumentError("not the current hand");
+  }
+  if (!hand.isOver()) {
+    return absl::FailedPreconditionError("hand is not over");
+  }
+
+  auto& players = hand.getPlayers();
+  if (user_ids_.empty()) {
+    for (auto& p : players) {
+      user_ids_.push_back(p.getName().value_or(""));
+    }
+  }
+
+  auto winners = hand.winners();
+  for (int i = 0; i < static_cast<int>(players.size()); i++) {
+    auto& name = players[i].getName();
+    if (!name.has_value()) {
+      continue;
+    }
+    standings_.add(*name, players[i].score());
+    hands_won.add(*name, winners.contains(i) ? 1 : 0);
+  }
+  holes_played_++;
+  return absl::OkStatus();
+}
+
+std::vector<string> Match::nextSeating() const {
+  std::vector<string> seating = user_ids_;
+  if (!seating.empty()) {
+    std::rotate(seating.begin(), seating.begin() + holes_played_ % seating.size(), seating.end());
+  }
+  return seating;
+}
+
+}  // namespace golf
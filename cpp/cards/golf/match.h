@@ -0,0 +1,62 @@
+#ifndef CPP_CARDS_GOLF_MATCH_H
+#define CPP_CARDS_GOLF_MATCH_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/leaderboard.h"
+
+namespace golf {
+
+using std::string;
+
+// A round of golf: `holes` hands played by the same users one after another. Each hand's scores
+// add to the players' totals, and the lowest total when the last hand ends wins. The standings
+// are kept as each hand is recorded, so reading them never goes back over earlier hands.
+class Match {
+ public:
+  static constexpr int kDefaultHoles = 9;
+
+  // A match whose first hand is the game `first_game_id`.
+  Match(string first_game_id, int holes)
+      : match_id_(first_game_id), holes_(holes), game_ids_{std::move(first_game_id)} {}
+
+  // The id of the first hand's game.
+  [[nodiscard]] const string& getMatchId() const { return match_id_; }
+  [[nodiscard]] int getHoles() const { return holes_; }
+  [[nodiscard]] int getHolesPlayed() const { return holes_played_; }
+  [[nodiscard]] bool isOver() const { return holes_played_ == holes_; }
+  // Every hand's game id so far, the one being played last.
+  [[nodiscard]] const std::vector<string>& getGameIds() const { return game_ids_; }
+  [[nodiscard]] const string& getCurrentGameId() const { return game_ids_.back(); }
+  // The players in their seats on the first hand; empty until it ends.
+  [[nodiscard]] const std::vector<string>& getUserIds() const { return user_ids_; }
+  // Cumulative scores, lowest first.
+  [[nodiscard]] const Leaderboard& getStandings() const { return standings_; }
+
+  // Adds the scores of `hand`, which must be the current hand and over, and counts its winners in
+  // `hands_won`. The first hand recorded fixes who plays the rest.
+  absl::Status recordHand(const GameState& hand, Leaderboard& hands_won);
+  // Makes `game_id` the current hand. The match must not be over.
+  void nextHand(string game_id) { game_ids_.push_back(std::move(game_id)); }
+  // The order the players sit in for the next hand: the first seat moves one place each hand so
+  // that a different player leads.
+  [[nodiscard]] std::vector<string> nextSeating() const;
+
+ private:
+  string match_id_;
+  int holes_;
+  int holes_played_ = 0;
+  std::vector<string> game_ids_;
+  std::vector<string> user_ids_;
+  Leaderboard standings_;
+};
+
+typedef std::shared_ptr<const Match> MatchPtr;
+
+}  // namespace golf
+
+#endif
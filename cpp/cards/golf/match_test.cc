@@ -0,0 +1,76 @@
+#include "cpp/cards/golf/match.h"
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/leaderboard.h"
+#include "cpp/cards/golf/player.h"
+
+using namespace cards;
+using namespace golf;
+
+namespace {
+// A finished hand in which Andy's pairs cancel out to 0 and Mercy holds four different ranks.
+GameState FinishedHand(const std::string& game_id, bool mercy_first) {
+  Player andy{"Andy", Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+              Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+  Player mercy{"Mercy", Card(Suit::Clubs, Rank::Four), Card(Suit::Diamonds, Rank::Five),
+               Card(Suit::Hearts, Rank::Six), Card(Suit::Spades, Rank::Seven)};
+  std::vector<Player> players = mercy_first ? std::vector{mercy, andy} : std::vector{andy, mercy};
+  return GameState{{}, {Card(Suit::Clubs, Rank::Ace)}, players, false, 0, -1, game_id, "v"};
+}
+}  // namespace
+
+TEST(Match, RecordsHandsUntilLastHole) {
+  Leaderboard hands_won{Leaderboard::Order::HighestFirst};
+  Match match{"game-1", 2};
+  EXPECT_EQ(match.getMatchId(), "game-1");
+  EXPECT_FALSE(match.isOver());
+
+  auto first = FinishedHand("game-1", false);
+  int mercy_score = first.getPlayer(1).score();
+  ASSERT_TRUE(match.recordHand(first, hands_won).ok());
+  EXPECT_EQ(match.getHolesPlayed(), 1);
+  EXPECT_EQ(match.getUserIds(), (std::vector<std::string>{"Andy", "Mercy"}));
+  // Mercy leads the second hand.
+  EXPECT_EQ(match.nextSeating(), (std::vector<std::string>{"Mercy", "Andy"}));
+
+  match.nextHand("game-2");
+  EXPECT_EQ(match.getCurrentGameId(), "game-2");
+  ASSERT_TRUE(match.recordHand(FinishedHand("game-2", true), hands_won).ok());
+  EXPECT_TRUE(match.isOver());
+  EXPECT_EQ(match.getGameIds(), (std::vector<std::string>{"game-1", "game-2"}));
+
+  EXPECT_EQ(match.getStandings().total("Andy"), 0);
+  EXPECT_EQ(match.getStandings().total("Mercy"), 2 * mercy_score);
+  EXPECT_EQ(match.getStandings().rank("Andy"), 1);
+  EXPECT_EQ(hands_won.total("Andy"), 2);
+  EXPECT_EQ(hands_won.total("Mercy"), 0);
+  EXPECT_EQ(hands_won.rank("Mercy"), 2);
+}
+
+TEST(Match, RejectsWrongHands) {
+  Leaderboard hands_won;
+  Match match{"game-1", 1};
+
+  auto status = match.recordHand(FinishedHand("game-2", false), hands_won);
+  EXPECT_EQ(status.message(), "not the current hand");
+
+  Player p1{"Andy", Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+            Card(Suit::Hearts, Rank::Two), Card(Suit::Spades, Rank::Two)};
+  Player p2{"Mercy", Card(Suit::Clubs, Rank::Three), Card(Suit::Diamonds, Rank::Three),
+            Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+  GameState in_play{{Card(Suit::Clubs, Rank::Ace)}, {}, {p1, p2}, false, 0, -1, "game-1", "v"};
+  status = match.recordHand(in_play, hands_won);
+  EXPECT_EQ(status.message(), "hand is not over");
+
+  ASSERT_TRUE(match.recordHand(FinishedHand("game-1", false), hands_won).ok());
+  status = match.recordHand(FinishedHand("game-1", false), hands_won);
+  EXPECT_EQ(status.message(), "match is over");
+  EXPECT_EQ(hands_won.size(), 2);
+}
@@ -38,38 +38,7 @@ absl::StatusOr<Player> Player::claimHand(const std::string& username) const {
 
 std::vector<Card> Player::allCards() const { return {topLeft, topRight, bottomLeft, bottomRight}; }
 
-int Player::cardValue(Card c) {
-  switch (c.getRank()) {
-    case cards::Rank::Ace:
-      return 1;
-    case cards::Rank::Two:
-      return 2;
-    case cards::Rank::Three:
-      return 3;
-    case cards::Rank::Four:
-      return 4;
-    case cards::Rank::Five:
-      return 5;
-    case cards::Rank::Six:
-      return 6;
-    case cards::Rank::Seven:
-      return 7;
-    case cards::Rank::Eight:
-      return 8;
-    case cards::Rank::Nine:
-      return 9;
-    case cards::Rank::Ten:
-      return 10;
-    case cards::Rank::Jack:
-      return 0;
-    case cards::Rank::Queen:
-      return 10;
-    case cards::Rank::King:
-      return 10;
-    default:
-      return -1;  // error
-  }
-}
+int Player::cardValue(Card c) { return Rules::kRankValues[static_cast<int>(c.getRank())]; }
 
 const Card& Player::cardAt(Position position) const {
   if (position == Position::TopLeft) {
@@ -7,14 +7,20 @@
 
 #include "absl/status/statusor.h"
 #include "cpp/cards/card.h"
+#include "cpp/cards/golf/rules.h"
 
 namespace golf {
 using namespace cards;
 
 enum class Position { TopLeft, TopRight, BottomLeft, BottomRight };
 
+// A seat in the served game, which plays FourCardRules only; see rules.h.
 class Player {
  public:
+  typedef FourCardRules Rules;
+  static constexpr int kHandSize = Rules::kHandSize;
+  static_assert(static_cast<int>(Position::BottomRight) + 1 == kHandSize);
+
   Player(std::optional<std::string> _name, Card tl, Card tr, Card bl, Card br)
       : name(std::move(_name)), topLeft(tl), topRight(tr), bottomLeft(bl), bottomRight(br) {}
   Player(Card tl, Card tr, Card bl, Card br)
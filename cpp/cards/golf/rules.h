@@ -0,0 +1,88 @@
+#ifndef CPP_CARDS_GOLF_RULES_H
+#define CPP_CARDS_GOLF_RULES_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace golf {
+
+// A golf variant as compile-time constants. The compact engine, the strategies and the simulator
+// are templates over one of these, so each variant compiles to its own engine with fixed-size
+// arrays and no branching on the rules in the hot path.
+//
+// The served game plays FourCardRules only: Player takes its hand size and card values from it
+// and GameManager deals by them, but Position, GameState, the protos, the mappers and the UIs
+// still name four cards. Serving the six and nine-card variants is a separate request.
+//
+//   kHandSize    cards per hand
+//   kRowSize     cards per row of the hand's layout; hands are dealt a row at a time
+//   kDecks       52-card decks in the shoe
+//   kMaxPlayers  seats at the table
+//   kRankValues  points for a card of each Rank, indexed by its enum value
+//   kKnockLimit  a player may knock only with a hand scoring at most this
+//
+// Ranks held an even number of times cancel out in every variant.
+inline constexpr int kNoKnockLimit = 255;
+
+struct FourCardRules {
+  static constexpr int kHandSize = 4;
+  static constexpr int kRowSize = 2;
+  static constexpr int kDecks = 1;
+  static constexpr int kMaxPlayers = 5;
+  static constexpr std::array<uint8_t, 13> kRankValues{2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 10, 10, 1};
+  static constexpr int kKnockLimit = kNoKnockLimit;
+};
+
+struct SixCardRules {
+  static constexpr int kHandSize = 6;
+  static constexpr int kRowSize = 3;
+  static constexpr int kDecks = 1;
+  static constexpr int kMaxPlayers = 6;
+  static constexpr std::array<uint8_t, 13> kRankValues = FourCardRules::kRankValues;
+  static constexpr int kKnockLimit = kNoKnockLimit;
+};
+
+struct NineCardRules {
+  static constexpr int kHandSize = 9;
+  static constexpr int kRowSize = 3;
+  static constexpr int kDecks = 2;
+  static constexpr int kMaxPlayers = 8;
+  static constexpr std::array<uint8_t, 13> kRankValues = FourCardRules::kRankValues;
+  static constexpr int kKnockLimit = kNoKnockLimit;
+};
+
+template <typename R>
+constexpr int deckSize() {
+  return 52 * R::kDecks;
+}
+
+// The worst possible hand: one card of each of the kHandSize most valuable ranks.
+template <typename R>
+constexpr int maxScore() {
+  auto values = R::kRankValues;
+  std::sort(values.begin(), values.end(), [](int a, int b) { return a > b; });
+  int score = 0;
+  for (int i = 0; i < std::min<int>(R::kHandSize, values.size()); i++) {
+    score += values[i];
+  }
+  return score;
+}
+
+// Sizes for per-variant tallies that are not themselves templates.
+inline constexpr int kMaxVariantPlayers = 8;
+inline constexpr int kMaxVariantScore = 75;  // every rank once
+
+template <typename R>
+concept GolfRules = R::kHandSize > 0 && R::kHandSize % R::kRowSize == 0 && R::kDecks >= 1 &&
+                    R::kMaxPlayers >= 2 && R::kMaxPlayers <= kMaxVariantPlayers &&
+                    // Every seat dealt and a discard turned, with cards indexed by a byte.
+                    R::kMaxPlayers * R::kHandSize < deckSize<R>() && deckSize<R>() <= 255 &&
+                    maxScore<R>() <= kMaxVariantScore;
+
+static_assert(GolfRules<FourCardRules> && GolfRules<SixCardRules> && GolfRules<NineCardRules>);
+static_assert(maxScore<FourCardRules>() == 39);  // 9 10 Q K
+
+}  // namespace golf
+
+#endif
@@ -0,0 +1,287 @@
+#include "cpp/cards/golf/simulator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+
+namespace golf {
+
+namespace detail {
+// A worker's share of game indices, [begin, end) packed into one word so the owner taking from
+// the front and thieves splitting off the back never need a lock. Not in the anonymous namespace
+// because the Simulate template's worker lambda captures it.
+class alignas(64) GameRange {
+ public:
+  void reset(uint32_t begin, uint32_t end) { packed_.store(pack(begin, end)); }
+
+  // The owner claims up to `chunk` games from the front.
+  bool take(uint32_t chunk, uint32_t& begin, uint32_t& end) {
+    uint64_t current = packed_.load();
+    for (;;) {
+      uint32_t b = current >> 32;
+      uint32_t e = static_cast<uint32_t>(current);
+      if (b >= e) {
+        return false;
+      }
+      uint32_t nb = std::min(e, b + chunk);
+      if (packed_.compare_exchange_weak(current, pack(nb, e))) {
+        begin = b;
+        end = nb;
+        return true;
+      }
+    }
+  }
+
+  // A thief claims the back half, if there is enough left to be worth moving.
+  bool steal(uint32_t min_games, uint32_t& begin, uint32_t& end) {
+    uint64_t current = packed_.load();
+    for (;;) {
+      uint32_t b = current >> 32;
+      uint32_t e = static_cast<uint32_t>(current);
+      if (b >= e || e - b < min_games) {
+        return false;
+      }
+      uint32_t mid = b + (e - b) / 2;
+      if (packed_.compare_exchange_weak(current, pack(b, mid))) {
+        begin = mid;
+        end = e;
+        return true;
+      }
+    }
+  }
+
+ private:
+  static uint64_t pack(uint32_t begin, uint32_t end) {
+    return (static_cast<uint64_t>(begin) << 32) | end;
+  }
+  std::atomic<uint64_t> packed_{0};
+};
+}  // namespace detail
+
+namespace {
+constexpr uint32_t kChunk = 256;
+
+uint64_t GameSeed(uint64_t seed, uint64_t game) {
+  return SimRng(seed ^ (game * 0xd1b54a32d192ed03ULL))();
+}
+
+template <typename R>
+void Record(const BasicCompactGame<R>& game, const GameResult& result,
+            const std::array<int, R::kMaxPlayers>& strategy_of_seat, SimulationStats& stats) {
+  stats.games++;
+  stats.moves += static_cast<uint64_t>(result.moves);
+  if (result.stalled) {
+    stats.stalled++;
+    return;
+  }
+  uint32_t winners = game.winners();
+  if (game.who_knocked >= 0 && game.whose_turn == game.who_knocked) {
+    stats.knocked++;
+    if (winners & (1u << game.who_knocked)) {
+      stats.knocker_won++;
+    }
+  }
+  for (int p = 0; p < game.players; p++) {
+    int score = game.score(p);
+    stats.scores[score]++;
+    if (winners & (1u << p)) {
+      stats.winning_scores[score]++;
+      stats.wins_by_seat[p]++;
+      stats.wins_by_strategy[strategy_of_seat[p]]++;
+    }
+  }
+}
+}  // namespace
+
+void SimulationStats::merge(const SimulationStats& other) {
+  games += other.games;
+  stalled += other.stalled;
+  moves += other.moves;
+  knocked += other.knocked;
+  knocker_won += other.knocker_won;
+  for (size_t i = 0; i < scores.size(); i++) {
+    scores[i] += other.scores[i];
+    winning_scores[i] += other.winning_scores[i];
+  }
+  for (size_t i = 0; i < wins_by_seat.size(); i++) {
+    wins_by_seat[i] += other.wins_by_seat[i];
+    wins_by_strategy[i] += other.wins_by_strategy[i];
+  }
+}
+
+double SimulationStats::meanScore() const {
+  uint64_t hands = 0;
+  uint64_t total = 0;
+  for (size_t s = 0; s < scores.size(); s++) {
+    hands += scores[s];
+    total += scores[s] * s;
+  }
+  return hands == 0 ? 0 : static_cast<double>(total) / static_cast<double>(hands);
+}
+
+int SimulationStats::scoreQuantile(double q) const {
+  uint64_t hands = 0;
+  for (auto n : scores) {
+    hands += n;
+  }
+  auto rank = static_cast<uint64_t>(q * static_cast<double>(hands));
+  uint64_t seen = 0;
+  for (size_t s = 0; s < scores.size(); s++) {
+    seen += scores[s];
+    if (seen > rank) {
+      return static_cast<int>(s);
+    }
+  }
+  return kMaxVariantScore;
+}
+
+template <typename R>
+GameResult PlayGame(BasicCompactGame<R>& game,
+                    const std::array<const BasicStrategy<R>*, R::kMaxPlayers>& seats, SimRng& rng,
+                    int max_moves) {
+  int moves = 0;
+  while (!game.isOver()) {
+    if (moves == max_moves || !game.apply(seats[game.whose_turn]->choose(game, rng))) {
+      return {moves, true};
+    }
+    moves++;
+  }
+  return {moves, false};
+}
+
+template <typename R>
+absl::StatusOr<SimulationStats> Simulate(const SimulatorConfig& config,
+                                         const std::vector<const BasicStrategy<R>*>& strategies) {
+  if (config.players < 2 || config.players > R::kMaxPlayers) {
+    return absl::InvalidArgumentError(absl::StrFormat("2 to %d players", R::kMaxPlayers));
+  }
+  if (static_cast<int>(strategies.size()) != config.players) {
+    return absl::InvalidArgumentError("need one strategy per player");
+  }
+  if (config.games > UINT32_MAX) {
+    return absl::InvalidArgumentError("too many games for one run");
+  }
+
+  unsigned threads = config.threads != 0 ? config.threads
+                                         : std::max(1u, std::thread::hardware_concurrency());
+  auto games = static_cast<uint32_t>(config.games);
+  std::vector<detail::GameRange> ranges(threads);
+  for (unsigned t = 0; t < threads; t++) {
+    ranges[t].reset(static_cast<uint32_t>(uint64_t{games} * t / threads),
+                    static_cast<uint32_t>(uint64_t{games} * (t + 1) / threads));
+  }
+  std::vector<SimulationStats> per_thread(threads);
+
+  auto worker = [&](unsigned self) {
+    SimulationStats& stats = per_thread[self];
+    auto play = [&](uint32_t begin, uint32_t end) {
+      for (uint32_t i = begin; i < end; i++) {
+        SimRng rng(GameSeed(config.seed, i));
+        std::array<const BasicStrategy<R>*, R::kMaxPlayers> seats{};
+        std::array<int, R::kMaxPlayers> strategy_of_seat{};
+        int rotation = config.rotate_seats ? static_cast<int>(i % config.players) : 0;
+        for (int p = 0; p < config.players; p++) {
+          strategy_of_seat[p] = (p + rotation) % config.players;
+          seats[p] = strategies[strategy_of_seat[p]];
+        }
+        auto game = BasicCompactGame<R>::deal(config.players, rng);
+        auto result = PlayGame(game, seats, rng, config.max_moves);
+        Record(game, result, strategy_of_seat, stats);
+      }
+    };
+
+    uint32_t begin;
+    uint32_t end;
+    for (;;) {
+      while (ranges[self].take(kChunk, begin, end)) {
+        play(begin, end);
+      }
+      bool stole = false;
+      for (unsigned v = 1; v < threads && !stole; v++) {
+        unsigned victim = (self + v) % threads;
+        if (ranges[victim].steal(2 * kChunk, begin, end)) {
+          ranges[self].reset(begin, end);
+          stole = true;
+        }
+      }
+      if (!stole) {
+        // Whatever is left elsewhere is less than two chunks; its owner will finish it.
+        return;
+      }
+    }
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; t++) {
+    pool.emplace_back(worker, t);
+  }
+  worker(0);
+  for (auto& thread : pool) {
+    thread.join();
+  }
+
+  SimulationStats total;
+  for (auto& stats : per_thread) {
+    total.merge(stats);
+  }
+  total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return total;
+}
+
+std::string FormatStats(const SimulationStats& stats, const std::vector<std::string>& strategies) {
+  auto pct = [&](uint64_t n, uint64_t of) {
+    return of == 0 ? 0.0 : 100.0 * static_cast<double>(n) / static_cast<double>(of);
+  };
+  uint64_t finished = stats.games - stats.stalled;
+  std::string out = absl::StrFormat(
+      "%d games in %.2fs (%.0f games/s, %.1f moves/game), %d stalled\n", stats.games,
+      stats.seconds, stats.gamesPerSecond(),
+      stats.games == 0 ? 0.0 : static_cast<double>(stats.moves) / static_cast<double>(stats.games),
+      stats.stalled);
+  absl::StrAppendFormat(&out, "knocked: %.1f%% of games, knocker won %.1f%% of those\n",
+                        pct(stats.knocked, finished), pct(stats.knocker_won, stats.knocked));
+  absl::StrAppendFormat(&out, "score: mean %.2f  p10 %d  p50 %d  p90 %d  p99 %d\n",
+                        stats.meanScore(), stats.scoreQuantile(0.10), stats.scoreQuantile(0.50),
+                        stats.scoreQuantile(0.90), stats.scoreQuantile(0.99));
+  for (size_t i = 0; i < strategies.size(); i++) {
+    absl::StrAppendFormat(&out, "seat %d: won %.1f%%   %s: won %.1f%%\n", i,
+                          pct(stats.wins_by_seat[i], finished), strategies[i],
+                          pct(stats.wins_by_strategy[i], finished));
+  }
+  out += "score distribution:\n";
+  uint64_t peak = *std::max_element(stats.scores.begin(), stats.scores.end());
+  for (size_t s = 0; s < stats.scores.size(); s++) {
+    if (stats.scores[s] == 0) {
+      continue;
+    }
+    int bar = peak == 0 ? 0 : static_cast<int>(50 * stats.scores[s] / peak);
+    absl::StrAppendFormat(&out, "%3d %10d %s\n", s, stats.scores[s], std::string(bar, '#'));
+  }
+  return out;
+}
+
+template GameResult PlayGame(BasicCompactGame<FourCardRules>&,
+                             const std::array<const BasicStrategy<FourCardRules>*, 5>&, SimRng&,
+                             int);
+template GameResult PlayGame(BasicCompactGame<SixCardRules>&,
+                             const std::array<const BasicStrategy<SixCardRules>*, 6>&, SimRng&,
+                             int);
+template GameResult PlayGame(BasicCompactGame<NineCardRules>&,
+                             const std::array<const BasicStrategy<NineCardRules>*, 8>&, SimRng&,
+                             int);
+template absl::StatusOr<SimulationStats> Simulate(
+    const SimulatorConfig&, const std::vector<const BasicStrategy<FourCardRules>*>&);
+template absl::StatusOr<SimulationStats> Simulate(
+    const SimulatorConfig&, const std::vector<const BasicStrategy<SixCardRules>*>&);
+template absl::StatusOr<SimulationStats> Simulate(
+    const SimulatorConfig&, const std::vector<const BasicStrategy<NineCardRules>*>&);
+
+}  // namespace golf
@@ -0,0 +1,81 @@
+#ifndef CPP_CARDS_GOLF_SIMULATOR_H
+#define CPP_CARDS_GOLF_SIMULATOR_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "cpp/cards/golf/compact_game.h"
+#include "cpp/cards/golf/rules.h"
+#include "cpp/cards/golf/strategy.h"
+
+namespace golf {
+
+struct SimulatorConfig {
+  // 2 to the variant's kMaxPlayers.
+  int players = 2;
+  uint64_t games = 1'000'000;
+  // 0 means std::thread::hardware_concurrency().
+  unsigned threads = 0;
+  uint64_t seed = 1;
+  // Games still going after this many moves are abandoned and counted as stalled; two players
+  // swapping with the discard pile never end a game on their own.
+  int max_moves = 1000;
+  // Rotate which strategy sits in which seat from game to game, so none always moves first.
+  bool rotate_seats = true;
+};
+
+struct SimulationStats {
+  uint64_t games = 0;
+  uint64_t stalled = 0;
+  uint64_t moves = 0;
+  // Games ending because someone knocked, rather than because the draw pile ran out.
+  uint64_t knocked = 0;
+  uint64_t knocker_won = 0;
+  // Final score of every hand, and of every winning hand. Sized for every variant.
+  std::array<uint64_t, kMaxVariantScore + 1> scores{};
+  std::array<uint64_t, kMaxVariantScore + 1> winning_scores{};
+  // Indexed by seat and by position in the strategy list; ties credit every winner.
+  std::array<uint64_t, kMaxVariantPlayers> wins_by_seat{};
+  std::array<uint64_t, kMaxVariantPlayers> wins_by_strategy{};
+  double seconds = 0;
+
+  void merge(const SimulationStats& other);
+  double gamesPerSecond() const { return seconds > 0 ? static_cast<double>(games) / seconds : 0; }
+  double meanScore() const;
+  // Smallest score at or above the q-quantile of all final scores.
+  int scoreQuantile(double q) const;
+};
+
+struct GameResult {
+  int moves;
+  // Hit max_moves, or a strategy chose a move the game rejected.
+  bool stalled;
+};
+
+// The simulator is defined, and instantiated for each preset variant, in simulator.cc.
+
+// Plays `game` to the end with seats[i] moving for seat i.
+template <typename R>
+GameResult PlayGame(BasicCompactGame<R>& game,
+                    const std::array<const BasicStrategy<R>*, R::kMaxPlayers>& seats, SimRng& rng,
+                    int max_moves);
+
+// Deals and plays config.games games of variant R, one strategy per seat, split across a
+// work-stealing pool. Game i is seeded from (config.seed, i), so the totals do not depend on the
+// thread count.
+template <typename R>
+absl::StatusOr<SimulationStats> Simulate(const SimulatorConfig& config,
+                                         const std::vector<const BasicStrategy<R>*>& strategies);
+inline absl::StatusOr<SimulationStats> Simulate(const SimulatorConfig& config,
+                                                const std::vector<const Strategy*>& strategies) {
+  return Simulate<FourCardRules>(config, strategies);
+}
+
+std::string FormatStats(const SimulationStats& stats, const std::vector<std::string>& strategies);
+
+}  // namespace golf
+
+#endif
@@ -0,0 +1,77 @@
+// Self-play for golf rule and strategy experiments, e.g.
+//   bazel run -c opt //cpp/cards/golf:simulator -- --games=10000000 --strategies=greedy5,random
+//   bazel run -c opt //cpp/cards/golf:simulator -- --variant=9 --players=6
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_split.h"
+#include "cpp/cards/golf/rules.h"
+#include "cpp/cards/golf/simulator.h"
+#include "cpp/cards/golf/strategy.h"
+
+ABSL_FLAG(int, variant, 4, "Cards per hand: 4, 6 or 9");
+ABSL_FLAG(int, players, 2, "Players per game, 2 to the variant's table size");
+ABSL_FLAG(uint64_t, games, 1'000'000, "Games to play");
+ABSL_FLAG(unsigned, threads, 0, "Worker threads, 0 for one per core");
+ABSL_FLAG(uint64_t, seed, 1, "Seed; the same seed and flags replay the same games");
+ABSL_FLAG(int, max_moves, 1000, "Moves after which a game is abandoned as stalled");
+ABSL_FLAG(std::string, strategies, "greedy",
+          "Comma-separated strategy per seat (random, greedy, greedy<N>); the last one fills any "
+          "remaining seats");
+ABSL_FLAG(bool, rotate_seats, true, "Rotate strategies through the seats between games");
+
+template <typename R>
+int run(const golf::SimulatorConfig& config) {
+  std::vector<std::unique_ptr<golf::BasicStrategy<R>>> owned;
+  for (auto name : absl::StrSplit(absl::GetFlag(FLAGS_strategies), ',')) {
+    auto strategy = golf::MakeStrategy<R>(std::string(name));
+    if (!strategy.ok()) {
+      std::cerr << strategy.status().message() << std::endl;
+      return 1;
+    }
+    owned.push_back(*std::move(strategy));
+  }
+  std::vector<const golf::BasicStrategy<R>*> strategies;
+  std::vector<std::string> names;
+  for (int p = 0; p < config.players; p++) {
+    strategies.push_back(owned[std::min<size_t>(p, owned.size() - 1)].get());
+    names.push_back(strategies.back()->name());
+  }
+
+  auto stats = golf::Simulate<R>(config, strategies);
+  if (!stats.ok()) {
+    std::cerr << stats.status().message() << std::endl;
+    return 1;
+  }
+  std::cout << golf::FormatStats(*stats, names);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+
+  golf::SimulatorConfig config{
+      .players = absl::GetFlag(FLAGS_players),
+      .games = absl::GetFlag(FLAGS_games),
+      .threads = absl::GetFlag(FLAGS_threads),
+      .seed = absl::GetFlag(FLAGS_seed),
+      .max_moves = absl::GetFlag(FLAGS_max_moves),
+      .rotate_seats = absl::GetFlag(FLAGS_rotate_seats),
+  };
+
+  switch (absl::GetFlag(FLAGS_variant)) {
+    case 4:
+      return run<golf::FourCardRules>(config);
+    case 6:
+      return run<golf::SixCardRules>(config);
+    case 9:
+      return run<golf::NineCardRules>(config);
+    default:
+      std::cerr << "--variant must be 4, 6 or 9" << std::endl;
+      return 1;
+  }
+}
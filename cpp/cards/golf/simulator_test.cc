@@ -0,0 +1,66 @@
+#include "cpp/cards/golf/simulator.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <vector>
+
+#include "cpp/cards/golf/strategy.h"
+
+using namespace golf;
+
+TEST(Simulator, ResultsDoNotDependOnThreads) {
+  GreedyStrategy greedy;
+  RandomStrategy random;
+  SimulatorConfig config{.players = 2, .games = 20000, .threads = 1, .seed = 7};
+
+  auto one = Simulate(config, {&greedy, &random});
+  ASSERT_TRUE(one.ok());
+  config.threads = 4;
+  auto four = Simulate(config, {&greedy, &random});
+  ASSERT_TRUE(four.ok());
+
+  EXPECT_EQ(one->games, 20000);
+  EXPECT_EQ(four->games, 20000);
+  EXPECT_EQ(one->moves, four->moves);
+  EXPECT_EQ(one->scores, four->scores);
+  EXPECT_EQ(one->wins_by_strategy, four->wins_by_strategy);
+  EXPECT_EQ(std::accumulate(one->scores.begin(), one->scores.end(), uint64_t{0}),
+            2 * (one->games - one->stalled));
+
+  // Greedy should comfortably beat random.
+  EXPECT_GT(one->wins_by_strategy[0], 2 * one->wins_by_strategy[1]);
+}
+
+TEST(Simulator, RejectsBadConfig) {
+  GreedyStrategy greedy;
+  std::vector<const Strategy*> six(6, &greedy);
+  EXPECT_FALSE(Simulate({.players = 6}, six).ok());
+  EXPECT_FALSE(Simulate({.players = 3}, {&greedy, &greedy}).ok());
+}
+
+TEST(Simulator, MakeStrategy) {
+  EXPECT_EQ((*MakeStrategy("greedy3"))->name(), "greedy3");
+  EXPECT_EQ((*MakeStrategy("random"))->name(), "random");
+  EXPECT_FALSE(MakeStrategy("clever").ok());
+}
+
+TEST(Simulator, PlaysEachVariant) {
+  BasicGreedyStrategy<SixCardRules> six;
+  auto six_stats = Simulate<SixCardRules>({.players = 6, .games = 2000, .threads = 1},
+                                          std::vector<const BasicStrategy<SixCardRules>*>(6, &six));
+  ASSERT_TRUE(six_stats.ok());
+  EXPECT_EQ(std::accumulate(six_stats->scores.begin(), six_stats->scores.end(), uint64_t{0}),
+            6 * (six_stats->games - six_stats->stalled));
+
+  BasicRandomStrategy<NineCardRules> nine;
+  auto nine_stats = Simulate<NineCardRules>(
+      {.players = 8, .games = 2000, .threads = 2},
+      std::vector<const BasicStrategy<NineCardRules>*>(8, &nine));
+  ASSERT_TRUE(nine_stats.ok());
+  EXPECT_EQ(nine_stats->games, 2000);
+  EXPECT_LT(nine_stats->stalled, nine_stats->games);
+  EXPECT_FALSE(Simulate<NineCardRules>({.players = 9},
+                                       std::vector<const BasicStrategy<NineCardRules>*>(9, &nine))
+                   .ok());
+}
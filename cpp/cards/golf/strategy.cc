@@ -0,0 +1,98 @@
+#include "cpp/cards/golf/strategy.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/match.h"
+#include "cpp/cards/golf/compact_game.h"
+#include "cpp/cards/golf/rules.h"
+
+namespace golf {
+
+template <typename R>
+BestSwap bestSwap(const std::array<CompactCard, R::kHandSize>& hand, CompactCard card) {
+  BestSwap best{-1, compactScore<R>(hand)};
+  for (int p = 0; p < R::kHandSize; p++) {
+    auto swapped = hand;
+    swapped[p] = card;
+    int score = compactScore<R>(swapped);
+    if (score < best.score) {
+      best = {p, score};
+    }
+  }
+  return best;
+}
+
+template <typename R>
+Action BasicRandomStrategy<R>::choose(const BasicCompactGame<R>& game, SimRng& rng) const {
+  auto position = static_cast<uint8_t>(rng.below(R::kHandSize));
+  if (game.peeked) {
+    return rng.below(2) == 0 ? Action{ActionType::SwapForDraw, position}
+                             : Action{ActionType::SwapDrawForDiscard};
+  }
+  uint32_t choices = game.canKnock() ? 4 : 3;
+  switch (rng.below(choices)) {
+    case 0:
+      return {ActionType::Peek};
+    case 1:
+      return {ActionType::SwapForDraw, position};
+    case 2:
+      return {ActionType::SwapForDiscard, position};
+    default:
+      return {ActionType::Knock};
+  }
+}
+
+template <typename R>
+Action BasicGreedyStrategy<R>::choose(const BasicCompactGame<R>& game, SimRng&) const {
+  auto& hand = game.hands[game.whose_turn];
+  if (game.peeked) {
+    auto swap = bestSwap<R>(hand, game.drawTop());
+    return swap.position < 0
+               ? Action{ActionType::SwapDrawForDiscard}
+               : Action{ActionType::SwapForDraw, static_cast<uint8_t>(swap.position)};
+  }
+  if (game.canKnock() && compactScore<R>(hand) <= knock_at_) {
+    return {ActionType::Knock};
+  }
+  auto swap = bestSwap<R>(hand, game.discardTop());
+  if (swap.position >= 0) {
+    return {ActionType::SwapForDiscard, static_cast<uint8_t>(swap.position)};
+  }
+  return {ActionType::Peek};
+}
+
+template <typename R>
+absl::StatusOr<std::unique_ptr<BasicStrategy<R>>> MakeStrategy(const std::string& name) {
+  if (name == "random") {
+    return std::make_unique<BasicRandomStrategy<R>>();
+  }
+  if (name == "greedy") {
+    return std::make_unique<BasicGreedyStrategy<R>>();
+  }
+  int knock_at;
+  if (absl::StartsWith(name, "greedy") && absl::SimpleAtoi(name.substr(6), &knock_at)) {
+    return std::make_unique<BasicGreedyStrategy<R>>(knock_at);
+  }
+  return absl::InvalidArgumentError("unknown strategy: " + name);
+}
+
+template class BasicRandomStrategy<FourCardRules>;
+template class BasicRandomStrategy<SixCardRules>;
+template class BasicRandomStrategy<NineCardRules>;
+template class BasicGreedyStrategy<FourCardRules>;
+template class BasicGreedyStrategy<SixCardRules>;
+template class BasicGreedyStrategy<NineCardRules>;
+template absl::StatusOr<std::unique_ptr<BasicStrategy<FourCardRules>>>
+MakeStrategy<FourCardRules>(const std::string& name);
+template absl::StatusOr<std::unique_ptr<BasicStrategy<SixCardRules>>> MakeStrategy<SixCardRules>(
+    const std::string& name);
+template absl::StatusOr<std::unique_ptr<BasicStrategy<NineCardRules>>>
+MakeStrategy<NineCardRules>(const std::string& name);
+template BestSwap bestSwap<FourCardRules>(const std::array<CompactCard, 4>& hand, CompactCard card);
+template BestSwap bestSwap<SixCardRules>(const std::array<CompactCard, 6>& hand, CompactCard card);
+template BestSwap bestSwap<NineCardRules>(const std::array<CompactCard, 9>& hand, CompactCard card);
+
+}  // namespace golf
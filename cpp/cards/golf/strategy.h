@@ -0,0 +1,90 @@
+#ifndef CPP_CARDS_GOLF_STRATEGY_H
+#define CPP_CARDS_GOLF_STRATEGY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "cpp/cards/golf/compact_game.h"
+
+namespace golf {
+
+// SplitMix64: tiny state and cheap to seed per game, unlike std::mt19937. Satisfies
+// UniformRandomBitGenerator.
+class SimRng {
+ public:
+  typedef uint64_t result_type;
+  explicit SimRng(uint64_t seed) : state_(seed) {}
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return UINT64_MAX; }
+  result_type operator()() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+  // Uniform in [0, n).
+  uint32_t below(uint32_t n) {
+    auto bits = static_cast<uint64_t>(static_cast<uint32_t>((*this)()));
+    return static_cast<uint32_t>((bits * n) >> 32);
+  }
+
+ private:
+  uint64_t state_;
+};
+
+// Picks the move for the player whose turn it is. Called again after a Peek, with the draw
+// pile's top card now visible. Must return a move the game accepts and be safe to call from
+// several threads at once.
+template <typename R>
+class BasicStrategy {
+ public:
+  virtual ~BasicStrategy() = default;
+  virtual Action choose(const BasicCompactGame<R>& game, SimRng& rng) const = 0;
+  virtual std::string name() const = 0;
+};
+
+// The strategies are defined, and instantiated for each preset variant, in strategy.cc.
+
+// A uniformly random legal move.
+template <typename R>
+class BasicRandomStrategy final : public BasicStrategy<R> {
+ public:
+  Action choose(const BasicCompactGame<R>& game, SimRng& rng) const override;
+  std::string name() const override { return "random"; }
+};
+
+// Takes the discard when it lowers its score, otherwise peeks and keeps the drawn card only if
+// that lowers its score. Knocks once its score is at most `knock_at`.
+template <typename R>
+class BasicGreedyStrategy final : public BasicStrategy<R> {
+ public:
+  explicit BasicGreedyStrategy(int knock_at = 5) : knock_at_(knock_at) {}
+  Action choose(const BasicCompactGame<R>& game, SimRng& rng) const override;
+  std::string name() const override { return "greedy" + std::to_string(knock_at_); }
+
+ private:
+  int knock_at_;
+};
+
+typedef BasicStrategy<FourCardRules> Strategy;
+typedef BasicRandomStrategy<FourCardRules> RandomStrategy;
+typedef BasicGreedyStrategy<FourCardRules> GreedyStrategy;
+
+// "random", "greedy" or "greedy<N>" for GreedyStrategy(N).
+template <typename R = FourCardRules>
+absl::StatusOr<std::unique_ptr<BasicStrategy<R>>> MakeStrategy(const std::string& name);
+
+// The lowest score and the position that reaches it by swapping `card` into `hand`, or position
+// -1 if no swap beats the current score.
+struct BestSwap {
+  int position;
+  int score;
+};
+template <typename R = FourCardRules>
+BestSwap bestSwap(const std::array<CompactCard, R::kHandSize>& hand, CompactCard card);
+
+}  // namespace golf
+
+#endif
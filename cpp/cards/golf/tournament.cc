@@ -0,0 +1,95 @@
+#include "cpp/cards/golf/tournament.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "cpp/cards/golf/game_state.h"
+
+namespace golf {
+
+Tournament::Tournament(std::vector<string> game_ids, int table_size)
+    : tournament_id_(game_ids.front()), table_size_(table_size) {
+  nextRound(std::move(game_ids));
+}
+
+std::vector<std::vector<string>> Tournament::seatTables(const std::vector<string>& entrants,
+                                                        int table_size) {
+  int n = static_cast<int>(entrants.size());
+  int tables = std::max(1, std::min((n + table_size - 1) / table_size, n / 2));
+  std::vector<std::vector<string>> seating(tables);
+  auto next = entrants.begin();
+  for (int t = 0; t < tables; t++) {
+    // The first n % tables tables take one more.
+    int seats = n / tables + (t < n % tables ? 1 : 0);
+    seating[t].assign(next, next + seats);
+    next += seats;
+  }
+  return seating;
+}
+
+absl::Status Tournament::recordTable(const GameState& table) {
+  if (isOver()) {
+    return absl::FailedPreconditionError("tournament is over");
+  }
+  auto it = table_by_game_id_.find(table.getGameId());
+  if (it == table_by_game_id_.end()) {
+    return absl::InvalidArgumentError("not a table of this round");
+  }
+  if (!table.isOver()) {
+    return absl::FailedPreconditionError("table is not over");
+  }
+  if (winners_[it->second].has_value()) {
+    return absl::FailedPreconditionError("table already recorded");
+  }
+
+  auto winners = table.winners();
+  auto& players = table.getPlayers();
+  string winner;
+  for (int i = 0; i < static_cast<int>(players.size()); i++) {
+    if (winners.contains(i) && players[i].getName().has_value()) {
+      winner = *players[i].getName();
+      break;
+    }
+  }
+  winners_[it->second] = std::move(winner);
+  tables_left_--;
+
+  if (isRoundOver()) {
+    auto entrants = nextEntrants();
+    if (game_ids_.size() == 1 || entrants.size() <= 1) {
+      over_ = true;
+      if (!entrants.empty()) {
+        champion_ = entrants.front();
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
+std::vector<string> Tournament::nextEntrants() const {
+  std::vector<string> entrants;
+  for (auto& winner : winners_) {
+    // An empty name is a table that sent no one through.
+    if (winner.has_value() && !winner->empty()) {
+      entrants.push_back(*winner);
+    }
+  }
+  return entrants;
+}
+
+void Tournament::nextRound(std::vector<string> game_ids) {
+  round_++;
+  game_ids_ = std::move(game_ids);
+  table_by_game_id_.clear();
+  table_by_game_id_.reserve(game_ids_.size());
+  for (int t = 0; t < static_cast<int>(game_ids_.size()); t++) {
+    table_by_game_id_.emplace(game_ids_[t], t);
+  }
+  winners_.assign(game_ids_.size(), std::nullopt);
+  tables_left_ = static_cast<int>(game_ids_.size());
+}
+
+}  // namespace golf
@@ -0,0 +1,77 @@
+#ifndef CPP_CARDS_GOLF_TOURNAMENT_H
+#define CPP_CARDS_GOLF_TOURNAMENT_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "cpp/cards/golf/game_state.h"
+
+namespace golf {
+
+using std::string;
+
+// A knockout event: every round seats the remaining entrants at tables, one hand each, and each
+// table's winner goes through to the next. The next round is seated once the last table of the
+// current one ends, and the tournament is over when a round is played at a single table or leaves
+// a single player standing.
+class Tournament {
+ public:
+  // A tournament whose first round is being played at `game_ids`, in the order
+  // seatTables(entrants, table_size) seated them.
+  Tournament(std::vector<string> game_ids, int table_size);
+
+  // Splits `entrants` into tables of at most `table_size` players, in order, as evenly as possible,
+  // e.g. 10 players at tables of 4 sit 4, 3 and 3. No one sits alone: with tables of two, an odd
+  // number of entrants puts three at the first table.
+  [[nodiscard]] static std::vector<std::vector<string>> seatTables(
+      const std::vector<string>& entrants, int table_size);
+
+  // The id of the first round's first table.
+  [[nodiscard]] const string& getTournamentId() const { return tournament_id_; }
+  [[nodiscard]] int getTableSize() const { return table_size_; }
+  // 1 for the first round.
+  [[nodiscard]] int getRound() const { return round_; }
+  // The current round's tables, in seating order.
+  [[nodiscard]] const std::vector<string>& getGameIds() const { return game_ids_; }
+  [[nodiscard]] bool hasTable(const string& game_id) const {
+    return table_by_game_id_.contains(game_id);
+  }
+  [[nodiscard]] int getTablesLeft() const { return tables_left_; }
+  [[nodiscard]] bool isRoundOver() const { return tables_left_ == 0; }
+  [[nodiscard]] bool isOver() const { return over_; }
+  // The last player standing once the tournament is over. Empty if every final table's winner
+  // had left their seat.
+  [[nodiscard]] const std::optional<string>& getChampion() const { return champion_; }
+
+  // Records the winner of `table`, which must be a table of the current round and over. A tie
+  // goes to the tied player in the lowest seat, and a table whose winners have all left sends no one
+  // through.
+  absl::Status recordTable(const GameState& table);
+  // Who goes through from the finished round, table by table: the next round's entrants.
+  [[nodiscard]] std::vector<string> nextEntrants() const;
+  // Starts the next round at `game_ids`, seated as seatTables(nextEntrants(), getTableSize()).
+  // The round must be over and the tournament not.
+  void nextRound(std::vector<string> game_ids);
+
+ private:
+  string tournament_id_;
+  int table_size_;
+  int round_ = 0;
+  std::vector<string> game_ids_;
+  std::unordered_map<string, int> table_by_game_id_;
+  // Each table's winner once it has ended, by table index.
+  std::vector<std::optional<string>> winners_;
+  int tables_left_;
+  bool over_ = false;
+  std::optional<string> champion_;
+};
+
+typedef std::shared_ptr<const Tournament> TournamentPtr;
+
+}  // namespace golf
+
+#endif
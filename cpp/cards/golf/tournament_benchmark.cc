@@ -0,0 +1,33 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "cpp/cards/golf/game_manager.h"
+#include "cpp/cards/golf/in_memory_game_store.h"
+
+using namespace golf;
+
+// Starting a tournament's first round: every table dealt and stored, state.range(0) tables of 4.
+static void BM_NewTournament(benchmark::State& state) {
+  std::vector<std::string> entrants;
+  for (int i = 0; i < state.range(0) * 4; i++) {
+    entrants.push_back("entrant" + std::to_string(i));
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto store = std::make_shared<InMemoryGameStore>();
+    for (auto& user_id : entrants) {
+      (void)store->AddUser(user_id);
+    }
+    GameManager gm{store};
+    state.ResumeTiming();
+    auto tournament = gm.newTournament(entrants, 4);
+    benchmark::DoNotOptimize(tournament);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_NewTournament)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,71 @@
+#include "cpp/cards/golf/tournament.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/player.h"
+
+using namespace cards;
+using namespace golf;
+
+namespace {
+using Seating = std::vector<std::vector<std::string>>;
+
+// A finished table at which `winner` pairs twos and threes for 0 and `loser` holds four ranks.
+GameState FinishedTable(const std::string& game_id, const std::string& winner,
+                        const std::string& loser) {
+  Player w{winner, Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+           Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+  Player l{loser, Card(Suit::Clubs, Rank::Four), Card(Suit::Diamonds, Rank::Five),
+           Card(Suit::Hearts, Rank::Six), Card(Suit::Spades, Rank::Seven)};
+  return GameState{{}, {Card(Suit::Clubs, Rank::Ace)}, {l, w}, false, 0, 0, game_id, "v"};
+}
+}  // namespace
+
+TEST(Tournament, SeatsTablesEvenly) {
+  std::vector<std::string> ten{"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+  EXPECT_EQ(Tournament::seatTables(ten, 4),
+            (Seating{{"a", "b", "c", "d"}, {"e", "f", "g"}, {"h", "i", "j"}}));
+  EXPECT_EQ(Tournament::seatTables({"a", "b", "c"}, 2), (Seating{{"a", "b", "c"}}));
+  EXPECT_EQ(Tournament::seatTables({"a", "b", "c", "d", "e"}, 2),
+            (Seating{{"a", "b", "c"}, {"d", "e"}}));
+  EXPECT_EQ(Tournament::seatTables({"a", "b"}, 12), (Seating{{"a", "b"}}));
+}
+
+TEST(Tournament, WinnersGoThroughUntilOneTable) {
+  Tournament tournament{{"t1", "t2"}, 2};
+  EXPECT_EQ(tournament.getTournamentId(), "t1");
+  EXPECT_EQ(tournament.getRound(), 1);
+  EXPECT_EQ(tournament.getTablesLeft(), 2);
+
+  EXPECT_FALSE(tournament.recordTable(FinishedTable("other", "a", "b")).ok());
+  ASSERT_TRUE(tournament.recordTable(FinishedTable("t2", "c", "d")).ok());
+  EXPECT_FALSE(tournament.recordTable(FinishedTable("t2", "c", "d")).ok());
+  EXPECT_FALSE(tournament.isRoundOver());
+  ASSERT_TRUE(tournament.recordTable(FinishedTable("t1", "a", "b")).ok());
+  EXPECT_TRUE(tournament.isRoundOver());
+  EXPECT_FALSE(tournament.isOver());
+  // In table order, not the order the tables ended.
+  EXPECT_EQ(tournament.nextEntrants(), (std::vector<std::string>{"a", "c"}));
+
+  tournament.nextRound({"final"});
+  EXPECT_EQ(tournament.getRound(), 2);
+  EXPECT_FALSE(tournament.hasTable("t1"));
+  ASSERT_TRUE(tournament.recordTable(FinishedTable("final", "c", "a")).ok());
+  EXPECT_TRUE(tournament.isOver());
+  EXPECT_EQ(tournament.getChampion(), "c");
+  EXPECT_FALSE(tournament.recordTable(FinishedTable("final", "c", "a")).ok());
+}
+
+TEST(Tournament, UnfinishedTableIsNotRecorded) {
+  Tournament tournament{{"t1"}, 2};
+  auto finished = FinishedTable("t1", "a", "b");
+  GameState playing{{Card(Suit::Clubs, Rank::Ace)}, finished.getDiscardPile(),
+                    finished.getPlayers(), false, 0, -1, "t1", "v"};
+  EXPECT_FALSE(tournament.recordTable(playing).ok());
+  EXPECT_EQ(tournament.getTablesLeft(), 1);
+}
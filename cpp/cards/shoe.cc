@@ -0,0 +1,33 @@
+#include "cpp/cards/shoe.h"
+
+#include <cassert>
+#include <deque>
+
+#include "cpp/cards/card.h"
+
+namespace cards {
+
+Shoe::Shoe(int decks) : decks_(decks), cards_(decks * kDeckSize) {
+  assert(decks >= 1 && decks <= kMaxDecks);
+  for (size_t i = 0; i < cards_.size(); i++) {
+    cards_[i] = static_cast<uint8_t>(i);
+  }
+  counts_.fill(static_cast<uint8_t>(decks));
+}
+
+Card Shoe::deal() {
+  Card card{cards_.back() % kDeckSize};
+  cards_.pop_back();
+  counts_[card.shuffleIndex()]--;
+  return card;
+}
+
+std::deque<Card> Shoe::remaining() const {
+  std::deque<Card> pile;
+  for (auto c : cards_) {
+    pile.emplace_back(c % kDeckSize);
+  }
+  return pile;
+}
+
+}  // namespace cards
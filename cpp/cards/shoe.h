@@ -0,0 +1,66 @@
+#ifndef CPP_CARDS_SHOE_H
+#define CPP_CARDS_SHOE_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "cpp/cards/card.h"
+
+namespace cards {
+
+// One to kMaxDecks 52-card decks shuffled together. Each card is held as one byte, its shuffle
+// index plus 52 times the deck it came from, so a shoe of K decks is 52K bytes and the copies of a
+// card stay distinct until they are dealt. count() tracks how many copies of each card are left.
+class Shoe {
+ public:
+  static constexpr int kDeckSize = 52;
+  // The most decks whose cards still fit in a byte each.
+  static constexpr int kMaxDecks = 4;
+
+  // A shoe in deck order; shuffle() it before dealing.
+  explicit Shoe(int decks);
+
+  [[nodiscard]] int decks() const { return decks_; }
+  [[nodiscard]] size_t size() const { return cards_.size(); }
+  [[nodiscard]] bool empty() const { return cards_.empty(); }
+  // Copies of `card` not yet dealt, 0 to decks().
+  [[nodiscard]] int count(const Card& card) const { return counts_[card.shuffleIndex()]; }
+
+  // Fisher-Yates over the bytes, with Lemire's multiply-shift bound in place of
+  // std::uniform_int_distribution. `g` must produce at least 32 random low bits per call.
+  template <typename URBG>
+  void shuffle(URBG& g);
+
+  // Removes and returns the top card. The shoe must not be empty.
+  Card deal();
+  // The cards not yet dealt, bottom first, the way GameState keeps its draw pile.
+  [[nodiscard]] std::deque<Card> remaining() const;
+
+ private:
+  int decks_;
+  // Top of the shoe last.
+  std::vector<uint8_t> cards_;
+  std::array<uint8_t, kDeckSize> counts_;
+};
+
+template <typename URBG>
+void Shoe::shuffle(URBG& g) {
+  for (auto i = static_cast<uint32_t>(cards_.size()); i > 1; i--) {
+    // A uniform index in [0, i), rejecting the few products that would bias it.
+    uint64_t m = uint64_t{static_cast<uint32_t>(g())} * i;
+    if (static_cast<uint32_t>(m) < i) {
+      uint32_t threshold = -i % i;
+      while (static_cast<uint32_t>(m) < threshold) {
+        m = uint64_t{static_cast<uint32_t>(g())} * i;
+      }
+    }
+    std::swap(cards_[i - 1], cards_[m >> 32]);
+  }
+}
+
+}  // namespace cards
+
+#endif
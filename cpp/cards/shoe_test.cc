@@ -0,0 +1,56 @@
+#include "cpp/cards/shoe.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <utility>
+
+#include "cpp/cards/card.h"
+
+using namespace cards;
+
+TEST(Shoe, ShuffleIndexInvertsCardInt) {
+  for (int i = 0; i < Shoe::kDeckSize; i++) {
+    EXPECT_EQ(Card{i}.shuffleIndex(), i);
+  }
+  EXPECT_EQ(sizeof(Card), 2);
+}
+
+TEST(Shoe, HoldsEachCardOncePerDeck) {
+  std::mt19937 g(7);
+  Shoe shoe(3);
+  shoe.shuffle(g);
+  EXPECT_EQ(shoe.size(), 156);
+  Card ace_of_spades{Suit::Spades, Rank::Ace};
+  EXPECT_EQ(shoe.count(ace_of_spades), 3);
+
+  std::map<std::pair<Suit, Rank>, int> dealt;
+  for (int i = 0; i < 100; i++) {
+    Card card = shoe.deal();
+    dealt[{card.getSuit(), card.getRank()}]++;
+  }
+  EXPECT_EQ(shoe.size(), 56);
+  auto ace_of_spades_dealt = dealt[{Suit::Spades, Rank::Ace}];
+  EXPECT_EQ(shoe.count(ace_of_spades), 3 - ace_of_spades_dealt);
+
+  for (auto& card : shoe.remaining()) {
+    dealt[{card.getSuit(), card.getRank()}]++;
+  }
+  EXPECT_EQ(dealt.size(), 52);
+  for (auto& [card, n] : dealt) {
+    EXPECT_EQ(n, 3);
+  }
+}
+
+TEST(Shoe, ShuffleMovesEveryPosition) {
+  // Over many shuffles, the top card should be each of the 52 cards at some point.
+  std::mt19937 g(1);
+  std::map<int, int> tops;
+  for (int i = 0; i < 2000; i++) {
+    Shoe shoe(1);
+    shoe.shuffle(g);
+    tops[shoe.deal().shuffleIndex()]++;
+  }
+  EXPECT_EQ(tops.size(), 52);
+}
@@ -0,0 +1,86 @@
+#include "cpp/example_service/async_greeter_server.h"
+
+#include "cpp/example_service/example_service.h"
+
+using example_service::HelloReply;
+using example_service::HelloRequest;
+using grpc::ServerCompletionQueue;
+
+class AsyncGreeterServer::CallData {
+ public:
+  CallData(example_service::Greeter::AsyncService* service, ServerCompletionQueue* cq)
+      : service_(service), cq_(cq), responder_(&context_) {
+    service_->RequestSayHello(&context_, &request_, &responder_, cq_, cq_, this);
+  }
+
+  // Called with each event this call's tag completes with. `ok` is false once the server is
+  // shutting down and the pending request will never match an incoming call.
+  void Proceed(bool ok) {
+    if (!ok || finished_) {
+      delete this;
+      return;
+    }
+    new CallData(service_, cq_);
+    Greet(request_, &reply_);
+    finished_ = true;
+    responder_.Finish(reply_, grpc::Status::OK, this);
+  }
+
+ private:
+  example_service::Greeter::AsyncService* service_;
+  ServerCompletionQueue* cq_;
+  grpc::ServerContext context_;
+  HelloRequest request_;
+  HelloReply reply_;
+  grpc::ServerAsyncResponseWriter<HelloReply> responder_;
+  bool finished_ = false;
+};
+
+AsyncGreeterServer::AsyncGreeterServer(grpc::ServerBuilder& builder, int num_cqs) {
+  builder.RegisterService(&service_);
+  for (int i = 0; i < num_cqs; i++) {
+    cqs_.push_back(builder.AddCompletionQueue());
+  }
+}
+
+AsyncGreeterServer::~AsyncGreeterServer() { Shutdown(nullptr); }
+
+void AsyncGreeterServer::Start() {
+  for (auto& cq : cqs_) {
+    new CallData(&service_, cq.get());
+    pollers_.emplace_back(&AsyncGreeterServer::Poll, this, cq.get());
+  }
+}
+
+void AsyncGreeterServer::Shutdown(grpc::Server* server) {
+  if (shut_down_) {
+    return;
+  }
+  shut_down_ = true;
+  if (server != nullptr) {
+    server->Shutdown();
+  }
+  // Queues must be shut down after the server; the pollers drain them and exit.
+  for (auto& cq : cqs_) {
+    cq->Shutdown();
+  }
+  for (auto& poller : pollers_) {
+    poller.join();
+  }
+  if (pollers_.empty()) {
+    void* tag;
+    bool ok;
+    for (auto& cq : cqs_) {
+      while (cq->Next(&tag, &ok)) {
+      }
+    }
+  }
+}
+
+void AsyncGreeterServer::Poll(ServerCompletionQueue* cq) {
+  void* tag;
+  bool ok;
+  while (cq->Next(&tag, &ok)) {
+    static_cast<CallData*>(tag)->Proceed(ok);
+  }
+}
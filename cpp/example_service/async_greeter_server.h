@@ -0,0 +1,38 @@
+#ifndef CPP_EXAMPLE_SERVICE_ASYNC_GREETER_SERVER_H
+#define CPP_EXAMPLE_SERVICE_ASYNC_GREETER_SERVER_H
+
+#include <grpcpp/grpcpp.h>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "protos/example_service/helloworld.grpc.pb.h"
+
+// Greeter on the completion-queue API with one polling thread per completion queue. Each queue
+// keeps a single SayHello request armed; a finished call re-arms it on the same queue.
+class AsyncGreeterServer {
+ public:
+  // Registers the service and one completion queue per polling thread on `builder`. Call Start()
+  // with the server built from it.
+  AsyncGreeterServer(grpc::ServerBuilder& builder, int num_cqs);
+  ~AsyncGreeterServer();
+  AsyncGreeterServer(const AsyncGreeterServer&) = delete;
+  AsyncGreeterServer& operator=(const AsyncGreeterServer&) = delete;
+
+  void Start();
+  // Shuts the server down (if Start was called) and drains every queue. Idempotent.
+  void Shutdown(grpc::Server* server);
+
+ private:
+  class CallData;
+  void Poll(grpc::ServerCompletionQueue* cq);
+
+  example_service::Greeter::AsyncService service_;
+  std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> cqs_;
+  std::vector<std::thread> pollers_;
+  bool shut_down_ = false;
+};
+
+#endif
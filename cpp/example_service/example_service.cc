@@ -8,12 +8,27 @@
 
 using example_service::HelloReply;
 using example_service::HelloRequest;
+using grpc::CallbackServerContext;
 using grpc::ServerContext;
+using grpc::ServerUnaryReactor;
 using grpc::Status;
 
+void Greet(const HelloRequest& request, HelloReply* reply) {
+  std::string prefix("Hello ");
+  reply->set_message(prefix + request.name());
+}
+
 Status GreeterServiceImpl::SayHello(ServerContext* context, const HelloRequest* request,
                                     HelloReply* reply) {
-  std::string prefix("Hello ");
-  reply->set_message(prefix + request->name());
+  Greet(*request, reply);
   return Status::OK;
 };
+
+ServerUnaryReactor* CallbackGreeterServiceImpl::SayHello(CallbackServerContext* context,
+                                                         const HelloRequest* request,
+                                                         HelloReply* reply) {
+  Greet(*request, reply);
+  auto* reactor = context->DefaultReactor();
+  reactor->Finish(Status::OK);
+  return reactor;
+}
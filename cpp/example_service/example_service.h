@@ -3,9 +3,20 @@
 
 #include "protos/example_service/helloworld.grpc.pb.h"
 
+// Shared by every Greeter implementation so they all do identical work per call.
+void Greet(const example_service::HelloRequest& request, example_service::HelloReply* reply);
+
 class GreeterServiceImpl final : public example_service::Greeter::Service {
   grpc::Status SayHello(grpc::ServerContext* context, const example_service::HelloRequest* request,
                         example_service::HelloReply* reply) override;
 };
 
+// The same Greeter on the callback API: handlers run on gRPC's own event engine threads instead
+// of the sync server's thread pool.
+class CallbackGreeterServiceImpl final : public example_service::Greeter::CallbackService {
+  grpc::ServerUnaryReactor* SayHello(grpc::CallbackServerContext* context,
+                                     const example_service::HelloRequest* request,
+                                     example_service::HelloReply* reply) override;
+};
+
 #endif
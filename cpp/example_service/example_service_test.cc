@@ -6,6 +6,9 @@
 #include <grpcpp/server_builder.h>
 #include <gtest/gtest.h>
 
+#include <memory>
+
+#include "cpp/example_service/async_greeter_server.h"
 #include "protos/example_service/helloworld.grpc.pb.h"
 
 using example_service::Greeter;
@@ -40,3 +43,38 @@ TEST(SERVICE_TEST, BasicAssertions) {
 
   server->Shutdown();
 }
+
+static void ExpectGreets(const std::shared_ptr<grpc::Channel>& channel) {
+  auto stub = Greeter::NewStub(channel);
+  for (auto name : {"First", "Second"}) {
+    ClientContext context;
+    HelloRequest req;
+    req.set_name(name);
+    HelloReply res;
+    ASSERT_TRUE(stub->SayHello(&context, req, &res).ok());
+    EXPECT_EQ(res.message(), std::string("Hello ") + name);
+  }
+}
+
+TEST(SERVICE_TEST, CallbackServer) {
+  CallbackGreeterServiceImpl service;
+
+  ServerBuilder builder;
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+
+  ExpectGreets(server->InProcessChannel({}));
+
+  server->Shutdown();
+}
+
+TEST(SERVICE_TEST, AsyncServer) {
+  ServerBuilder builder;
+  AsyncGreeterServer async{builder, 2};
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+  async.Start();
+
+  ExpectGreets(server->InProcessChannel({}));
+
+  async.Shutdown(server.get());
+}
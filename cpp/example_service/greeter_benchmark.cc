@@ -0,0 +1,157 @@
+// Closed-loop SayHello throughput and latency for the three server threading models: the sync
+// server's thread pool, the callback API, and a completion-queue server with one poller per queue.
+// Each of `concurrency` client threads keeps exactly one call outstanding, over either a loopback
+// TCP connection or an in-process channel (no sockets, same serialization).
+//
+//   bazel run -c opt //cpp/example_service:greeter_benchmark -- \
+//       --benchmark_filter='server:2/transport:0/concurrency:64'
+#include <benchmark/benchmark.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+#include "cpp/example_service/async_greeter_server.h"
+#include "cpp/example_service/example_service.h"
+#include "protos/example_service/helloworld.grpc.pb.h"
+
+using example_service::Greeter;
+using example_service::HelloReply;
+using example_service::HelloRequest;
+using grpc::ClientContext;
+using grpc::Server;
+using grpc::ServerBuilder;
+
+namespace {
+enum ServerKind { kSync, kCallback, kAsync };
+enum Transport { kLoopback, kInProcess };
+
+constexpr int kCallsPerClient = 100;
+
+struct Greeters {
+  std::unique_ptr<GreeterServiceImpl> sync;
+  std::unique_ptr<CallbackGreeterServiceImpl> callback;
+  std::unique_ptr<AsyncGreeterServer> async;
+  std::unique_ptr<Server> server;
+  std::unique_ptr<Greeter::Stub> stub;
+
+  Greeters(ServerKind kind, Transport transport) {
+    ServerBuilder builder;
+    int port = 0;
+    if (transport == kLoopback) {
+      builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    }
+    switch (kind) {
+      case kSync:
+        sync = std::make_unique<GreeterServiceImpl>();
+        builder.RegisterService(sync.get());
+        break;
+      case kCallback:
+        callback = std::make_unique<CallbackGreeterServiceImpl>();
+        builder.RegisterService(callback.get());
+        break;
+      case kAsync:
+        async = std::make_unique<AsyncGreeterServer>(
+            builder, std::max(1u, std::thread::hardware_concurrency()));
+        break;
+    }
+    server = builder.BuildAndStart();
+    if (async) {
+      async->Start();
+    }
+
+    auto channel = transport == kLoopback
+                       ? grpc::CreateChannel(absl::StrFormat("127.0.0.1:%d", port),
+                                             grpc::InsecureChannelCredentials())
+                       : server->InProcessChannel({});
+    stub = Greeter::NewStub(channel);
+  }
+
+  ~Greeters() {
+    if (async) {
+      async->Shutdown(server.get());
+    } else {
+      server->Shutdown();
+    }
+  }
+};
+
+// Issues `calls` back-to-back SayHello calls, appending each latency in nanoseconds.
+void RunClient(Greeter::Stub* stub, int calls, std::vector<int64_t>* latencies, bool* failed) {
+  HelloRequest req;
+  req.set_name("Friend");
+  HelloReply res;
+  for (int i = 0; i < calls; i++) {
+    ClientContext context;
+    auto start = std::chrono::steady_clock::now();
+    auto status = stub->SayHello(&context, req, &res);
+    latencies->push_back((std::chrono::steady_clock::now() - start).count());
+    if (!status.ok()) {
+      *failed = true;
+    }
+  }
+}
+
+double PercentileMicros(std::vector<int64_t>& sorted, double q) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  auto index = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1));
+  return static_cast<double>(sorted[index]) / 1000.0;
+}
+}  // namespace
+
+static void BM_SayHello(benchmark::State& state) {
+  auto kind = static_cast<ServerKind>(state.range(0));
+  auto transport = static_cast<Transport>(state.range(1));
+  auto concurrency = static_cast<int>(state.range(2));
+  Greeters greeters{kind, transport};
+
+  std::vector<std::vector<int64_t>> latencies(concurrency);
+  // std::vector<bool> packs bits, so concurrent writes to neighbours would race.
+  std::unique_ptr<bool[]> failed(new bool[concurrency]());
+  for (auto _ : state) {
+    std::vector<std::thread> clients;
+    clients.reserve(concurrency);
+    for (int c = 0; c < concurrency; c++) {
+      clients.emplace_back(RunClient, greeters.stub.get(), kCallsPerClient, &latencies[c],
+                           &failed[c]);
+    }
+    for (auto& client : clients) {
+      client.join();
+    }
+  }
+  if (std::any_of(failed.get(), failed.get() + concurrency, [](bool f) { return f; })) {
+    state.SkipWithError("SayHello failed");
+    return;
+  }
+
+  std::vector<int64_t> all;
+  for (auto& l : latencies) {
+    all.insert(all.end(), l.begin(), l.end());
+  }
+  std::sort(all.begin(), all.end());
+  state.SetItemsProcessed(static_cast<int64_t>(all.size()));
+  state.counters["qps"] =
+      benchmark::Counter(static_cast<double>(all.size()), benchmark::Counter::kIsRate);
+  state.counters["p50_us"] = PercentileMicros(all, 0.50);
+  state.counters["p90_us"] = PercentileMicros(all, 0.90);
+  state.counters["p99_us"] = PercentileMicros(all, 0.99);
+  state.counters["p999_us"] = PercentileMicros(all, 0.999);
+}
+BENCHMARK(BM_SayHello)
+    ->ArgsProduct({{kSync, kCallback, kAsync}, {kLoopback, kInProcess}, {1, 8, 64}})
+    ->ArgNames({"server", "transport", "concurrency"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -2,9 +2,14 @@
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/health_check_service_interface.h>
 
+#include <chrono>
 #include <cstdlib>
 
+#include "absl/flags/parse.h"
 #include "cpp/example_service/example_service.h"
+#include "cpp/grpc_instrumentation/interceptors.h"
+#include "cpp/grpc_instrumentation/log_exporter.h"
+#include "cpp/server_bootstrap/server_bootstrap.h"
 
 using grpc::Server;
 using grpc::ServerBuilder;
@@ -17,9 +22,12 @@ void RunServer(uint16_t port) {
   grpc::reflection::InitProtoReflectionServerBuilderPlugin();
 
   ServerBuilder builder;
+  server_bootstrap::ConfigureServer(builder);
   builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());  // no auth
   builder.RegisterService(&service);
+  builder.experimental().SetInterceptorCreators(grpc_instrumentation::ServerInterceptors());
   std::unique_ptr<Server> server(builder.BuildAndStart());
+  grpc_instrumentation::LogExporter exporter{std::chrono::seconds(60)};
 
   std::cout << "Server listening on " << server_address << std::endl;
   server->Wait();
@@ -32,7 +40,8 @@ uint16_t ReadPort(uint16_t default_port) {
   return default_port;
 }
 
-int main() {
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
   RunServer(ReadPort(8080));
   return 0;
 }
@@ -0,0 +1,29 @@
+#include "cpp/golf_archive/archive_format.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "cpp/cards/card.h"
+
+namespace golf_archive {
+
+int BlockHeader::userIndex(const string& user_id) const {
+  auto it = std::find(users.begin(), users.end(), user_id);
+  return it == users.end() ? -1 : static_cast<int>(it - users.begin());
+}
+
+ArchivedGame Block::game(size_t row) const {
+  ArchivedGame game{game_id[row], finished_at_ms[row], who_knocked[row], draw_remaining[row], {}};
+  for (uint32_t p = player_start[row]; p < player_start[row + 1]; p++) {
+    int seat = static_cast<int>(p - player_start[row]);
+    ArchivedPlayer player{header.users[user[p]], score[p], ((winners[row] >> seat) & 1) != 0,
+                          {cards::Card{hand[kHandSize * p]}, cards::Card{hand[kHandSize * p + 1]},
+                           cards::Card{hand[kHandSize * p + 2]},
+                           cards::Card{hand[kHandSize * p + 3]}}};
+    game.players.push_back(std::move(player));
+  }
+  return game;
+}
+
+}  // namespace golf_archive
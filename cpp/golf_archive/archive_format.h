@@ -0,0 +1,106 @@
+#ifndef CPP_GOLF_ARCHIVE_ARCHIVE_FORMAT_H
+#define CPP_GOLF_ARCHIVE_ARCHIVE_FORMAT_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cpp/cards/card.h"
+
+namespace golf_archive {
+
+using std::string;
+
+// An archive file is a run of self-contained blocks, each holding up to a few thousand finished
+// games column by column. Blocks are only ever appended, and a reader can step from one block
+// header to the next without decoding any columns. All integers are little-endian.
+//
+//   "GABK"  magic
+//   u32     header size, u32 payload size
+//   header: u32 rows, u32 players (summed over rows), BlockStats, u32 users,
+//           then each user id as u8 length + bytes
+//   payload: one column after another, each a u32 byte length + the values
+//     per game:   i64 finished_at_ms, u8 player count, i8 who knocked, u8 draw pile left,
+//                 u16 winners (bit i for seat i), game id (u8 length + bytes)
+//     per player: u16 user (index into the block's users), u8 score,
+//                 4 x u8 hand (Card::shuffleIndex, top left, top right, bottom left, bottom right)
+//
+// Per-game columns are in game order and per-player columns in seat order within game order, so
+// a game's players start at the sum of the player counts before it.
+
+inline constexpr char kBlockMagic[4] = {'G', 'A', 'B', 'K'};
+// The magic and the two sizes in front of every block.
+inline constexpr uint64_t kFrameSize = sizeof(kBlockMagic) + 2 * sizeof(uint32_t);
+// Keeps every block's user dictionary within u16 indices even at 12 players a game.
+inline constexpr int kMaxBlockRows = 5000;
+inline constexpr int kDefaultBlockRows = 4096;
+inline constexpr int kHandSize = 4;
+
+// What a block holds, for skipping it without reading its columns.
+struct BlockStats {
+  int64_t min_finished_at_ms = 0;
+  int64_t max_finished_at_ms = 0;
+  uint8_t min_score = 0;
+  uint8_t max_score = 0;
+  uint8_t min_players = 0;
+  uint8_t max_players = 0;
+};
+
+struct BlockHeader {
+  // Where the block starts in the file.
+  uint64_t offset = 0;
+  uint32_t header_size = 0;
+  uint32_t payload_size = 0;
+  uint32_t rows = 0;
+  uint32_t players = 0;
+  BlockStats stats;
+  // Every user id that appears in the block, in order of first appearance.
+  std::vector<string> users;
+
+  // Index of `user_id` in `users`, or -1 if the block never mentions it.
+  [[nodiscard]] int userIndex(const string& user_id) const;
+  // Where the block after this one starts.
+  [[nodiscard]] uint64_t end() const { return offset + kFrameSize + header_size + payload_size; }
+};
+
+struct ArchivedPlayer {
+  string user_id;
+  int score;
+  bool won;
+  std::array<cards::Card, kHandSize> hand;
+};
+
+struct ArchivedGame {
+  string game_id;
+  int64_t finished_at_ms;
+  int who_knocked;
+  int draw_remaining;
+  std::vector<ArchivedPlayer> players;
+};
+
+// A decoded block: plain arrays a scan can run over directly.
+struct Block {
+  BlockHeader header;
+
+  std::vector<int64_t> finished_at_ms;
+  std::vector<uint8_t> player_count;
+  std::vector<int8_t> who_knocked;
+  std::vector<uint8_t> draw_remaining;
+  std::vector<uint16_t> winners;
+  std::vector<string> game_id;
+  // rows + 1 entries: game i's players are [player_start[i], player_start[i + 1]).
+  std::vector<uint32_t> player_start;
+
+  std::vector<uint16_t> user;
+  std::vector<uint8_t> score;
+  std::vector<uint8_t> hand;  // kHandSize per player
+
+  [[nodiscard]] size_t rows() const { return finished_at_ms.size(); }
+  [[nodiscard]] ArchivedGame game(size_t row) const;
+};
+
+}  // namespace golf_archive
+
+#endif
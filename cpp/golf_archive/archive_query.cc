@@ -0,0 +1,228 @@
+#include "cpp/golf_archive/archive_query.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "cpp/cards/card.h"
+#include "cpp/golf_archive/archive_format.h"
+#include "cpp/golf_archive/archive_reader.h"
+#include "cpp/golf_archive/scan_kernels.h"
+
+namespace golf_archive {
+namespace {
+
+// Every group key fits a byte: player counts, 0/1, and draw pile sizes are all u8 columns.
+constexpr int kGroups = 256;
+
+struct Totals {
+  std::array<uint64_t, kGroups> seats{};
+  std::array<uint64_t, kGroups> wins{};
+  std::array<uint64_t, kGroups> score_sum{};
+  uint64_t blocks_scanned = 0;
+  uint64_t games_scanned = 0;
+
+  void add(const Totals& o) {
+    for (int k = 0; k < kGroups; k++) {
+      seats[k] += o.seats[k];
+      wins[k] += o.wins[k];
+      score_sum[k] += o.score_sum[k];
+    }
+    blocks_scanned += o.blocks_scanned;
+    games_scanned += o.games_scanned;
+  }
+};
+
+uint8_t ClampByte(int v) { return static_cast<uint8_t>(std::clamp(v, 0, 255)); }
+
+// Per-thread buffers, reused from block to block.
+struct Scratch {
+  std::vector<uint8_t> game_mask;
+  std::vector<uint8_t> seat_mask;
+  std::vector<uint8_t> won;
+  std::vector<uint8_t> key;
+};
+
+void ScanBlock(const Block& block, const Query& query, const scan_kernels::Kernels& k,
+               Scratch& scratch, Totals& totals) {
+  size_t rows = block.rows();
+  size_t seats = block.user.size();
+  totals.blocks_scanned++;
+  totals.games_scanned += rows;
+
+  auto& game_mask = scratch.game_mask;
+  game_mask.assign(rows, 0xFF);
+  k.range_i64(block.finished_at_ms.data(), rows, query.since_ms, query.until_ms, game_mask.data());
+  k.range_u8(block.player_count.data(), rows, ClampByte(query.min_players),
+             ClampByte(query.max_players), game_mask.data());
+
+  // Spread the game columns the seats need over the seats.
+  auto& seat_mask = scratch.seat_mask;
+  auto& won = scratch.won;
+  auto& key = scratch.key;
+  seat_mask.resize(seats);
+  won.resize(seats);
+  key.assign(seats, 0);
+  for (size_t r = 0; r < rows; r++) {
+    uint32_t start = block.player_start[r];
+    uint32_t count = block.player_count[r];
+    std::memset(seat_mask.data() + start, game_mask[r], count);
+    for (uint32_t seat = 0; seat < count; seat++) {
+      won[start + seat] = (block.winners[r] >> seat) & 1;
+    }
+    switch (query.group_by) {
+      case GroupBy::kNone:
+        break;
+      case GroupBy::kPlayers:
+        std::memset(key.data() + start, block.player_count[r], count);
+        break;
+      case GroupBy::kKnocked:
+        if (block.who_knocked[r] >= 0 && static_cast<uint32_t>(block.who_knocked[r]) < count) {
+          key[start + block.who_knocked[r]] = 1;
+        }
+        break;
+      case GroupBy::kDrawLeft:
+        std::memset(key.data() + start, block.draw_remaining[r], count);
+        break;
+    }
+  }
+
+  if (query.user_id) {
+    // MayMatch has already checked the block mentions the user.
+    int user = block.header.userIndex(*query.user_id);
+    k.equal_u16(block.user.data(), seats, static_cast<uint16_t>(user), seat_mask.data());
+  }
+  k.range_u8(block.score.data(), seats, ClampByte(query.min_score), ClampByte(query.max_score),
+             seat_mask.data());
+  if (query.holding) {
+    uint8_t wanted[4];
+    for (int suit = 0; suit < 4; suit++) {
+      wanted[suit] = static_cast<uint8_t>(
+          cards::Card(static_cast<cards::Suit>(suit), *query.holding).shuffleIndex());
+    }
+    k.holds_any(block.hand.data(), seats, wanted, seat_mask.data());
+  }
+
+  if (query.group_by == GroupBy::kNone) {
+    totals.seats[0] += k.count(seat_mask.data(), seats);
+    totals.wins[0] += k.masked_sum(won.data(), seat_mask.data(), seats);
+    totals.score_sum[0] += k.masked_sum(block.score.data(), seat_mask.data(), seats);
+    return;
+  }
+  for (size_t p = 0; p < seats; p++) {
+    uint8_t selected = seat_mask[p];
+    totals.seats[key[p]] += selected & 1;
+    totals.wins[key[p]] += won[p] & selected;
+    totals.score_sum[key[p]] += block.score[p] & selected;
+  }
+}
+}  // namespace
+
+bool MayMatch(const BlockHeader& header, const Query& query) {
+  const auto& stats = header.stats;
+  return stats.max_finished_at_ms >= query.since_ms && stats.min_finished_at_ms <= query.until_ms &&
+         stats.max_players >= query.min_players && stats.min_players <= query.max_players &&
+         stats.max_score >= query.min_score && stats.min_score <= query.max_score &&
+         (!query.user_id || header.userIndex(*query.user_id) >= 0);
+}
+
+absl::StatusOr<QueryResult> RunQuery(const string& path, const Query& query, unsigned threads) {
+  auto start = std::chrono::steady_clock::now();
+  auto reader = ArchiveReader::open(path);
+  if (!reader.ok()) {
+    return reader.status();
+  }
+  auto index = (*reader)->index();
+  if (!index.ok()) {
+    return index.status();
+  }
+  QueryResult result;
+  std::vector<BlockHeader> candidates;
+  for (auto& header : *index) {
+    if (MayMatch(header, query)) {
+      candidates.push_back(std::move(header));
+    } else {
+      result.blocks_skipped++;
+    }
+  }
+
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, candidates.size())));
+  const auto& kernels = scan_kernels::dispatch();
+  std::atomic<size_t> next{0};
+  std::vector<Totals> totals(threads);
+  std::vector<absl::Status> statuses(threads);
+  auto work = [&](unsigned t) {
+    auto own = ArchiveReader::open(path);
+    if (!own.ok()) {
+      statuses[t] = own.status();
+      return;
+    }
+    Scratch scratch;
+    for (size_t i = next++; i < candidates.size(); i = next++) {
+      auto block = (*own)->readBlock(candidates[i]);
+      if (!block.ok()) {
+        statuses[t] = block.status();
+        return;
+      }
+      ScanBlock(*block, query, kernels, scratch, totals[t]);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (unsigned t = 1; t < threads; t++) {
+    workers.emplace_back(work, t);
+  }
+  work(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  Totals all;
+  for (unsigned t = 0; t < threads; t++) {
+    if (!statuses[t].ok()) {
+      return statuses[t];
+    }
+    all.add(totals[t]);
+  }
+  result.blocks_scanned = all.blocks_scanned;
+  result.games_scanned = all.games_scanned;
+  for (int key = 0; key < kGroups; key++) {
+    if (all.seats[key] > 0 || (query.group_by == GroupBy::kNone && key == 0)) {
+      result.groups.push_back({key, all.seats[key], all.wins[key], all.score_sum[key]});
+    }
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+string FormatResult(const QueryResult& result, GroupBy group_by) {
+  string out = absl::StrFormat(
+      "%d games in %d blocks scanned in %.2fs (%.0f games/s), %d blocks skipped\n",
+      result.games_scanned, result.blocks_scanned, result.seconds,
+      result.seconds == 0 ? 0.0 : static_cast<double>(result.games_scanned) / result.seconds,
+      result.blocks_skipped);
+  const char* name = group_by == GroupBy::kPlayers    ? "players"
+                     : group_by == GroupBy::kKnocked  ? "knocked"
+                     : group_by == GroupBy::kDrawLeft ? "draw left"
+                                                      : "";
+  absl::StrAppendFormat(&out, "%9s %12s %12s %9s %9s\n", name, "seats", "wins", "win rate",
+                        "avg score");
+  for (const auto& group : result.groups) {
+    absl::StrAppendFormat(&out, "%9s %12d %12d %8.1f%% %9.2f\n",
+                          group_by == GroupBy::kNone ? "all" : std::to_string(group.key),
+                          group.seats, group.wins, 100 * group.winRate(), group.averageScore());
+  }
+  return out;
+}
+
+}  // namespace golf_archive
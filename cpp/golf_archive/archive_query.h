@@ -0,0 +1,78 @@
+#ifndef CPP_GOLF_ARCHIVE_ARCHIVE_QUERY_H
+#define CPP_GOLF_ARCHIVE_ARCHIVE_QUERY_H
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "cpp/cards/card.h"
+#include "cpp/golf_archive/archive_format.h"
+
+namespace golf_archive {
+
+// What to bucket a query's seats by.
+enum class GroupBy {
+  kNone,
+  // Players at the table.
+  kPlayers,
+  // 1 for the seat that knocked, 0 for the others.
+  kKnocked,
+  // Cards left in the draw pile when the game ended: how early it was knocked.
+  kDrawLeft,
+};
+
+// A scan over every seat of every archived game: the seats that pass all the filters, grouped
+// and counted. The game-level filters also prune whole blocks by their header stats.
+struct Query {
+  // Games finished in [since_ms, until_ms].
+  int64_t since_ms = std::numeric_limits<int64_t>::min();
+  int64_t until_ms = std::numeric_limits<int64_t>::max();
+  int min_players = 0;
+  int max_players = 255;
+  // Seats scoring in [min_score, max_score].
+  int min_score = 0;
+  int max_score = 255;
+  // Only this user's seats.
+  std::optional<string> user_id;
+  // Only seats whose final hand holds a card of this rank.
+  std::optional<cards::Rank> holding;
+  GroupBy group_by = GroupBy::kNone;
+};
+
+struct QueryGroup {
+  int key = 0;
+  uint64_t seats = 0;
+  uint64_t wins = 0;
+  uint64_t score_sum = 0;
+
+  [[nodiscard]] double winRate() const { return seats == 0 ? 0 : double(wins) / double(seats); }
+  [[nodiscard]] double averageScore() const {
+    return seats == 0 ? 0 : double(score_sum) / double(seats);
+  }
+};
+
+struct QueryResult {
+  // Non-empty groups by ascending key; a single group with key 0 for GroupBy::kNone.
+  std::vector<QueryGroup> groups;
+  uint64_t blocks_scanned = 0;
+  uint64_t blocks_skipped = 0;
+  uint64_t games_scanned = 0;
+  double seconds = 0;
+};
+
+// Whether `header`'s stats and users leave any chance of a seat in the block matching.
+bool MayMatch(const BlockHeader& header, const Query& query);
+
+// Runs `query` over the archive at `path`, decoding blocks on `threads` threads, one reader each.
+// `threads` of 0 means std::thread::hardware_concurrency().
+absl::StatusOr<QueryResult> RunQuery(const string& path, const Query& query, unsigned threads = 0);
+
+// A table of `result`, one line per group.
+string FormatResult(const QueryResult& result, GroupBy group_by);
+
+}  // namespace golf_archive
+
+#endif
@@ -0,0 +1,163 @@
+#include "cpp/golf_archive/archive_query.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/player.h"
+#include "cpp/golf_archive/archive_writer.h"
+#include "cpp/golf_archive/scan_kernels.h"
+
+using namespace cards;
+using namespace golf;
+using namespace golf_archive;
+
+namespace {
+// A finished game: `winner` pairs twos and threes for 0, `loser` holds a 5, 6, 7 and a queen for
+// 28. `knocker` is the winner's seat, 0, or the loser's, 1.
+GameState Finished(const std::string& game_id, const std::string& winner, const std::string& loser,
+                   int knocker) {
+  Player w{winner, Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+           Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+  Player l{loser, Card(Suit::Clubs, Rank::Five), Card(Suit::Diamonds, Rank::Six),
+           Card(Suit::Hearts, Rank::Seven), Card(Suit::Spades, Rank::Queen)};
+  return GameState{{}, {Card(Suit::Clubs, Rank::Ace)}, {w, l}, false, knocker, knocker, game_id,
+                   "v"};
+}
+
+// 40 games in blocks of 4: the first 20 at t = 0..19 between alice and bob, alice winning and
+// knocking; the rest at t = 100..119 between carol and dave, carol winning and dave knocking.
+std::string WriteArchive() {
+  auto path = ::testing::TempDir() + "/query.gab";
+  std::remove(path.c_str());
+  auto writer = ArchiveWriter::open(path, 4);
+  EXPECT_TRUE(writer.ok());
+  for (int i = 0; i < 20; i++) {
+    EXPECT_TRUE((*writer)->append(Finished("a" + std::to_string(i), "alice", "bob", 0), i).ok());
+  }
+  for (int i = 0; i < 20; i++) {
+    EXPECT_TRUE(
+        (*writer)->append(Finished("c" + std::to_string(i), "carol", "dave", 1), 100 + i).ok());
+  }
+  EXPECT_TRUE((*writer)->close().ok());
+  return path;
+}
+}  // namespace
+
+TEST(ScanKernels, VectorKernelsMatchScalar) {
+  if (!scan_kernels::supports_avx2()) {
+    GTEST_SKIP() << "no AVX2";
+  }
+  const auto& s = scan_kernels::scalar();
+  const auto& v = scan_kernels::avx2();
+  std::mt19937 rng(7);
+  // Odd lengths exercise the scalar tails.
+  for (size_t n : {0, 1, 7, 33, 100, 1001}) {
+    std::vector<int64_t> i64(n);
+    std::vector<uint8_t> u8(n), hands(4 * n), mask(n);
+    std::vector<uint16_t> u16(n);
+    for (size_t i = 0; i < n; i++) {
+      i64[i] = static_cast<int64_t>(rng() % 1000) - 500;
+      u8[i] = static_cast<uint8_t>(rng());
+      u16[i] = static_cast<uint16_t>(rng() % 8);
+      mask[i] = rng() % 4 == 0 ? 0 : 0xFF;
+      for (int k = 0; k < 4; k++) {
+        hands[4 * i + k] = static_cast<uint8_t>(rng() % 52);
+      }
+    }
+    const uint8_t cards[4] = {9, 22, 35, 48};
+    auto a = mask, b = mask;
+    s.range_i64(i64.data(), n, -100, 250, a.data());
+    v.range_i64(i64.data(), n, -100, 250, b.data());
+    EXPECT_EQ(a, b) << n;
+    s.range_u8(u8.data(), n, 40, 200, a.data());
+    v.range_u8(u8.data(), n, 40, 200, b.data());
+    EXPECT_EQ(a, b) << n;
+    a = b = mask;
+    s.equal_u16(u16.data(), n, 3, a.data());
+    v.equal_u16(u16.data(), n, 3, b.data());
+    EXPECT_EQ(a, b) << n;
+    a = b = mask;
+    s.holds_any(hands.data(), n, cards, a.data());
+    v.holds_any(hands.data(), n, cards, b.data());
+    EXPECT_EQ(a, b) << n;
+    EXPECT_EQ(s.masked_sum(u8.data(), mask.data(), n), v.masked_sum(u8.data(), mask.data(), n));
+    EXPECT_EQ(s.count(mask.data(), n), v.count(mask.data(), n));
+  }
+}
+
+TEST(ArchiveQuery, CountsEverySeat) {
+  auto path = WriteArchive();
+  auto result = RunQuery(path, Query{}, 3);
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ(result->blocks_scanned, 10);
+  EXPECT_EQ(result->blocks_skipped, 0);
+  EXPECT_EQ(result->games_scanned, 40);
+  ASSERT_EQ(result->groups.size(), 1);
+  EXPECT_EQ(result->groups[0].seats, 80);
+  EXPECT_EQ(result->groups[0].wins, 40);
+  EXPECT_DOUBLE_EQ(result->groups[0].averageScore(), 14.0);
+}
+
+TEST(ArchiveQuery, PrunesBlocksByStatsAndUsers) {
+  auto path = WriteArchive();
+  Query recent{.since_ms = 100};
+  auto result = RunQuery(path, recent, 2);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->blocks_skipped, 5);
+  EXPECT_EQ(result->groups[0].seats, 40);
+
+  // Within a block, the time filter applies row by row.
+  Query middle{.since_ms = 2, .until_ms = 5};
+  result = RunQuery(path, middle, 1);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->blocks_scanned, 2);
+  EXPECT_EQ(result->groups[0].seats, 8);
+
+  Query bob{.user_id = "bob"};
+  result = RunQuery(path, bob);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->blocks_skipped, 5);
+  EXPECT_EQ(result->groups[0].seats, 20);
+  EXPECT_EQ(result->groups[0].wins, 0);
+
+  Query nobody{.user_id = "erin"};
+  result = RunQuery(path, nobody);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->blocks_scanned, 0);
+  EXPECT_EQ(result->groups[0].seats, 0);
+}
+
+TEST(ArchiveQuery, FiltersSeatsAndGroups) {
+  auto path = WriteArchive();
+  Query queens{.holding = Rank::Queen};
+  auto result = RunQuery(path, queens);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->groups[0].seats, 40);
+  EXPECT_EQ(result->groups[0].wins, 0);
+  EXPECT_DOUBLE_EQ(result->groups[0].averageScore(), 28.0);
+
+  Query by_knock{.group_by = GroupBy::kKnocked};
+  result = RunQuery(path, by_knock);
+  ASSERT_TRUE(result.ok());
+  ASSERT_EQ(result->groups.size(), 2);
+  EXPECT_EQ(result->groups[1].key, 1);
+  EXPECT_EQ(result->groups[1].seats, 40);
+  EXPECT_DOUBLE_EQ(result->groups[1].winRate(), 0.5);
+
+  Query by_players{.max_score = 10, .group_by = GroupBy::kPlayers};
+  result = RunQuery(path, by_players);
+  ASSERT_TRUE(result.ok());
+  ASSERT_EQ(result->groups.size(), 1);
+  EXPECT_EQ(result->groups[0].key, 2);
+  EXPECT_EQ(result->groups[0].wins, 40);
+}
+
+TEST(ArchiveQuery, MissingArchive) {
+  EXPECT_FALSE(RunQuery(::testing::TempDir() + "/missing.gab", Query{}).ok());
+}
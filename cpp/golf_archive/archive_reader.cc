@@ -0,0 +1,209 @@
+#include "cpp/golf_archive/archive_reader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cpp/golf_archive/archive_format.h"
+
+namespace golf_archive {
+
+namespace {
+// Reads little-endian values off the front of a buffer, remembering if it ever ran out.
+class ByteReader {
+ public:
+  explicit ByteReader(const string& bytes) : data_(bytes.data()), left_(bytes.size()) {}
+
+  template <typename T>
+  T get() {
+    T value{};
+    if (left_ < sizeof(T)) {
+      ok_ = false;
+      return value;
+    }
+    std::memcpy(&value, data_, sizeof(T));
+    data_ += sizeof(T);
+    left_ -= sizeof(T);
+    return value;
+  }
+
+  string getString() {
+    auto size = get<uint8_t>();
+    if (left_ < size) {
+      ok_ = false;
+      return {};
+    }
+    string s(data_, size);
+    data_ += size;
+    left_ -= size;
+    return s;
+  }
+
+  // A column of `count` fixed-width values.
+  template <typename T>
+  std::vector<T> getColumn(size_t count) {
+    auto bytes = get<uint32_t>();
+    if (bytes != count * sizeof(T) || left_ < bytes) {
+      ok_ = false;
+      return {};
+    }
+    std::vector<T> values(count);
+    std::memcpy(values.data(), data_, bytes);
+    data_ += bytes;
+    left_ -= bytes;
+    return values;
+  }
+
+  [[nodiscard]] bool ok() const { return ok_; }
+  [[nodiscard]] size_t left() const { return left_; }
+
+ private:
+  const char* data_;
+  size_t left_;
+  bool ok_ = true;
+};
+
+absl::Status Corrupt(uint64_t offset) {
+  return absl::DataLossError("corrupt archive block at offset " + std::to_string(offset));
+}
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<ArchiveReader>> ArchiveReader::open(const string& path) {
+  std::ifstream in{path, std::ios::binary | std::ios::ate};
+  if (!in) {
+    return absl::NotFoundError("cannot open " + path);
+  }
+  auto size = static_cast<uint64_t>(in.tellg());
+  return std::unique_ptr<ArchiveReader>(new ArchiveReader(std::move(in), size));
+}
+
+absl::StatusOr<std::optional<BlockHeader>> ArchiveReader::nextHeader() {
+  current_.reset();
+  uint64_t offset = next_offset_;
+  if (offset + kFrameSize > size_) {
+    return std::nullopt;
+  }
+
+  string frame(kFrameSize, '\0');
+  in_.clear();
+  in_.seekg(static_cast<std::streamoff>(offset));
+  in_.read(frame.data(), static_cast<std::streamsize>(kFrameSize));
+  if (!in_ || std::memcmp(frame.data(), kBlockMagic, sizeof(kBlockMagic)) != 0) {
+    return Corrupt(offset);
+  }
+  uint32_t sizes[2];
+  std::memcpy(sizes, frame.data() + sizeof(kBlockMagic), sizeof(sizes));
+
+  BlockHeader header;
+  header.offset = offset;
+  header.header_size = sizes[0];
+  header.payload_size = sizes[1];
+  uint64_t end = header.end();
+  if (end > size_) {
+    // Torn write at the tail.
+    return std::nullopt;
+  }
+
+  string bytes(header.header_size, '\0');
+  in_.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  ByteReader r{bytes};
+  header.rows = r.get<uint32_t>();
+  header.players = r.get<uint32_t>();
+  header.stats.min_finished_at_ms = r.get<int64_t>();
+  header.stats.max_finished_at_ms = r.get<int64_t>();
+  header.stats.min_score = r.get<uint8_t>();
+  header.stats.max_score = r.get<uint8_t>();
+  header.stats.min_players = r.get<uint8_t>();
+  header.stats.max_players = r.get<uint8_t>();
+  auto users = r.get<uint32_t>();
+  for (uint32_t i = 0; i < users && r.ok(); i++) {
+    header.users.push_back(r.getString());
+  }
+  if (!in_ || !r.ok() || r.left() != 0 || header.rows > kMaxBlockRows) {
+    return Corrupt(offset);
+  }
+
+  next_offset_ = end;
+  current_ = header;
+  return header;
+}
+
+absl::StatusOr<Block> ArchiveReader::readBlock() {
+  if (!current_) {
+    return absl::FailedPreconditionError("no current block");
+  }
+  return readBlock(*current_);
+}
+
+absl::StatusOr<Block> ArchiveReader::readBlock(const BlockHeader& header) {
+  string bytes(header.payload_size, '\0');
+  in_.clear();
+  in_.seekg(static_cast<std::streamoff>(header.offset + kFrameSize + header.header_size));
+  in_.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  if (!in_) {
+    return Corrupt(header.offset);
+  }
+
+  Block block;
+  block.header = header;
+  ByteReader r{bytes};
+  block.finished_at_ms = r.getColumn<int64_t>(header.rows);
+  block.player_count = r.getColumn<uint8_t>(header.rows);
+  block.who_knocked = r.getColumn<int8_t>(header.rows);
+  block.draw_remaining = r.getColumn<uint8_t>(header.rows);
+  block.winners = r.getColumn<uint16_t>(header.rows);
+  // Game ids are variable width, so their column length is checked against what they consumed.
+  size_t ids_size = r.get<uint32_t>();
+  size_t ids_end = r.left() - std::min(r.left(), ids_size);
+  for (uint32_t i = 0; i < header.rows && r.ok(); i++) {
+    block.game_id.push_back(r.getString());
+  }
+  if (r.left() != ids_end) {
+    return Corrupt(header.offset);
+  }
+  block.user = r.getColumn<uint16_t>(header.players);
+  block.score = r.getColumn<uint8_t>(header.players);
+  block.hand = r.getColumn<uint8_t>(header.players * static_cast<size_t>(kHandSize));
+  if (!r.ok() || r.left() != 0) {
+    return Corrupt(header.offset);
+  }
+
+  block.player_start.reserve(header.rows + 1);
+  block.player_start.push_back(0);
+  for (auto count : block.player_count) {
+    block.player_start.push_back(block.player_start.back() + count);
+  }
+  if (block.player_start.back() != header.players) {
+    return Corrupt(header.offset);
+  }
+  for (auto u : block.user) {
+    if (u >= header.users.size()) {
+      return Corrupt(header.offset);
+    }
+  }
+  return block;
+}
+
+absl::StatusOr<std::vector<BlockHeader>> ArchiveReader::index() {
+  next_offset_ = 0;
+  std::vector<BlockHeader> headers;
+  for (;;) {
+    auto header = nextHeader();
+    if (!header.ok()) {
+      return header.status();
+    }
+    if (!header->has_value()) {
+      return headers;
+    }
+    headers.push_back(std::move(**header));
+  }
+}
+
+}  // namespace golf_archive
@@ -0,0 +1,50 @@
+#ifndef CPP_GOLF_ARCHIVE_ARCHIVE_READER_H
+#define CPP_GOLF_ARCHIVE_ARCHIVE_READER_H
+
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cpp/golf_archive/archive_format.h"
+
+namespace golf_archive {
+
+// Reads an archive file block by block. nextHeader() steps over blocks reading only their headers,
+// so a caller can decide from the stats and user dictionary whether a block is worth decoding
+// before asking for its columns. Memory use is one block at a time.
+//
+// A block cut short at the end of the file, as a crash during a write leaves it, reads as the end
+// of the archive; anything else malformed is an error.
+//
+// Not thread-safe. Open one reader per thread; they can share a file.
+class ArchiveReader {
+ public:
+  static absl::StatusOr<std::unique_ptr<ArchiveReader>> open(const string& path);
+
+  // The header of the next block, or nullopt at the end of the archive.
+  absl::StatusOr<std::optional<BlockHeader>> nextHeader();
+  // Decodes the block whose header nextHeader() last returned.
+  absl::StatusOr<Block> readBlock();
+  // Decodes the block at `header`, which came from any reader of the same file.
+  absl::StatusOr<Block> readBlock(const BlockHeader& header);
+
+  // Every block's header, from the start of the file. Leaves nextHeader() at the end.
+  absl::StatusOr<std::vector<BlockHeader>> index();
+
+ private:
+  explicit ArchiveReader(std::ifstream in, uint64_t size) : in_(std::move(in)), size_(size) {}
+
+  std::ifstream in_;
+  uint64_t size_;
+  uint64_t next_offset_ = 0;
+  std::optional<BlockHeader> current_;
+};
+
+}  // namespace golf_archive
+
+#endif
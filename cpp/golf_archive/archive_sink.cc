@@ -0,0 +1,29 @@
+#include "cpp/golf_archive/archive_sink.h"
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include "absl/status/status.h"
+
+namespace golf_archive {
+
+absl::Status ArchiveSink::Archive(const std::vector<golf::EvictedGame>& games) {
+  std::scoped_lock lock{mutex_};
+  absl::Status status;
+  for (auto& evicted : games) {
+    auto finished_at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                              evicted.finished_at.time_since_epoch())
+                              .count();
+    // Keep going past a bad game so that one doesn't cost the rest of the batch.
+    status.Update(writer_->append(*evicted.game, finished_at_ms));
+  }
+  return status;
+}
+
+absl::Status ArchiveSink::flush() {
+  std::scoped_lock lock{mutex_};
+  return writer_->flush();
+}
+
+}  // namespace golf_archive
@@ -0,0 +1,34 @@
+#ifndef CPP_GOLF_ARCHIVE_ARCHIVE_SINK_H
+#define CPP_GOLF_ARCHIVE_ARCHIVE_SINK_H
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "cpp/cards/golf/in_memory_game_store.h"
+#include "cpp/golf_archive/archive_writer.h"
+
+namespace golf_archive {
+
+// Appends the games an InMemoryGameStore evicts to an archive file. Games reach the file a block
+// at a time, so up to a block's worth is lost if the process dies without destroying the sink.
+//
+// Thread-safe.
+class ArchiveSink final : public golf::GameSinkInterface {
+ public:
+  explicit ArchiveSink(std::unique_ptr<ArchiveWriter> writer) : writer_(std::move(writer)) {}
+
+  absl::Status Archive(const std::vector<golf::EvictedGame>& games) override;
+  // Writes out any games still buffered.
+  absl::Status flush();
+
+ private:
+  std::mutex mutex_;
+  std::unique_ptr<ArchiveWriter> writer_;
+};
+
+}  // namespace golf_archive
+
+#endif
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/player.h"
+#include "cpp/golf_archive/archive_format.h"
+#include "cpp/golf_archive/archive_reader.h"
+#include "cpp/golf_archive/archive_writer.h"
+
+using namespace cards;
+using namespace golf;
+using namespace golf_archive;
+
+namespace {
+std::string TempPath(const std::string& name) {
+  auto path = ::testing::TempDir() + "/" + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+// A finished two player game; alice holds a pair of twos and wins.
+GameState Finished(const std::string& game_id, const std::string& bob = "bob") {
+  Player alice{"alice", Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+               Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+  Player other{bob, Card(Suit::Clubs, Rank::Five), Card(Suit::Diamonds, Rank::Six),
+               Card(Suit::Hearts, Rank::Seven), Card(Suit::Spades, Rank::Eight)};
+  return GameState{{}, {Card(Suit::Clubs, Rank::Ace)}, {alice, other}, false, 0, 1, game_id, "v"};
+}
+
+std::vector<Block> ReadAll(const std::string& path) {
+  auto reader = ArchiveReader::open(path);
+  EXPECT_TRUE(reader.ok()) << reader.status();
+  std::vector<Block> blocks;
+  for (;;) {
+    auto header = (*reader)->nextHeader();
+    EXPECT_TRUE(header.ok()) << header.status();
+    if (!header.ok() || !header->has_value()) {
+      return blocks;
+    }
+    auto block = (*reader)->readBlock();
+    EXPECT_TRUE(block.ok()) << block.status();
+    blocks.push_back(*block);
+  }
+}
+}  // namespace
+
+TEST(Archive, RoundTripsFinishedGames) {
+  auto path = TempPath("round_trip.gab");
+  auto writer = ArchiveWriter::open(path);
+  ASSERT_TRUE(writer.ok()) << writer.status();
+  ASSERT_TRUE((*writer)->append(Finished("g1"), 1000).ok());
+  EXPECT_EQ((*writer)->pending(), 1);
+  ASSERT_TRUE((*writer)->close().ok());
+
+  auto blocks = ReadAll(path);
+  ASSERT_EQ(blocks.size(), 1);
+  ASSERT_EQ(blocks[0].rows(), 1);
+  auto game = blocks[0].game(0);
+  EXPECT_EQ(game.game_id, "g1");
+  EXPECT_EQ(game.finished_at_ms, 1000);
+  EXPECT_EQ(game.who_knocked, 1);
+  EXPECT_EQ(game.draw_remaining, 0);
+  ASSERT_EQ(game.players.size(), 2);
+
+  auto original = Finished("g1");
+  for (int seat = 0; seat < 2; seat++) {
+    auto& player = original.getPlayers()[seat];
+    EXPECT_EQ(game.players[seat].user_id, *player.getName());
+    EXPECT_EQ(game.players[seat].score, player.score());
+    EXPECT_EQ(game.players[seat].won, seat == 0);
+    EXPECT_EQ(game.players[seat].hand[0], player.cardAt(Position::TopLeft));
+    EXPECT_EQ(game.players[seat].hand[3], player.cardAt(Position::BottomRight));
+  }
+}
+
+TEST(Archive, WritesBlocksWithStatsAndUsers) {
+  auto path = TempPath("blocks.gab");
+  {
+    auto writer = ArchiveWriter::open(path, 2);
+    ASSERT_TRUE(writer.ok());
+    ASSERT_TRUE((*writer)->append(Finished("g1", "bob"), 30).ok());
+    ASSERT_TRUE((*writer)->append(Finished("g2", "carol"), 10).ok());
+    EXPECT_EQ((*writer)->pending(), 0);
+    ASSERT_TRUE((*writer)->append(Finished("g3", "bob"), 50).ok());
+  }  // the destructor writes g3
+  {
+    // Reopening appends rather than truncating.
+    auto writer = ArchiveWriter::open(path, 2);
+    ASSERT_TRUE(writer.ok());
+    ASSERT_TRUE((*writer)->append(Finished("g4", "dave"), 70).ok());
+    ASSERT_TRUE((*writer)->close().ok());
+  }
+
+  auto reader = ArchiveReader::open(path);
+  ASSERT_TRUE(reader.ok());
+  auto index = (*reader)->index();
+  ASSERT_TRUE(index.ok()) << index.status();
+  ASSERT_EQ(index->size(), 3);
+  auto& first = (*index)[0];
+  EXPECT_EQ(first.rows, 2);
+  EXPECT_EQ(first.players, 4);
+  EXPECT_EQ(first.stats.min_finished_at_ms, 10);
+  EXPECT_EQ(first.stats.max_finished_at_ms, 30);
+  EXPECT_EQ(first.stats.min_score, 0);
+  EXPECT_EQ(first.stats.max_score, 26);
+  EXPECT_EQ(first.stats.min_players, 2);
+  EXPECT_EQ(first.users, (std::vector<std::string>{"alice", "bob", "carol"}));
+  EXPECT_EQ(first.userIndex("carol"), 2);
+  EXPECT_EQ(first.userIndex("dave"), -1);
+  EXPECT_EQ((*index)[2].users, (std::vector<std::string>{"alice", "dave"}));
+
+  // Any reader can decode a block from the index.
+  auto block = (*reader)->readBlock((*index)[1]);
+  ASSERT_TRUE(block.ok());
+  EXPECT_EQ(block->game(0).game_id, "g3");
+}
+
+TEST(Archive, IgnoresATornTail) {
+  auto path = TempPath("torn.gab");
+  {
+    auto writer = ArchiveWriter::open(path, 1);
+    ASSERT_TRUE(writer.ok());
+    ASSERT_TRUE((*writer)->append(Finished("g1"), 1).ok());
+    ASSERT_TRUE((*writer)->append(Finished("g2"), 2).ok());
+  }
+  std::string bytes;
+  {
+    std::ifstream in{path, std::ios::binary};
+    bytes.assign(std::istreambuf_iterator<char>(in), {});
+  }
+  {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 5));
+  }
+
+  auto blocks = ReadAll(path);
+  ASSERT_EQ(blocks.size(), 1);
+  EXPECT_EQ(blocks[0].game(0).game_id, "g1");
+
+  // Damage before the tail is an error, though.
+  bytes[0] = 'X';
+  {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+  auto reader = ArchiveReader::open(path);
+  ASSERT_TRUE(reader.ok());
+  EXPECT_EQ((*reader)->nextHeader().status().code(), absl::StatusCode::kDataLoss);
+}
+
+TEST(Archive, AppendsAfterCuttingOffATornTail) {
+  auto path = TempPath("reopened.gab");
+  {
+    auto writer = ArchiveWriter::open(path, 1);
+    ASSERT_TRUE(writer.ok());
+    ASSERT_TRUE((*writer)->append(Finished("g1"), 1).ok());
+    ASSERT_TRUE((*writer)->append(Finished("g2"), 2).ok());
+  }
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) - 5);
+
+  {
+    auto writer = ArchiveWriter::open(path, 1);
+    ASSERT_TRUE(writer.ok()) << writer.status();
+    ASSERT_TRUE((*writer)->append(Finished("g3"), 3).ok());
+  }
+  auto reader = ArchiveReader::open(path);
+  ASSERT_TRUE(reader.ok());
+  auto index = (*reader)->index();
+  ASSERT_TRUE(index.ok()) << index.status();
+  EXPECT_EQ(index->size(), 2);
+  auto blocks = ReadAll(path);
+  ASSERT_EQ(blocks.size(), 2);
+  EXPECT_EQ(blocks[0].game(0).game_id, "g1");
+  EXPECT_EQ(blocks[1].game(0).game_id, "g3");
+
+  // Damage before the tail is not appended to.
+  {
+    std::fstream out{path, std::ios::binary | std::ios::in | std::ios::out};
+    out.put('X');
+  }
+  EXPECT_EQ(ArchiveWriter::open(path).status().code(), absl::StatusCode::kDataLoss);
+}
+
+TEST(Archive, DropsABlockThatFailsToWrite) {
+  // Every write to /dev/full fails with ENOSPC.
+  auto writer = ArchiveWriter::open("/dev/full", 2);
+  ASSERT_TRUE(writer.ok()) << writer.status();
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE((*writer)->append(Finished("g1"), 1).ok());
+    EXPECT_EQ((*writer)->append(Finished("g2"), 2).code(), absl::StatusCode::kDataLoss);
+    EXPECT_EQ((*writer)->pending(), 0);
+  }
+}
+
+TEST(Archive, RejectsUnfinishedGames) {
+  auto path = TempPath("unfinished.gab");
+  auto writer = ArchiveWriter::open(path);
+  ASSERT_TRUE(writer.ok());
+  auto game = Finished("g1");
+  GameState running{{Card(Suit::Clubs, Rank::Four)}, game.getDiscardPile(), game.getPlayers(),
+                    false, 0, -1, "g1", "v"};
+  EXPECT_EQ((*writer)->append(running, 1).code(), absl::StatusCode::kFailedPrecondition);
+  EXPECT_EQ((*writer)->pending(), 0);
+  EXPECT_EQ(ArchiveWriter::open(path, 0).status().code(), absl::StatusCode::kInvalidArgument);
+}
@@ -0,0 +1,220 @@
+#include "cpp/golf_archive/archive_writer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/player.h"
+#include "cpp/golf_archive/archive_format.h"
+#include "cpp/golf_archive/archive_reader.h"
+
+namespace golf_archive {
+
+static_assert(std::endian::native == std::endian::little, "archive columns are written as is");
+
+namespace {
+template <typename T>
+void Put(string& out, T value) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  out.append(bytes, sizeof(T));
+}
+
+template <typename T>
+void PutColumn(string& out, const std::vector<T>& values) {
+  Put<uint32_t>(out, static_cast<uint32_t>(values.size() * sizeof(T)));
+  out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+void PutString(string& out, const string& s) {
+  Put<uint8_t>(out, static_cast<uint8_t>(s.size()));
+  out.append(s);
+}
+
+constexpr golf::Position kHandOrder[kHandSize] = {
+    golf::Position::TopLeft, golf::Position::TopRight, golf::Position::BottomLeft,
+    golf::Position::BottomRight};
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<ArchiveWriter>> ArchiveWriter::open(const string& path,
+                                                                   int block_rows) {
+  if (block_rows < 1 || block_rows > kMaxBlockRows) {
+    return absl::InvalidArgumentError("block_rows out of range");
+  }
+  uint64_t size = 0;
+  std::error_code ec;
+  if (std::filesystem::is_regular_file(path, ec)) {
+    // Readers stop at a torn block only at the end of the file, so one left by a crash has to go
+    // before anything is written after it. Damage further in is left for someone to look at.
+    auto reader = ArchiveReader::open(path);
+    if (!reader.ok()) {
+      return reader.status();
+    }
+    auto blocks = (*reader)->index();
+    if (!blocks.ok()) {
+      return blocks.status();
+    }
+    if (!blocks->empty()) {
+      size = blocks->back().end();
+    }
+    if (std::filesystem::file_size(path, ec) != size && !ec) {
+      std::filesystem::resize_file(path, size, ec);
+    }
+    if (ec) {
+      return absl::UnavailableError("cannot truncate " + path + ": " + ec.message());
+    }
+  }
+  std::ofstream out{path, std::ios::binary | std::ios::app};
+  if (!out) {
+    return absl::UnavailableError("cannot open " + path);
+  }
+  return std::unique_ptr<ArchiveWriter>(new ArchiveWriter(path, std::move(out), size, block_rows));
+}
+
+ArchiveWriter::ArchiveWriter(string path, std::ofstream out, uint64_t size, int block_rows)
+    : path_(std::move(path)), out_(std::move(out)), size_(size), block_rows_(block_rows) {
+  reset();
+}
+
+ArchiveWriter::~ArchiveWriter() { (void)flush(); }
+
+void ArchiveWriter::reset() {
+  block_ = Block{};
+  block_.player_start.push_back(0);
+  user_index_.clear();
+}
+
+absl::Status ArchiveWriter::append(const golf::GameState& game, int64_t finished_at_ms) {
+  if (!game.isOver()) {
+    return absl::FailedPreconditionError("game is not over");
+  }
+  auto& players = game.getPlayers();
+  if (game.getGameId().size() > 255) {
+    return absl::InvalidArgumentError("game id too long");
+  }
+
+  uint16_t winners = 0;
+  for (int seat : game.winners()) {
+    winners |= static_cast<uint16_t>(1u << seat);
+  }
+  block_.finished_at_ms.push_back(finished_at_ms);
+  block_.player_count.push_back(static_cast<uint8_t>(players.size()));
+  block_.who_knocked.push_back(static_cast<int8_t>(game.getWhoKnocked()));
+  block_.draw_remaining.push_back(
+      static_cast<uint8_t>(std::min<size_t>(game.getDrawPile().size(), 255)));
+  block_.winners.push_back(winners);
+  block_.game_id.push_back(game.getGameId());
+
+  for (auto& player : players) {
+    // An empty seat in a finished game can only come from a game that was abandoned half full.
+    const string& user_id = player.getName().value_or("");
+    auto [it, inserted] =
+        user_index_.try_emplace(user_id, static_cast<uint16_t>(block_.header.users.size()));
+    if (inserted) {
+      block_.header.users.push_back(user_id.substr(0, 255));
+    }
+    block_.user.push_back(it->second);
+    block_.score.push_back(static_cast<uint8_t>(player.score()));
+    for (auto position : kHandOrder) {
+      block_.hand.push_back(static_cast<uint8_t>(player.cardAt(position).shuffleIndex()));
+    }
+  }
+  block_.player_start.push_back(static_cast<uint32_t>(block_.user.size()));
+
+  if (pending() >= block_rows_) {
+    return flush();
+  }
+  return absl::OkStatus();
+}
+
+absl::Status ArchiveWriter::flush() {
+  if (pending() == 0) {
+    return absl::OkStatus();
+  }
+  auto& b = block_;
+  BlockStats stats;
+  auto [min_at, max_at] = std::minmax_element(b.finished_at_ms.begin(), b.finished_at_ms.end());
+  stats.min_finished_at_ms = *min_at;
+  stats.max_finished_at_ms = *max_at;
+  auto [min_score, max_score] = std::minmax_element(b.score.begin(), b.score.end());
+  stats.min_score = b.score.empty() ? 0 : *min_score;
+  stats.max_score = b.score.empty() ? 0 : *max_score;
+  auto [min_players, max_players] =
+      std::minmax_element(b.player_count.begin(), b.player_count.end());
+  stats.min_players = *min_players;
+  stats.max_players = *max_players;
+
+  string header;
+  Put<uint32_t>(header, static_cast<uint32_t>(b.rows()));
+  Put<uint32_t>(header, static_cast<uint32_t>(b.user.size()));
+  Put<int64_t>(header, stats.min_finished_at_ms);
+  Put<int64_t>(header, stats.max_finished_at_ms);
+  Put<uint8_t>(header, stats.min_score);
+  Put<uint8_t>(header, stats.max_score);
+  Put<uint8_t>(header, stats.min_players);
+  Put<uint8_t>(header, stats.max_players);
+  Put<uint32_t>(header, static_cast<uint32_t>(b.header.users.size()));
+  for (auto& user : b.header.users) {
+    PutString(header, user);
+  }
+
+  string payload;
+  PutColumn(payload, b.finished_at_ms);
+  PutColumn(payload, b.player_count);
+  PutColumn(payload, b.who_knocked);
+  PutColumn(payload, b.draw_remaining);
+  PutColumn(payload, b.winners);
+  string ids;
+  for (auto& id : b.game_id) {
+    PutString(ids, id);
+  }
+  Put<uint32_t>(payload, static_cast<uint32_t>(ids.size()));
+  payload.append(ids);
+  PutColumn(payload, b.user);
+  PutColumn(payload, b.score);
+  PutColumn(payload, b.hand);
+
+  string frame(kBlockMagic, sizeof(kBlockMagic));
+  Put<uint32_t>(frame, static_cast<uint32_t>(header.size()));
+  Put<uint32_t>(frame, static_cast<uint32_t>(payload.size()));
+  out_.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+  out_.write(header.data(), static_cast<std::streamsize>(header.size()));
+  out_.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+  out_.flush();
+  if (!out_) {
+    auto dropped = pending();
+    reset();
+    // Cut off whatever part of the block made it out and start over with a fresh stream. Until
+    // the cut works the stream stays closed, so nothing lands after a partial block.
+    out_.close();
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(path_, ec)) {
+      std::filesystem::resize_file(path_, size_, ec);
+    }
+    if (!ec) {
+      out_.open(path_, std::ios::binary | std::ios::app);
+    }
+    return absl::DataLossError("archive write failed, " + std::to_string(dropped) +
+                               " games dropped");
+  }
+  size_ += frame.size() + header.size() + payload.size();
+  reset();
+  return absl::OkStatus();
+}
+
+absl::Status ArchiveWriter::close() {
+  auto status = flush();
+  out_.close();
+  return status;
+}
+
+}  // namespace golf_archive
@@ -0,0 +1,60 @@
+#ifndef CPP_GOLF_ARCHIVE_ARCHIVE_WRITER_H
+#define CPP_GOLF_ARCHIVE_ARCHIVE_WRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/golf_archive/archive_format.h"
+
+namespace golf_archive {
+
+// Appends finished games to an archive file. Games are buffered column by column and written
+// out as a block every `block_rows` games, so memory stays bounded by one block however much is
+// archived. Opening an existing file adds blocks after the ones already there, first cutting off
+// a block left torn by a crash so that the new ones stay readable.
+//
+// Not thread-safe. requires external synchronization
+class ArchiveWriter {
+ public:
+  static absl::StatusOr<std::unique_ptr<ArchiveWriter>> open(const string& path,
+                                                             int block_rows = kDefaultBlockRows);
+
+  ArchiveWriter(const ArchiveWriter&) = delete;
+  ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+  // Writes any buffered games; call close() to see whether that worked.
+  ~ArchiveWriter();
+
+  // Buffers `game`, which must be over, writing a block if that fills one.
+  absl::Status append(const golf::GameState& game, int64_t finished_at_ms);
+  // Writes the buffered games as a block, if there are any. If that fails the block is dropped and
+  // the file cut back to the blocks before it, so a failing disk loses games rather than memory.
+  absl::Status flush();
+  absl::Status close();
+
+  // Games buffered and not yet written.
+  [[nodiscard]] int pending() const { return static_cast<int>(block_.finished_at_ms.size()); }
+
+ private:
+  ArchiveWriter(string path, std::ofstream out, uint64_t size, int block_rows);
+  void reset();
+
+  const string path_;
+  std::ofstream out_;
+  // Bytes of complete blocks in the file.
+  uint64_t size_;
+  const int block_rows_;
+  Block block_;
+  std::unordered_map<string, uint16_t> user_index_;
+};
+
+}  // namespace golf_archive
+
+#endif
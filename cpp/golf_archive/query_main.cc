@@ -0,0 +1,89 @@
+// Ad hoc queries over a game archive, e.g. win rate by how early the game was knocked, or the
+// average score of seats holding a jack:
+//   bazel run -c opt //cpp/golf_archive:query -- --archive=/data/games.gab --group_by=draw_left
+//   bazel run -c opt //cpp/golf_archive:query -- --archive=/data/games.gab --holding=J
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "cpp/cards/card.h"
+#include "cpp/golf_archive/archive_query.h"
+
+ABSL_FLAG(std::string, archive, "", "Archive file to scan");
+ABSL_FLAG(int64_t, since_ms, std::numeric_limits<int64_t>::min(),
+          "Only games finished at or after this time (ms since epoch)");
+ABSL_FLAG(int64_t, until_ms, std::numeric_limits<int64_t>::max(),
+          "Only games finished at or before this time (ms since epoch)");
+ABSL_FLAG(int, min_players, 0, "Only games with at least this many players");
+ABSL_FLAG(int, max_players, 255, "Only games with at most this many players");
+ABSL_FLAG(int, min_score, 0, "Only seats scoring at least this");
+ABSL_FLAG(int, max_score, 255, "Only seats scoring at most this");
+ABSL_FLAG(std::string, user, "", "Only this user's seats");
+ABSL_FLAG(std::string, holding, "", "Only seats ending with a card of this rank (2-10, J, Q, K, A)");
+ABSL_FLAG(std::string, group_by, "none", "none, players, knocked or draw_left");
+ABSL_FLAG(unsigned, threads, 0, "Worker threads, 0 for one per core");
+
+std::optional<cards::Rank> ParseRank(const std::string& name) {
+  static const char* kNames[] = {"2", "3", "4", "5", "6", "7", "8", "9", "10", "J", "Q", "K", "A"};
+  for (int r = 0; r < 13; r++) {
+    if (name == kNames[r]) {
+      return static_cast<cards::Rank>(r);
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<golf_archive::GroupBy> ParseGroupBy(const std::string& name) {
+  using golf_archive::GroupBy;
+  if (name == "none") return GroupBy::kNone;
+  if (name == "players") return GroupBy::kPlayers;
+  if (name == "knocked") return GroupBy::kKnocked;
+  if (name == "draw_left") return GroupBy::kDrawLeft;
+  return std::nullopt;
+}
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+
+  auto path = absl::GetFlag(FLAGS_archive);
+  if (path.empty()) {
+    std::cerr << "--archive is required" << std::endl;
+    return 1;
+  }
+  auto group_by = ParseGroupBy(absl::GetFlag(FLAGS_group_by));
+  if (!group_by) {
+    std::cerr << "--group_by must be none, players, knocked or draw_left" << std::endl;
+    return 1;
+  }
+  golf_archive::Query query{
+      .since_ms = absl::GetFlag(FLAGS_since_ms),
+      .until_ms = absl::GetFlag(FLAGS_until_ms),
+      .min_players = absl::GetFlag(FLAGS_min_players),
+      .max_players = absl::GetFlag(FLAGS_max_players),
+      .min_score = absl::GetFlag(FLAGS_min_score),
+      .max_score = absl::GetFlag(FLAGS_max_score),
+      .group_by = *group_by,
+  };
+  if (auto user = absl::GetFlag(FLAGS_user); !user.empty()) {
+    query.user_id = user;
+  }
+  if (auto holding = absl::GetFlag(FLAGS_holding); !holding.empty()) {
+    query.holding = ParseRank(holding);
+    if (!query.holding) {
+      std::cerr << "--holding must be a rank: 2-10, J, Q, K or A" << std::endl;
+      return 1;
+    }
+  }
+
+  auto result = golf_archive::RunQuery(path, query, absl::GetFlag(FLAGS_threads));
+  if (!result.ok()) {
+    std::cerr << result.status().message() << std::endl;
+    return 1;
+  }
+  std::cout << golf_archive::FormatResult(*result, query.group_by);
+  return 0;
+}
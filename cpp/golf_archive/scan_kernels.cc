@@ -0,0 +1,212 @@
+#include "cpp/golf_archive/scan_kernels.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GOLF_ARCHIVE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace golf_archive::scan_kernels {
+namespace {
+
+// Branch-free, so a compiler can vectorize these on its own where it knows the target.
+
+void scalar_range_i64(const int64_t* v, size_t n, int64_t lo, int64_t hi, uint8_t* mask) {
+  for (size_t i = 0; i < n; i++) {
+    mask[i] &= static_cast<uint8_t>(-static_cast<int>(lo <= v[i] && v[i] <= hi));
+  }
+}
+
+void scalar_range_u8(const uint8_t* v, size_t n, uint8_t lo, uint8_t hi, uint8_t* mask) {
+  for (size_t i = 0; i < n; i++) {
+    mask[i] &= static_cast<uint8_t>(-static_cast<int>(lo <= v[i] && v[i] <= hi));
+  }
+}
+
+void scalar_equal_u16(const uint16_t* v, size_t n, uint16_t x, uint8_t* mask) {
+  for (size_t i = 0; i < n; i++) {
+    mask[i] &= static_cast<uint8_t>(-static_cast<int>(v[i] == x));
+  }
+}
+
+void scalar_holds_any(const uint8_t* hands, size_t n, const uint8_t cards[4], uint8_t* mask) {
+  for (size_t i = 0; i < n; i++) {
+    int hit = 0;
+    for (int k = 0; k < 4; k++) {
+      uint8_t card = hands[4 * i + k];
+      hit |= (card == cards[0]) | (card == cards[1]) | (card == cards[2]) | (card == cards[3]);
+    }
+    mask[i] &= static_cast<uint8_t>(-hit);
+  }
+}
+
+uint64_t scalar_masked_sum(const uint8_t* v, const uint8_t* mask, size_t n) {
+  uint64_t sum = 0;
+  for (size_t i = 0; i < n; i++) {
+    sum += v[i] & mask[i];
+  }
+  return sum;
+}
+
+uint64_t scalar_count(const uint8_t* mask, size_t n) {
+  uint64_t count = 0;
+  for (size_t i = 0; i < n; i++) {
+    count += mask[i] & 1;
+  }
+  return count;
+}
+
+#ifdef GOLF_ARCHIVE_X86_KERNELS
+
+// Mask bytes to AND in for four rows, indexed by a 4-bit movemask whose set bits are rejects.
+constexpr uint32_t KeepBytes(int rejects) {
+  uint32_t keep = 0;
+  for (int k = 0; k < 4; k++) {
+    keep |= ((rejects >> k) & 1) ? 0 : 0xFFu << (8 * k);
+  }
+  return keep;
+}
+constexpr uint32_t kKeepBytes[16] = {
+    KeepBytes(0),  KeepBytes(1),  KeepBytes(2),  KeepBytes(3),  KeepBytes(4),  KeepBytes(5),
+    KeepBytes(6),  KeepBytes(7),  KeepBytes(8),  KeepBytes(9),  KeepBytes(10), KeepBytes(11),
+    KeepBytes(12), KeepBytes(13), KeepBytes(14), KeepBytes(15)};
+
+inline void AndKeep(uint8_t* mask, int rejects) {
+  uint32_t m;
+  std::memcpy(&m, mask, sizeof(m));
+  m &= kKeepBytes[rejects];
+  std::memcpy(mask, &m, sizeof(m));
+}
+
+__attribute__((target("avx2"))) uint64_t SumLanes(__m256i x) {
+  __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+  return static_cast<uint64_t>(_mm_cvtsi128_si64(sum)) +
+         static_cast<uint64_t>(_mm_extract_epi64(sum, 1));
+}
+
+__attribute__((target("avx2"))) void avx2_range_i64(const int64_t* v, size_t n, int64_t lo,
+                                                     int64_t hi, uint8_t* mask) {
+  const __m256i low = _mm256_set1_epi64x(lo);
+  const __m256i high = _mm256_set1_epi64x(hi);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i));
+    __m256i out = _mm256_or_si256(_mm256_cmpgt_epi64(low, x), _mm256_cmpgt_epi64(x, high));
+    AndKeep(mask + i, _mm256_movemask_pd(_mm256_castsi256_pd(out)));
+  }
+  scalar_range_i64(v + i, n - i, lo, hi, mask + i);
+}
+
+__attribute__((target("avx2"))) void avx2_range_u8(const uint8_t* v, size_t n, uint8_t lo,
+                                                    uint8_t hi, uint8_t* mask) {
+  const __m256i low = _mm256_set1_epi8(static_cast<char>(lo));
+  const __m256i high = _mm256_set1_epi8(static_cast<char>(hi));
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i));
+    // Unsigned lo <= x <= hi, as max(x, lo) == x and min(x, hi) == x.
+    __m256i in = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(x, low), x),
+                                  _mm256_cmpeq_epi8(_mm256_min_epu8(x, high), x));
+    auto* m = reinterpret_cast<__m256i*>(mask + i);
+    _mm256_storeu_si256(m, _mm256_and_si256(_mm256_loadu_si256(m), in));
+  }
+  scalar_range_u8(v + i, n - i, lo, hi, mask + i);
+}
+
+__attribute__((target("avx2"))) void avx2_equal_u16(const uint16_t* v, size_t n, uint16_t x,
+                                                     uint8_t* mask) {
+  const __m256i wanted = _mm256_set1_epi16(static_cast<short>(x));
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i eq = _mm256_cmpeq_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i)),
+                                    wanted);
+    // Packing works within 128-bit halves; the permute brings both halves' bytes together.
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(eq, eq), _MM_SHUFFLE(3, 1, 2, 0));
+    auto* m = reinterpret_cast<__m128i*>(mask + i);
+    _mm_storeu_si128(m, _mm_and_si128(_mm_loadu_si128(m), _mm256_castsi256_si128(packed)));
+  }
+  scalar_equal_u16(v + i, n - i, x, mask + i);
+}
+
+__attribute__((target("avx2"))) void avx2_holds_any(const uint8_t* hands, size_t n,
+                                                     const uint8_t cards[4], uint8_t* mask) {
+  __m256i wanted[4];
+  for (int k = 0; k < 4; k++) {
+    wanted[k] = _mm256_set1_epi8(static_cast<char>(cards[k]));
+  }
+  const __m256i zero = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hands + 4 * i));
+    __m256i hit = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(x, wanted[0]), _mm256_cmpeq_epi8(x, wanted[1])),
+        _mm256_or_si256(_mm256_cmpeq_epi8(x, wanted[2]), _mm256_cmpeq_epi8(x, wanted[3])));
+    // One 32-bit lane per player: all zero means no card in the hand matched.
+    int misses = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(hit, zero)));
+    AndKeep(mask + i, misses & 0xF);
+    AndKeep(mask + i + 4, misses >> 4);
+  }
+  scalar_holds_any(hands + 4 * i, n - i, cards, mask + i);
+}
+
+__attribute__((target("avx2"))) uint64_t avx2_masked_sum(const uint8_t* v, const uint8_t* mask,
+                                                         size_t n) {
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i sum = zero;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(v + i)),
+                                 _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + i)));
+    sum = _mm256_add_epi64(sum, _mm256_sad_epu8(x, zero));
+  }
+  return SumLanes(sum) + scalar_masked_sum(v + i, mask + i, n - i);
+}
+
+__attribute__((target("avx2"))) uint64_t avx2_count(const uint8_t* mask, size_t n) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i one = _mm256_set1_epi8(1);
+  __m256i sum = zero;
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i x =
+        _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + i)), one);
+    sum = _mm256_add_epi64(sum, _mm256_sad_epu8(x, zero));
+  }
+  return SumLanes(sum) + scalar_count(mask + i, n - i);
+}
+
+#endif
+}  // namespace
+
+const Kernels& scalar() {
+  static const Kernels kernels{scalar_range_i64, scalar_range_u8,   scalar_equal_u16,
+                               scalar_holds_any, scalar_masked_sum, scalar_count};
+  return kernels;
+}
+
+#ifdef GOLF_ARCHIVE_X86_KERNELS
+
+const Kernels& avx2() {
+  static const Kernels kernels{avx2_range_i64, avx2_range_u8,   avx2_equal_u16,
+                               avx2_holds_any, avx2_masked_sum, avx2_count};
+  return kernels;
+}
+
+bool supports_avx2() { return __builtin_cpu_supports("avx2"); }
+
+#else
+
+const Kernels& avx2() { return scalar(); }
+
+bool supports_avx2() { return false; }
+
+#endif
+
+const Kernels& dispatch() {
+  static const Kernels& kernels = supports_avx2() ? avx2() : scalar();
+  return kernels;
+}
+
+}  // namespace golf_archive::scan_kernels
@@ -0,0 +1,38 @@
+#ifndef CPP_GOLF_ARCHIVE_SCAN_KERNELS_H
+#define CPP_GOLF_ARCHIVE_SCAN_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Filter and aggregate kernels behind archive queries, over the plain columns of a decoded Block.
+// A selection mask holds one byte per row, 0xFF if the row is selected and 0 if not; each filter
+// clears the bytes of rows that fail it and leaves the others alone.
+namespace golf_archive::scan_kernels {
+
+struct Kernels {
+  // Keeps rows with lo <= v[i] <= hi.
+  void (*range_i64)(const int64_t* v, size_t n, int64_t lo, int64_t hi, uint8_t* mask);
+  void (*range_u8)(const uint8_t* v, size_t n, uint8_t lo, uint8_t hi, uint8_t* mask);
+  // Keeps rows with v[i] == x.
+  void (*equal_u16)(const uint16_t* v, size_t n, uint16_t x, uint8_t* mask);
+  // Keeps players (4 hand bytes each) holding at least one of `cards`; repeat a card to look for
+  // fewer than four.
+  void (*holds_any)(const uint8_t* hands, size_t n, const uint8_t cards[4], uint8_t* mask);
+  // Sum of v[i] over selected rows.
+  uint64_t (*masked_sum)(const uint8_t* v, const uint8_t* mask, size_t n);
+  // Number of selected rows.
+  uint64_t (*count)(const uint8_t* mask, size_t n);
+};
+
+const Kernels& scalar();
+// Only vectorized on x86-64 GCC/Clang builds; use only when supports_avx2() is true.
+const Kernels& avx2();
+
+bool supports_avx2();
+
+// The widest kernels this CPU supports, chosen once on first use.
+const Kernels& dispatch();
+
+}  // namespace golf_archive::scan_kernels
+
+#endif
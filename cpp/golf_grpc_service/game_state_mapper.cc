@@ -0,0 +1,68 @@
+#include "cpp/golf_grpc_service/game_state_mapper.h"
+
+#include <string>
+
+#include "cpp/cards/card.h"
+
+namespace golf_grpc_service {
+using golf::GameStatePtr;
+using golf::Player;
+using std::string;
+
+golf_grpc::GameState GameStateMapper::gameStateToProto(const GameStatePtr& state,
+                                                       const string& user_id) const {
+  golf_grpc::GameState proto;
+  proto.set_all_here(state->allPlayersPresent());
+  proto.set_discard_size(state->getDiscardPile().size());
+  proto.set_draw_size(state->getDrawPile().size());
+  proto.set_game_id(state->getGameId());
+  proto.set_version(state->getVersionId());
+  proto.set_game_over(state->isOver());
+
+  int knockIndex = state->getWhoKnocked();
+  if (knockIndex != -1) {
+    const Player& knocker = state->getPlayer(knockIndex);
+    if (knocker.getName().has_value()) {
+      proto.set_knocker(knocker.getName().value());
+    }
+  }
+
+  for (auto& p : state->getPlayers()) {
+    if (p.getName().has_value()) {
+      proto.add_players(p.getName().value());
+    }
+  }
+
+  const int index = state->playerIndex(user_id);
+  if (index != -1) {
+    const auto& cards = state->getPlayer(index).allCards();
+
+    // parent proto will take ownership and free this appropriately
+    auto hand = new golf_grpc::VisibleHand;
+    hand->set_bottom_left(card_mapper.cardToString(cards.at(2)));
+    hand->set_bottom_right(card_mapper.cardToString(cards.at(3)));
+    proto.set_allocated_hand(hand);
+  }
+  proto.set_number_of_players(state->getPlayers().size());
+
+  if (state->isOver()) {
+    for (auto& p : state->getPlayers()) {
+      proto.add_scores(p.score());
+    }
+  }
+
+  if (!state->getDiscardPile().empty()) {
+    proto.set_top_discard(card_mapper.cardToString(state->getDiscardPile().back()));
+  }
+
+  if (index != -1 && state->getPeekedAtDrawPile() && state->getWhoseTurn() == index) {
+    proto.set_top_draw(card_mapper.cardToString(state->getDrawPile().back()));
+  }
+
+  proto.set_your_turn(index != -1 && state->getWhoseTurn() == index);
+  proto.set_legal_actions(state->legalActions(index));
+
+  return proto;
+}
+
+}  // namespace golf_grpc_service
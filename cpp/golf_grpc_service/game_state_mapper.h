@@ -0,0 +1,23 @@
+#ifndef CPP_GOLF_GRPC_SERVICE_GAME_STATE_MAPPER_H
+#define CPP_GOLF_GRPC_SERVICE_GAME_STATE_MAPPER_H
+
+#include <string>
+
+#include "cpp/cards/card_mapper.h"
+#include "cpp/cards/golf/golf.h"
+#include "protos/golf_grpc/golf.pb.h"
+
+namespace golf_grpc_service {
+
+class GameStateMapper {
+ public:
+  explicit GameStateMapper(const cards::CardMapper _cm) : card_mapper(_cm) {}
+  golf_grpc::GameState gameStateToProto(const golf::GameStatePtr& gameStatePtr,
+                                        const std::string& user_id) const;
+
+ private:
+  const cards::CardMapper card_mapper;
+};
+}  // namespace golf_grpc_service
+
+#endif
@@ -0,0 +1,107 @@
+#include "cpp/golf_grpc_service/game_watchers.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace golf_grpc_service {
+using golf::GameStatePtr;
+using std::string;
+
+// StartWrite and Finish never run reactions inline, so they are safe to call with mutex_ held.
+// Holding it guarantees no write is started after the stream has been finished.
+void GameWatcher::Push(golf_grpc::GameState state, uint64_t commit_seq) {
+  std::scoped_lock lock{mutex_};
+  if (finished_ || (last_commit_seq_.has_value() && commit_seq <= *last_commit_seq_)) {
+    return;
+  }
+  last_commit_seq_ = commit_seq;
+  if (write_in_flight_) {
+    pending_ = std::move(state);  // coalesce: the client only needs the newest state
+    return;
+  }
+  write_in_flight_ = true;
+  in_flight_ = std::move(state);
+  StartWrite(&in_flight_);
+}
+
+void GameWatcher::OnWriteDone(bool ok) {
+  std::scoped_lock lock{mutex_};
+  if (!ok) {
+    FinishLocked(grpc::Status(grpc::StatusCode::UNAVAILABLE, "stream closed"));
+    return;
+  }
+  if (pending_.has_value()) {
+    in_flight_ = std::move(*pending_);
+    pending_.reset();
+    StartWrite(&in_flight_);
+    return;
+  }
+  write_in_flight_ = false;
+  if (in_flight_.game_over()) {
+    FinishLocked(grpc::Status::OK);
+  }
+}
+
+void GameWatcher::OnCancel() {
+  std::scoped_lock lock{mutex_};
+  FinishLocked(grpc::Status::CANCELLED);
+}
+
+void GameWatcher::OnDone() {
+  registry_->Remove(this);
+  delete this;
+}
+
+void GameWatcher::FinishLocked(const grpc::Status& status) {
+  if (finished_) {
+    return;
+  }
+  finished_ = true;
+  pending_.reset();
+  Finish(status);
+}
+
+grpc::ServerWriteReactor<golf_grpc::GameState>* GameWatchers::Watch(const GameStatePtr& current,
+                                                                   const string& user_id,
+                                                                   uint64_t commit_seq) {
+  auto watcher = new GameWatcher(this, user_id, current->getGameId());
+  {
+    std::scoped_lock lock{mutex_};
+    watchers_by_game_id_[current->getGameId()].push_back(watcher);
+    watcher->Push(mapper_.gameStateToProto(current, user_id), commit_seq);
+  }
+  return watcher;
+}
+
+void GameWatchers::Publish(const GameStatePtr& state, uint64_t commit_seq) {
+  std::scoped_lock lock{mutex_};
+  auto it = watchers_by_game_id_.find(state->getGameId());
+  if (it == watchers_by_game_id_.end()) {
+    return;
+  }
+  for (auto watcher : it->second) {
+    watcher->Push(mapper_.gameStateToProto(state, watcher->getUserId()), commit_seq);
+  }
+}
+
+size_t GameWatchers::WatcherCount(const string& game_id) {
+  std::scoped_lock lock{mutex_};
+  auto it = watchers_by_game_id_.find(game_id);
+  return it == watchers_by_game_id_.end() ? 0 : it->second.size();
+}
+
+void GameWatchers::Remove(GameWatcher* watcher) {
+  std::scoped_lock lock{mutex_};
+  auto it = watchers_by_game_id_.find(watcher->getGameId());
+  if (it == watchers_by_game_id_.end()) {
+    return;
+  }
+  auto& watchers = it->second;
+  watchers.erase(std::remove(watchers.begin(), watchers.end(), watcher), watchers.end());
+  if (watchers.empty()) {
+    watchers_by_game_id_.erase(it);
+  }
+}
+
+}  // namespace golf_grpc_service
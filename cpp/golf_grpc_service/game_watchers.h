@@ -0,0 +1,80 @@
+#ifndef CPP_GOLF_GRPC_SERVICE_GAME_WATCHERS_H
+#define CPP_GOLF_GRPC_SERVICE_GAME_WATCHERS_H
+
+#include <grpcpp/grpcpp.h>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/golf_grpc_service/game_state_mapper.h"
+#include "protos/golf_grpc/golf.pb.h"
+
+namespace golf_grpc_service {
+
+class GameWatchers;
+
+// One open WatchGame stream. Idle watchers hold no thread and no pending write: updates are
+// pushed by whichever thread committed the move, and at most one write is in flight per stream.
+// If updates arrive faster than the client reads, only the latest unsent state is kept.
+// Commits are published after the GameManager lock is released, so they can reach a watcher out
+// of order; anything older than what the watcher already has is dropped by commit sequence.
+class GameWatcher final : public grpc::ServerWriteReactor<golf_grpc::GameState> {
+ public:
+  GameWatcher(GameWatchers* registry, std::string user_id, std::string game_id)
+      : registry_(registry), user_id_(std::move(user_id)), game_id_(std::move(game_id)) {}
+
+  void Push(golf_grpc::GameState state, uint64_t commit_seq);
+  void OnWriteDone(bool ok) override;
+  void OnCancel() override;
+  void OnDone() override;
+
+  [[nodiscard]] const std::string& getUserId() const { return user_id_; }
+  [[nodiscard]] const std::string& getGameId() const { return game_id_; }
+
+ private:
+  void FinishLocked(const grpc::Status& status);
+
+  GameWatchers* registry_;
+  const std::string user_id_;
+  const std::string game_id_;
+
+  std::mutex mutex_;
+  golf_grpc::GameState in_flight_;
+  std::optional<golf_grpc::GameState> pending_;
+  std::optional<uint64_t> last_commit_seq_;
+  bool write_in_flight_ = false;
+  bool finished_ = false;
+};
+
+// Per-game subscriber lists for WatchGame. Thread-safe.
+class GameWatchers {
+ public:
+  explicit GameWatchers(GameStateMapper mapper) : mapper_(std::move(mapper)) {}
+
+  // Registers a new stream and sends it the current state of the game, as of commit_seq.
+  grpc::ServerWriteReactor<golf_grpc::GameState>* Watch(const golf::GameStatePtr& current,
+                                                        const std::string& user_id,
+                                                        uint64_t commit_seq);
+
+  // Pushes a committed state to every watcher of that game.
+  void Publish(const golf::GameStatePtr& state, uint64_t commit_seq);
+
+  [[nodiscard]] size_t WatcherCount(const std::string& game_id);
+
+ private:
+  friend class GameWatcher;
+  void Remove(GameWatcher* watcher);
+
+  const GameStateMapper mapper_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<GameWatcher*>> watchers_by_game_id_;
+};
+
+}  // namespace golf_grpc_service
+
+#endif
@@ -2,56 +2,380 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "absl/status/statusor.h"
 #include "protos/golf_grpc/golf.pb.h"
 
 using golf_grpc::DiscardDrawRequest;
 using golf_grpc::DiscardDrawResponse;
+using golf_grpc::FillWithBotsRequest;
+using golf_grpc::FillWithBotsResponse;
+using golf_grpc::JoinGameRequest;
+using golf_grpc::JoinGameResponse;
 using golf_grpc::KnockRequest;
 using golf_grpc::KnockResponse;
+using golf_grpc::Move;
+using golf_grpc::MoveType;
 using golf_grpc::NewGameRequest;
 using golf_grpc::NewGameResponse;
 using golf_grpc::PeekRequest;
 using golf_grpc::PeekResponse;
+using golf_grpc::PlayGameRequest;
 using golf_grpc::RegisterUserRequest;
 using golf_grpc::RegisterUserResponse;
+using golf_grpc::ResponseWrapper;
+using golf_grpc::StartPlaying;
 using golf_grpc::SwapForDiscardRequest;
 using golf_grpc::SwapForDiscardResponse;
 using golf_grpc::SwapForDrawRequest;
 using golf_grpc::SwapForDrawResponse;
+using golf_grpc::WatchGameRequest;
+using golf_grpc_service::GameStateMapper;
+using golf_grpc_service::GameWatchers;
+using golf_pipeline::BotDriver;
+using golf_pipeline::BotStage;
+using golf_pipeline::Command;
+using golf_pipeline::CommandType;
+using golf_pipeline::Exchange;
+using golf_pipeline::ExecuteStage;
+using golf_pipeline::RateLimitStage;
+using golf_pipeline::Stage;
+using grpc::CallbackServerContext;
+using grpc::ServerBidiReactor;
 using grpc::ServerContext;
+using grpc::ServerWriteReactor;
 using grpc::Status;
 
+namespace {
+Status ToGrpcStatus(const absl::Status& status) {
+  return Status(static_cast<grpc::StatusCode>(status.code()), std::string(status.message()));
+}
+
+absl::StatusOr<golf::Position> ToPosition(golf_grpc::Position position) {
+  switch (position) {
+    case golf_grpc::Position::TOP_LEFT:
+      return golf::Position::TopLeft;
+    case golf_grpc::Position::TOP_RIGHT:
+      return golf::Position::TopRight;
+    case golf_grpc::Position::BOTTOM_LEFT:
+      return golf::Position::BottomLeft;
+    case golf_grpc::Position::BOTTOM_RIGHT:
+      return golf::Position::BottomRight;
+    default:
+      return absl::InvalidArgumentError("invalid position");
+  }
+}
+
+// A WatchGame stream that fails before it is registered.
+class RejectedWatch final : public ServerWriteReactor<golf_grpc::GameState> {
+ public:
+  explicit RejectedWatch(const Status& status) { Finish(status); }
+  void OnDone() override { delete this; }
+};
+
+// Writes the caller's view of the committed state into its reply slot.
+class GrpcEncodeStage final : public Stage<GrpcReplySlot> {
+ public:
+  explicit GrpcEncodeStage(const GameStateMapper& mapper) : mapper_(mapper) {}
+
+  void process(std::span<Exchange<GrpcReplySlot>> batch) override {
+    for (auto& exchange : batch) {
+      if (exchange.ok() && exchange.game_state != nullptr && exchange.origin != nullptr) {
+        *exchange.origin = mapper_.gameStateToProto(exchange.game_state, exchange.command.user_id);
+      }
+    }
+  }
+
+ private:
+  const GameStateMapper& mapper_;
+};
+
+// Fans committed states out to WatchGame subscribers.
+class GrpcPublishStage final : public Stage<GrpcReplySlot> {
+ public:
+  explicit GrpcPublishStage(GameWatchers& watchers) : watchers_(watchers) {}
+
+  void process(std::span<Exchange<GrpcReplySlot>> batch) override {
+    for (auto& exchange : batch) {
+      if (exchange.ok() && exchange.game_state != nullptr) {
+        watchers_.Publish(exchange.game_state, exchange.commit_seq);
+      }
+    }
+  }
+
+ private:
+  GameWatchers& watchers_;
+};
+}  // namespace
+
+GolfServiceImpl::GolfServiceImpl(std::shared_ptr<golf::GameStoreInterface> game_store,
+                                 std::shared_ptr<golf_pipeline::RateLimiter> limiter)
+    : execute(std::make_shared<ExecuteStage<GrpcReplySlot>>(
+          std::make_shared<golf::GameManager>(std::move(game_store)))),
+      watchers(GameStateMapper{{}}),
+      bots(std::make_shared<BotDriver<GrpcReplySlot>>(
+          execute,
+          [this](const Exchange<GrpcReplySlot>& exchange) {
+            watchers.Publish(exchange.game_state, exchange.commit_seq);
+          })),
+      pipeline({std::make_shared<RateLimitStage<GrpcReplySlot>>(std::move(limiter)), execute,
+                std::make_shared<GrpcEncodeStage>(gameStateMapper),
+                std::make_shared<GrpcPublishStage>(watchers),
+                std::make_shared<BotStage<GrpcReplySlot>>(bots)}) {}
+
+Status GolfServiceImpl::run(Command command, golf_grpc::GameState* out) {
+  Exchange<GrpcReplySlot> exchange{out, std::move(command)};
+  pipeline.process(exchange);
+  return ToGrpcStatus(exchange.status);
+}
+
 Status GolfServiceImpl::RegisterUser(ServerContext* context, const RegisterUserRequest* request,
                                      RegisterUserResponse* response) {
-  return Status::OK;
+  return run({CommandType::RegisterUser, request->user_id()}, nullptr);
 };
 
 Status GolfServiceImpl::NewGame(ServerContext* context, const NewGameRequest* request,
                                 NewGameResponse* response) {
-  return Status::OK;
+  return run({CommandType::NewGame, request->user_id(), "", request->number_of_players()},
+             response->mutable_game_state());
+};
+
+Status GolfServiceImpl::JoinGame(ServerContext* context, const JoinGameRequest* request,
+                                 JoinGameResponse* response) {
+  return run({CommandType::JoinGame, request->user_id(), request->game_id()},
+             response->mutable_game_state());
 };
 
 Status GolfServiceImpl::Peek(ServerContext* context, const PeekRequest* request,
                              PeekResponse* response) {
-  return Status::OK;
+  return run({CommandType::Peek, request->user_id(), request->game_id()},
+             response->mutable_game_state());
 };
 
 Status GolfServiceImpl::DiscardDraw(ServerContext* context, const DiscardDrawRequest* request,
                                     DiscardDrawResponse* response) {
-  return Status::OK;
+  return run({CommandType::DiscardDraw, request->user_id(), request->game_id()},
+             response->mutable_game_state());
 };
 
 Status GolfServiceImpl::SwapForDraw(ServerContext* context, const SwapForDrawRequest* request,
                                     SwapForDrawResponse* response) {
-  return Status::OK;
+  auto position = ToPosition(request->position());
+  if (!position.ok()) {
+    return ToGrpcStatus(position.status());
+  }
+  return run({CommandType::SwapForDraw, request->user_id(), request->game_id(), 0, *position},
+             response->mutable_game_state());
 };
 
 Status GolfServiceImpl::SwapForDiscard(ServerContext* context, const SwapForDiscardRequest* request,
                                        SwapForDiscardResponse* response) {
-  return Status::OK;
+  auto position = ToPosition(request->position());
+  if (!position.ok()) {
+    return ToGrpcStatus(position.status());
+  }
+  return run({CommandType::SwapForDiscard, request->user_id(), request->game_id(), 0, *position},
+             response->mutable_game_state());
 };
 
 Status GolfServiceImpl::Knock(ServerContext* context, const KnockRequest* request,
                               KnockResponse* response) {
+  return run({CommandType::Knock, request->user_id(), request->game_id()},
+             response->mutable_game_state());
+};
+
+Status GolfServiceImpl::FillWithBots(ServerContext* context, const FillWithBotsRequest* request,
+                                     FillWithBotsResponse* response) {
+  auto res = bots->fillSeats(request->user_id(), request->game_id());
+  if (!res.ok()) {
+    return ToGrpcStatus(res.status());
+  }
+  *response->mutable_game_state() = gameStateMapper.gameStateToProto(*res, request->user_id());
   return Status::OK;
+}
+
+ServerWriteReactor<golf_grpc::GameState>* GolfServiceImpl::WatchGame(
+    CallbackServerContext* context, const WatchGameRequest* request) {
+  // registering inside the execute lock means no commit can slip between the snapshot and the
+  // subscription
+  return execute->withGameManager(
+      [&](golf::GameManager& gm,
+          uint64_t commit_seq) -> ServerWriteReactor<golf_grpc::GameState>* {
+        auto res = gm.getGameStateForUser(request->game_id(), request->user_id());
+        if (!res.ok()) {
+          return new RejectedWatch(ToGrpcStatus(res.status()));
+        }
+        return watchers.Watch(*res, request->user_id(), commit_seq);
+      });
+}
+
+// One PlayGame stream. The first message must be StartPlaying; after that each Move is applied
+// as the authenticated user and answered on the same stream, in order. Reads run ahead of writes
+// by at most kMaxQueuedResponses so a client that stops reading cannot grow the queue unbounded.
+class PlayGameSession final : public ServerBidiReactor<PlayGameRequest, ResponseWrapper> {
+ public:
+  explicit PlayGameSession(GolfServiceImpl* service) : service_(service) { StartRead(&request_); }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      std::scoped_lock lock{mutex_};
+      reads_done_ = true;
+      maybeFinishLocked();
+      return;
+    }
+
+    // held while the command runs, so a write that fails meanwhile finishes the stream only after
+    // the move has been answered
+    std::scoped_lock lock{mutex_};
+    if (finished_) {
+      // a failed write already finished the stream; don't apply a move nobody will hear about
+      return;
+    }
+    ResponseWrapper response;
+    if (request_.has_id()) {
+      response.set_id(request_.id());
+    }
+    Status status = handle(response.mutable_game_state());
+    if (!status.ok()) {
+      response.mutable_error()->set_message(status.error_message());
+    }
+    if (!user_id_.has_value()) {
+      // never authenticated: close the stream instead of answering
+      reads_done_ = true;
+      finishLocked(status);
+      return;
+    }
+    responses_.push_back(std::move(response));
+    if (!writing_) {
+      writing_ = true;
+      StartWrite(&responses_.front());  // deque::push_back keeps references to front valid
+    }
+    if (responses_.size() < kMaxQueuedResponses) {
+      StartRead(&request_);
+    } else {
+      read_paused_ = true;
+    }
+  }
+
+  void OnWriteDone(bool ok) override {
+    std::scoped_lock lock{mutex_};
+    responses_.pop_front();
+    if (!ok) {
+      writing_ = false;
+      finishLocked(Status(grpc::StatusCode::UNAVAILABLE, "stream closed"));
+      return;
+    }
+    if (responses_.empty()) {
+      writing_ = false;
+    } else {
+      StartWrite(&responses_.front());
+    }
+    if (read_paused_ && !finished_) {
+      read_paused_ = false;
+      StartRead(&request_);
+    }
+    maybeFinishLocked();
+  }
+
+  void OnDone() override { delete this; }
+
+ private:
+  static constexpr size_t kMaxQueuedResponses = 16;
+
+  Status handle(golf_grpc::GameState* out) {
+    if (!user_id_.has_value()) {
+      if (request_.kind_case() != PlayGameRequest::kStart) {
+        return Status(grpc::StatusCode::UNAUTHENTICATED, "first message must be start");
+      }
+      Status status = service_->startPlaying(request_.start(), out);
+      if (status.ok()) {
+        user_id_ = request_.start().user_id();
+        game_id_ = request_.start().game_id();
+      }
+      return status;
+    }
+    if (request_.kind_case() != PlayGameRequest::kMove) {
+      return Status(grpc::StatusCode::INVALID_ARGUMENT, "expected a move");
+    }
+    return service_->playMove(*game_id_, *user_id_, request_.move(), out);
+  }
+
+  void maybeFinishLocked() {
+    if (reads_done_ && !writing_) {
+      finishLocked(Status::OK);
+    }
+  }
+
+  void finishLocked(const Status& status) {
+    if (finished_) {
+      return;
+    }
+    finished_ = true;
+    Finish(status);
+  }
+
+  GolfServiceImpl* service_;
+  PlayGameRequest request_;
+  std::optional<std::string> user_id_;
+  std::optional<std::string> game_id_;
+
+  std::mutex mutex_;
+  std::deque<ResponseWrapper> responses_;
+  bool writing_ = false;
+  bool read_paused_ = false;
+  bool reads_done_ = false;
+  bool finished_ = false;
 };
+
+ServerBidiReactor<PlayGameRequest, ResponseWrapper>* GolfServiceImpl::PlayGame(
+    CallbackServerContext* context) {
+  return new PlayGameSession(this);
+}
+
+Status GolfServiceImpl::startPlaying(const StartPlaying& start, golf_grpc::GameState* out) {
+  return execute->withGameManager([&](golf::GameManager& gm, uint64_t) -> Status {
+    auto res = gm.getGameStateForUser(start.game_id(), start.user_id());
+    if (!res.ok()) {
+      return Status(grpc::StatusCode::UNAUTHENTICATED, std::string(res.status().message()));
+    }
+    *out = gameStateMapper.gameStateToProto(*res, start.user_id());
+    return Status::OK;
+  });
+}
+
+Status GolfServiceImpl::playMove(const std::string& game_id, const std::string& user_id,
+                                 const Move& move, golf_grpc::GameState* out) {
+  Command command{CommandType::Peek, user_id, game_id};
+  switch (move.type()) {
+    case MoveType::PEEK:
+      command.type = CommandType::Peek;
+      break;
+    case MoveType::DISCARD_DRAW:
+      command.type = CommandType::DiscardDraw;
+      break;
+    case MoveType::SWAP_FOR_DRAW:
+      command.type = CommandType::SwapForDraw;
+      break;
+    case MoveType::SWAP_FOR_DISCARD:
+      command.type = CommandType::SwapForDiscard;
+      break;
+    case MoveType::KNOCK:
+      command.type = CommandType::Knock;
+      break;
+    default:
+      return Status(grpc::StatusCode::INVALID_ARGUMENT, "invalid move");
+  }
+  if (command.type == CommandType::SwapForDraw || command.type == CommandType::SwapForDiscard) {
+    auto position = ToPosition(move.position());
+    if (!position.ok()) {
+      return ToGrpcStatus(position.status());
+    }
+    command.position = *position;
+  }
+  return run(std::move(command), out);
+}
@@ -1,14 +1,47 @@
 #ifndef CPP_GOLF_GRPC_GOLF_GRPC_SERVICE_H
 #define CPP_GOLF_GRPC_GOLF_GRPC_SERVICE_H
 
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "cpp/cards/golf/game_store.h"
+#include "cpp/golf_grpc_service/game_state_mapper.h"
+#include "cpp/golf_grpc_service/game_watchers.h"
+#include "cpp/golf_pipeline/bot_driver.h"
+#include "cpp/golf_pipeline/command.h"
+#include "cpp/golf_pipeline/execute_stage.h"
+#include "cpp/golf_pipeline/pipeline.h"
+#include "cpp/golf_pipeline/rate_limit_stage.h"
 #include "protos/golf_grpc/golf.grpc.pb.h"
 
-class GolfServiceImpl final : public golf_grpc::Golf::Service {
+typedef golf_grpc::Golf::WithCallbackMethod_PlayGame<
+    golf_grpc::Golf::WithCallbackMethod_WatchGame<golf_grpc::Golf::Service>>
+    GolfServiceBase;
+
+// Where the pipeline writes the caller's view of the game. Null for RegisterUser.
+typedef golf_grpc::GameState* GrpcReplySlot;
+
+// Unary RPCs are served by the sync thread pool. The streaming RPCs use the callback API so that
+// an idle stream costs only its reactor, not a thread. Every RPC is a thin adapter that decodes
+// its request into a golf_pipeline::Command and runs it through the shared pipeline, where each
+// user's commands are rate limited by `limiter`.
+class GolfServiceImpl final : public GolfServiceBase {
+ public:
+  explicit GolfServiceImpl(std::shared_ptr<golf::GameStoreInterface> game_store,
+                           std::shared_ptr<golf_pipeline::RateLimiter> limiter =
+                               std::make_shared<golf_pipeline::RateLimiter>(
+                                   golf_pipeline::RateLimiter::kDefaultCommandsPerSecond,
+                                   golf_pipeline::RateLimiter::kDefaultBurst));
+
+ private:
   grpc::Status RegisterUser(grpc::ServerContext* context,
                             const golf_grpc::RegisterUserRequest* request,
                             golf_grpc::RegisterUserResponse* response) override;
   grpc::Status NewGame(grpc::ServerContext* context, const golf_grpc::NewGameRequest* request,
                        golf_grpc::NewGameResponse* response) override;
+  grpc::Status JoinGame(grpc::ServerContext* context, const golf_grpc::JoinGameRequest* request,
+                        golf_grpc::JoinGameResponse* response) override;
   grpc::Status Peek(grpc::ServerContext* context, const golf_grpc::PeekRequest* request,
                     golf_grpc::PeekResponse* response) override;
   grpc::Status DiscardDraw(grpc::ServerContext* context,
@@ -22,6 +55,28 @@ class GolfServiceImpl final : public golf_grpc::Golf::Service {
                               golf_grpc::SwapForDiscardResponse* response) override;
   grpc::Status Knock(grpc::ServerContext* context, const golf_grpc::KnockRequest* request,
                      golf_grpc::KnockResponse* response) override;
+  grpc::Status FillWithBots(grpc::ServerContext* context,
+                            const golf_grpc::FillWithBotsRequest* request,
+                            golf_grpc::FillWithBotsResponse* response) override;
+  grpc::ServerWriteReactor<golf_grpc::GameState>* WatchGame(
+      grpc::CallbackServerContext* context, const golf_grpc::WatchGameRequest* request) override;
+  grpc::ServerBidiReactor<golf_grpc::PlayGameRequest, golf_grpc::ResponseWrapper>* PlayGame(
+      grpc::CallbackServerContext* context) override;
+
+  friend class PlayGameSession;
+  // Checks once per PlayGame stream that the user is seated in the game.
+  grpc::Status startPlaying(const golf_grpc::StartPlaying& start, golf_grpc::GameState* out);
+  grpc::Status playMove(const std::string& game_id, const std::string& user_id,
+                        const golf_grpc::Move& move, golf_grpc::GameState* out);
+
+  grpc::Status run(golf_pipeline::Command command, golf_grpc::GameState* out);
+
+  std::shared_ptr<golf_pipeline::ExecuteStage<GrpcReplySlot>> execute;
+  golf_grpc_service::GameStateMapper gameStateMapper{{}};
+  golf_grpc_service::GameWatchers watchers;
+  // Declared after watchers, which its publish callback uses, so that it stops first.
+  std::shared_ptr<golf_pipeline::BotDriver<GrpcReplySlot>> bots;
+  golf_pipeline::Pipeline<GrpcReplySlot> pipeline;
 };
 
 #endif
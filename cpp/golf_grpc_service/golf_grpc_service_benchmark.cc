@@ -0,0 +1,122 @@
+// Moves per second over a single connection: one unary RPC per move vs. one PlayGame stream per
+// player. Both paths alternate SWAP_FOR_DISCARD between two players, which never ends the game.
+#include <benchmark/benchmark.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+
+#include <memory>
+#include <string>
+
+#include "cpp/cards/golf/in_memory_game_store.h"
+#include "cpp/golf_grpc_service/golf_grpc_service.h"
+#include "protos/golf_grpc/golf.grpc.pb.h"
+
+using golf_grpc::Golf;
+using golf_grpc::MoveType;
+using golf_grpc::PlayGameRequest;
+using golf_grpc::ResponseWrapper;
+using grpc::ClientContext;
+using grpc::Server;
+using grpc::ServerBuilder;
+
+namespace {
+struct Table {
+  // One pair of users plays as fast as it can, so no rate limit.
+  GolfServiceImpl service{std::make_shared<golf::InMemoryGameStore>(),
+                          std::make_shared<golf_pipeline::RateLimiter>(1e9, 1e9)};
+  std::unique_ptr<Server> server;
+  std::unique_ptr<Golf::Stub> stub;
+  std::string game_id;
+
+  Table() {
+    ServerBuilder builder;
+    builder.RegisterService(&service);
+    server = builder.BuildAndStart();
+    stub = Golf::NewStub(server->InProcessChannel({}));
+
+    for (auto user : {"alice", "bobby"}) {
+      ClientContext context;
+      golf_grpc::RegisterUserRequest req;
+      req.set_user_id(user);
+      golf_grpc::RegisterUserResponse res;
+      stub->RegisterUser(&context, req, &res);
+    }
+
+    ClientContext new_game_context;
+    golf_grpc::NewGameRequest new_game_req;
+    new_game_req.set_user_id("alice");
+    new_game_req.set_number_of_players(2);
+    golf_grpc::NewGameResponse new_game_res;
+    stub->NewGame(&new_game_context, new_game_req, &new_game_res);
+    game_id = new_game_res.game_state().game_id();
+
+    ClientContext join_context;
+    golf_grpc::JoinGameRequest join_req;
+    join_req.set_user_id("bobby");
+    join_req.set_game_id(game_id);
+    golf_grpc::JoinGameResponse join_res;
+    stub->JoinGame(&join_context, join_req, &join_res);
+  }
+
+  ~Table() { server->Shutdown(); }
+};
+}  // namespace
+
+static void BM_UnaryMoves(benchmark::State& state) {
+  Table table;
+  const std::string players[] = {"alice", "bobby"};
+  int turn = 0;
+  for (auto _ : state) {
+    ClientContext context;
+    golf_grpc::SwapForDiscardRequest req;
+    req.set_user_id(players[turn]);
+    req.set_game_id(table.game_id);
+    req.set_position(golf_grpc::Position::TOP_LEFT);
+    golf_grpc::SwapForDiscardResponse res;
+    if (!table.stub->SwapForDiscard(&context, req, &res).ok()) {
+      state.SkipWithError("move failed");
+      break;
+    }
+    turn = 1 - turn;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnaryMoves);
+
+static void BM_StreamedMoves(benchmark::State& state) {
+  Table table;
+  ClientContext contexts[2];
+  std::unique_ptr<grpc::ClientReaderWriter<PlayGameRequest, ResponseWrapper>> streams[2];
+  const std::string players[] = {"alice", "bobby"};
+  ResponseWrapper response;
+  for (int i = 0; i < 2; i++) {
+    streams[i] = table.stub->PlayGame(&contexts[i]);
+    PlayGameRequest start;
+    start.mutable_start()->set_user_id(players[i]);
+    start.mutable_start()->set_game_id(table.game_id);
+    streams[i]->Write(start);
+    streams[i]->Read(&response);
+  }
+
+  PlayGameRequest move;
+  move.mutable_move()->set_type(MoveType::SWAP_FOR_DISCARD);
+  move.mutable_move()->set_position(golf_grpc::Position::TOP_LEFT);
+  int turn = 0;
+  for (auto _ : state) {
+    if (!streams[turn]->Write(move) || !streams[turn]->Read(&response) || response.has_error()) {
+      state.SkipWithError("move failed");
+      break;
+    }
+    turn = 1 - turn;
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  for (auto& stream : streams) {
+    stream->WritesDone();
+    stream->Finish();
+  }
+}
+BENCHMARK(BM_StreamedMoves);
+
+BENCHMARK_MAIN();
@@ -1,22 +1,43 @@
+#include "cpp/golf_grpc_service/golf_grpc_service.h"
+
 #include <grpcpp/client_context.h>
 #include <grpcpp/create_channel.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 #include <gtest/gtest.h>
 
-#include "cpp/golf_grpc_service/golf_grpc_service.h"
+#include <memory>
+
+#include "cpp/cards/golf/in_memory_game_store.h"
 #include "protos/golf_grpc/golf.grpc.pb.h"
 
+using golf_grpc::GameState;
 using golf_grpc::Golf;
-using golf_grpc::RegisterUserResponse;
+using golf_grpc::JoinGameRequest;
+using golf_grpc::JoinGameResponse;
+using golf_grpc::MoveType;
+using golf_grpc::NewGameRequest;
+using golf_grpc::NewGameResponse;
+using golf_grpc::PlayGameRequest;
 using golf_grpc::RegisterUserRequest;
+using golf_grpc::RegisterUserResponse;
+using golf_grpc::ResponseWrapper;
+using golf_grpc::WatchGameRequest;
 using grpc::ClientContext;
 using grpc::Server;
 using grpc::ServerBuilder;
 using grpc::Status;
 
+void RegisterUser(Golf::Stub* stub, const std::string& user_id) {
+  ClientContext context;
+  RegisterUserRequest req;
+  req.set_user_id(user_id);
+  RegisterUserResponse res;
+  ASSERT_TRUE(stub->RegisterUser(&context, req, &res).ok());
+}
+
 TEST(SERVICE_TEST, BasicAssertions) {
-  GolfServiceImpl service;
+  GolfServiceImpl service{std::make_shared<golf::InMemoryGameStore>()};
 
   ServerBuilder builder;
   builder.RegisterService(&service);
@@ -29,7 +50,7 @@ TEST(SERVICE_TEST, BasicAssertions) {
   context.AddMetadata("app-name", "test-app");
 
   RegisterUserRequest req;
-  req.set_user_id("hello@example.org");
+  req.set_user_id("hello_example");
   RegisterUserResponse res;
 
   Status status = stub->RegisterUser(&context, req, &res);
@@ -38,3 +59,236 @@ TEST(SERVICE_TEST, BasicAssertions) {
 
   server->Shutdown();
 }
+
+TEST(SERVICE_TEST, WatchGameStreamsCommittedMoves) {
+  GolfServiceImpl service{std::make_shared<golf::InMemoryGameStore>()};
+
+  ServerBuilder builder;
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+  auto stub = Golf::NewStub(server->InProcessChannel({}));
+
+  RegisterUser(stub.get(), "alice");
+  RegisterUser(stub.get(), "bobby");
+
+  ClientContext new_game_context;
+  NewGameRequest new_game_req;
+  new_game_req.set_user_id("alice");
+  new_game_req.set_number_of_players(2);
+  NewGameResponse new_game_res;
+  ASSERT_TRUE(stub->NewGame(&new_game_context, new_game_req, &new_game_res).ok());
+  const auto game_id = new_game_res.game_state().game_id();
+
+  ClientContext watch_context;
+  WatchGameRequest watch_req;
+  watch_req.set_user_id("alice");
+  watch_req.set_game_id(game_id);
+  auto reader = stub->WatchGame(&watch_context, watch_req);
+
+  GameState snapshot;
+  ASSERT_TRUE(reader->Read(&snapshot));
+  EXPECT_EQ(snapshot.game_id(), game_id);
+  EXPECT_FALSE(snapshot.all_here());
+
+  ClientContext join_context;
+  JoinGameRequest join_req;
+  join_req.set_user_id("bobby");
+  join_req.set_game_id(game_id);
+  JoinGameResponse join_res;
+  ASSERT_TRUE(stub->JoinGame(&join_context, join_req, &join_res).ok());
+
+  GameState update;
+  ASSERT_TRUE(reader->Read(&update));
+  EXPECT_TRUE(update.all_here());
+  EXPECT_TRUE(update.your_turn());  // alice's view of the game
+
+  watch_context.TryCancel();
+  while (reader->Read(&update)) {
+  }
+  EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::CANCELLED);
+
+  server->Shutdown();
+}
+
+TEST(SERVICE_TEST, WatchGameRejectsNonPlayers) {
+  GolfServiceImpl service{std::make_shared<golf::InMemoryGameStore>()};
+
+  ServerBuilder builder;
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+  auto stub = Golf::NewStub(server->InProcessChannel({}));
+
+  RegisterUser(stub.get(), "alice");
+  RegisterUser(stub.get(), "mallory");
+
+  ClientContext new_game_context;
+  NewGameRequest new_game_req;
+  new_game_req.set_user_id("alice");
+  new_game_req.set_number_of_players(2);
+  NewGameResponse new_game_res;
+  ASSERT_TRUE(stub->NewGame(&new_game_context, new_game_req, &new_game_res).ok());
+
+  ClientContext watch_context;
+  WatchGameRequest watch_req;
+  watch_req.set_user_id("mallory");
+  watch_req.set_game_id(new_game_res.game_state().game_id());
+  auto reader = stub->WatchGame(&watch_context, watch_req);
+
+  GameState state;
+  EXPECT_FALSE(reader->Read(&state));
+  EXPECT_EQ(reader->Finish().error_code(), grpc::StatusCode::PERMISSION_DENIED);
+
+  server->Shutdown();
+}
+
+TEST(SERVICE_TEST, PlayGameAuthenticatesOnceThenAppliesMoves) {
+  GolfServiceImpl service{std::make_shared<golf::InMemoryGameStore>()};
+
+  ServerBuilder builder;
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+  auto stub = Golf::NewStub(server->InProcessChannel({}));
+
+  RegisterUser(stub.get(), "alice");
+  RegisterUser(stub.get(), "bobby");
+
+  ClientContext new_game_context;
+  NewGameRequest new_game_req;
+  new_game_req.set_user_id("alice");
+  new_game_req.set_number_of_players(2);
+  NewGameResponse new_game_res;
+  ASSERT_TRUE(stub->NewGame(&new_game_context, new_game_req, &new_game_res).ok());
+  const auto game_id = new_game_res.game_state().game_id();
+
+  ClientContext join_context;
+  JoinGameRequest join_req;
+  join_req.set_user_id("bobby");
+  join_req.set_game_id(game_id);
+  JoinGameResponse join_res;
+  ASSERT_TRUE(stub->JoinGame(&join_context, join_req, &join_res).ok());
+
+  ClientContext play_context;
+  auto stream = stub->PlayGame(&play_context);
+
+  PlayGameRequest start;
+  start.set_id(1);
+  start.mutable_start()->set_user_id("alice");
+  start.mutable_start()->set_game_id(game_id);
+  ASSERT_TRUE(stream->Write(start));
+
+  ResponseWrapper response;
+  ASSERT_TRUE(stream->Read(&response));
+  EXPECT_EQ(response.id(), 1);
+  ASSERT_TRUE(response.has_game_state());
+  EXPECT_TRUE(response.game_state().your_turn());
+
+  PlayGameRequest peek;
+  peek.set_id(2);
+  peek.mutable_move()->set_type(MoveType::PEEK);
+  ASSERT_TRUE(stream->Write(peek));
+  ASSERT_TRUE(stream->Read(&response));
+  EXPECT_EQ(response.id(), 2);
+  ASSERT_TRUE(response.has_game_state());
+  EXPECT_TRUE(response.game_state().has_top_draw());
+
+  PlayGameRequest knock;
+  knock.set_id(3);
+  knock.mutable_move()->set_type(MoveType::KNOCK);
+  ASSERT_TRUE(stream->Write(knock));
+  ASSERT_TRUE(stream->Read(&response));
+  EXPECT_EQ(response.id(), 3);
+  ASSERT_TRUE(response.has_error());
+  EXPECT_EQ(response.error().message(), "cannot knock after peeking");
+
+  PlayGameRequest discard;
+  discard.set_id(4);
+  discard.mutable_move()->set_type(MoveType::DISCARD_DRAW);
+  ASSERT_TRUE(stream->Write(discard));
+  ASSERT_TRUE(stream->Read(&response));
+  EXPECT_EQ(response.id(), 4);
+  ASSERT_TRUE(response.has_game_state());
+  EXPECT_FALSE(response.game_state().your_turn());
+
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+
+  server->Shutdown();
+}
+
+TEST(SERVICE_TEST, PlayGameRequiresStart) {
+  GolfServiceImpl service{std::make_shared<golf::InMemoryGameStore>()};
+
+  ServerBuilder builder;
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+  auto stub = Golf::NewStub(server->InProcessChannel({}));
+
+  ClientContext play_context;
+  auto stream = stub->PlayGame(&play_context);
+
+  PlayGameRequest knock;
+  knock.mutable_move()->set_type(MoveType::KNOCK);
+  stream->Write(knock);
+
+  ResponseWrapper response;
+  EXPECT_FALSE(stream->Read(&response));
+  EXPECT_EQ(stream->Finish().error_code(), grpc::StatusCode::UNAUTHENTICATED);
+
+  server->Shutdown();
+}
+
+TEST(SERVICE_TEST, PlayGameSurvivesClientClosingMidStream) {
+  GolfServiceImpl service{std::make_shared<golf::InMemoryGameStore>(),
+                          std::make_shared<golf_pipeline::RateLimiter>(1e9, 1e9)};
+
+  ServerBuilder builder;
+  builder.RegisterService(&service);
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+  auto stub = Golf::NewStub(server->InProcessChannel({}));
+
+  RegisterUser(stub.get(), "alice");
+
+  ClientContext new_game_context;
+  NewGameRequest new_game_req;
+  new_game_req.set_user_id("alice");
+  new_game_req.set_number_of_players(2);
+  NewGameResponse new_game_res;
+  ASSERT_TRUE(stub->NewGame(&new_game_context, new_game_req, &new_game_res).ok());
+  const auto game_id = new_game_res.game_state().game_id();
+
+  PlayGameRequest start;
+  start.mutable_start()->set_user_id("alice");
+  start.mutable_start()->set_game_id(game_id);
+
+  {
+    ClientContext play_context;
+    auto stream = stub->PlayGame(&play_context);
+    ASSERT_TRUE(stream->Write(start));
+    ResponseWrapper response;
+    ASSERT_TRUE(stream->Read(&response));
+
+    // keep sending without reading, then drop the read side while the server has writes and
+    // reads in flight
+    PlayGameRequest peek;
+    peek.mutable_move()->set_type(MoveType::PEEK);
+    for (int i = 0; i < 64; ++i) {
+      if (!stream->Write(peek)) {
+        break;
+      }
+    }
+    play_context.TryCancel();
+    EXPECT_FALSE(stream->Finish().ok());
+  }
+
+  // the service is still healthy afterwards
+  ClientContext play_context;
+  auto stream = stub->PlayGame(&play_context);
+  ASSERT_TRUE(stream->Write(start));
+  ResponseWrapper response;
+  ASSERT_TRUE(stream->Read(&response));
+  EXPECT_TRUE(response.has_game_state());
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+
+  server->Shutdown();
+}
@@ -2,27 +2,139 @@
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/health_check_service_interface.h>
 
+#include <signal.h>
+
+#include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
 
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "cpp/cards/golf/game_reclaimer.h"
+#include "cpp/cards/golf/in_memory_game_store.h"
+#include "cpp/golf_archive/archive_sink.h"
+#include "cpp/golf_archive/archive_writer.h"
 #include "cpp/golf_grpc_service/golf_grpc_service.h"
+#include "cpp/grpc_instrumentation/interceptors.h"
+#include "cpp/grpc_instrumentation/log_exporter.h"
+#include "cpp/server_bootstrap/server_bootstrap.h"
 
 using grpc::Server;
 using grpc::ServerBuilder;
 
+ABSL_FLAG(int, finished_game_ttl_s, 600, "Seconds a finished game stays readable");
+ABSL_FLAG(int, idle_game_ttl_s, 7200, "Seconds without a move before a game is abandoned");
+ABSL_FLAG(std::string, game_archive, "", "File to archive evicted finished games to, if any");
+
+namespace {
+// How much of the archive a crash can cost: games buffered since the last flush.
+constexpr auto kArchiveFlushInterval = std::chrono::seconds(30);
+// How long open streams get to finish once a shutdown signal arrives.
+constexpr auto kShutdownGrace = std::chrono::seconds(5);
+
+// Writes out the sink's partial block every kArchiveFlushInterval until destroyed.
+class ArchiveFlusher {
+ public:
+  explicit ArchiveFlusher(std::shared_ptr<golf_archive::ArchiveSink> sink)
+      : sink_(std::move(sink)), thread_([this] { run(); }) {}
+
+  ~ArchiveFlusher() {
+    {
+      std::scoped_lock lock{mutex_};
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+ private:
+  void run() {
+    std::unique_lock lock{mutex_};
+    while (!cv_.wait_for(lock, kArchiveFlushInterval, [this] { return stopping_; })) {
+      lock.unlock();
+      if (auto status = sink_->flush(); !status.ok()) {
+        std::cerr << "flushing the game archive failed: " << status << std::endl;
+      }
+      lock.lock();
+    }
+  }
+
+  std::shared_ptr<golf_archive::ArchiveSink> sink_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
+}  // namespace
+
 void RunServer(uint16_t port) {
+  // Every thread started from here on inherits the blocked signals, so only the sigwait below
+  // sees them.
+  sigset_t shutdown_signals;
+  sigemptyset(&shutdown_signals);
+  sigaddset(&shutdown_signals, SIGTERM);
+  sigaddset(&shutdown_signals, SIGINT);
+  pthread_sigmask(SIG_BLOCK, &shutdown_signals, nullptr);
+
   std::string server_address = absl::StrFormat("0.0.0.0:%d", port);
-  GolfServiceImpl service;
+  golf::EvictionPolicy policy{
+      .finished_ttl = std::chrono::seconds(absl::GetFlag(FLAGS_finished_game_ttl_s)),
+      .idle_ttl = std::chrono::seconds(absl::GetFlag(FLAGS_idle_game_ttl_s)),
+  };
+  std::shared_ptr<golf_archive::ArchiveSink> archive;
+  if (auto path = absl::GetFlag(FLAGS_game_archive); !path.empty()) {
+    auto writer = golf_archive::ArchiveWriter::open(path);
+    if (!writer.ok()) {
+      std::cerr << "cannot archive games: " << writer.status() << std::endl;
+      std::exit(1);
+    }
+    archive = std::make_shared<golf_archive::ArchiveSink>(*std::move(writer));
+    policy.sink = archive;
+  }
+  auto store = std::make_shared<golf::InMemoryGameStore>(policy);
+  std::optional<golf::GameReclaimer> reclaimer{std::in_place, store, std::chrono::seconds(10)};
+  std::optional<ArchiveFlusher> archive_flusher;
+  if (archive) {
+    archive_flusher.emplace(archive);
+  }
+  GolfServiceImpl service{store};
 
   grpc::EnableDefaultHealthCheckService(true);
   grpc::reflection::InitProtoReflectionServerBuilderPlugin();
 
   ServerBuilder builder;
+  server_bootstrap::ConfigureServer(builder);
   builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());  // no auth
   builder.RegisterService(&service);
+  builder.experimental().SetInterceptorCreators(grpc_instrumentation::ServerInterceptors());
   std::unique_ptr<Server> server(builder.BuildAndStart());
+  grpc_instrumentation::LogExporter exporter{std::chrono::seconds(60)};
 
   std::cout << "Server listening on " << server_address << std::endl;
+  std::thread shutdown_on_signal{[&server, shutdown_signals] {
+    int signal;
+    sigwait(&shutdown_signals, &signal);
+    std::cout << "Shutting down on signal " << signal << std::endl;
+    server->Shutdown(std::chrono::system_clock::now() + kShutdownGrace);
+  }};
   server->Wait();
+  shutdown_on_signal.join();
+
+  // Stop evicting before the last flush so that no game lands in the buffer after it.
+  reclaimer.reset();
+  archive_flusher.reset();
+  if (archive) {
+    if (auto status = archive->flush(); !status.ok()) {
+      std::cerr << "flushing the game archive failed: " << status << std::endl;
+    }
+  }
 }
 
 uint16_t ReadPort(uint16_t default_port) {
@@ -32,7 +144,8 @@ uint16_t ReadPort(uint16_t default_port) {
   return default_port;
 }
 
-int main() {
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
   RunServer(ReadPort(8080));
   return 0;
 }
@@ -0,0 +1,28 @@
+#include "cpp/golf_pipeline/bot_driver.h"
+
+namespace golf_pipeline {
+
+Command botCommand(const golf::Action& action, const string& user_id, const string& game_id) {
+  Command command{CommandType::Peek, user_id, game_id};
+  command.position = static_cast<golf::Position>(action.position);
+  switch (action.type) {
+    case golf::ActionType::Peek:
+      command.type = CommandType::Peek;
+      break;
+    case golf::ActionType::SwapForDraw:
+      command.type = CommandType::SwapForDraw;
+      break;
+    case golf::ActionType::SwapDrawForDiscard:
+      command.type = CommandType::DiscardDraw;
+      break;
+    case golf::ActionType::SwapForDiscard:
+      command.type = CommandType::SwapForDiscard;
+      break;
+    case golf::ActionType::Knock:
+      command.type = CommandType::Knock;
+      break;
+  }
+  return command;
+}
+
+}  // namespace golf_pipeline
@@ -0,0 +1,339 @@
+#ifndef CPP_GOLF_PIPELINE_BOT_DRIVER_H
+#define CPP_GOLF_PIPELINE_BOT_DRIVER_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "cpp/cards/golf/bot_engine.h"
+#include "cpp/golf_pipeline/command.h"
+#include "cpp/golf_pipeline/execute_stage.h"
+
+namespace golf_pipeline {
+
+// The command that makes `action` for `user_id` in `game_id`.
+Command botCommand(const golf::Action& action, const string& user_id, const string& game_id);
+
+// Seats BotEngine players in empty seats and plays their turns. Moves are searched on the
+// driver's own threads from an immutable GameState snapshot, holding no lock; only applying the
+// chosen move goes through the ExecuteStage's lock, for as long as any human move would. A slow
+// bot therefore delays only its own game.
+//
+// Feed it every committed state with notify() (BotStage does this for a pipeline). Each applied
+// bot move is handed to `publish`, from a driver thread, with the commit sequence the
+// ExecuteStage gave it, exactly like a human move leaving the pipeline. A rejected move is
+// retried from a fresh read of the game, backing off from kFirstRetryDelay to kMaxRetryDelay
+// while the rejections continue; a bot never walks away from a game humans are still playing. A
+// game's bot users are unregistered once it is over or gone from the store.
+template <typename Origin>
+class BotDriver {
+ public:
+  typedef std::function<void(const Exchange<Origin>&)> Publish;
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr auto kFirstRetryDelay = std::chrono::milliseconds(10);
+  static constexpr auto kMaxRetryDelay = std::chrono::seconds(1);
+
+  BotDriver(std::shared_ptr<ExecuteStage<Origin>> execute, Publish publish,
+            std::chrono::microseconds move_budget = std::chrono::milliseconds(5),
+            int threads = 1)
+      : execute_(std::move(execute)), publish_(std::move(publish)), move_budget_(move_budget) {
+    for (int i = 0; i < threads; i++) {
+      workers_.emplace_back(&BotDriver::run, this);
+    }
+  }
+
+  ~BotDriver() {
+    {
+      std::scoped_lock lock{mutex_};
+      stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  BotDriver(const BotDriver&) = delete;
+  BotDriver& operator=(const BotDriver&) = delete;
+
+  // Registers a bot user for every empty seat in `game_id`, which `user_id` must be playing, and
+  // joins it to the game. Returns the game with every seat taken.
+  absl::StatusOr<golf::GameStatePtr> fillSeats(const string& user_id, const string& game_id) {
+    auto current = execute_->withGameManager([&](golf::GameManager& gm, uint64_t) {
+      return gm.getGameStateForUser(game_id, user_id);
+    });
+    if (!current.ok()) {
+      return current.status();
+    }
+
+    golf::GameStatePtr latest = *current;
+    for (auto& player : (*current)->getPlayers()) {
+      if (player.isPresent()) {
+        continue;
+      }
+      // Registering claims the name, so a collision with an existing user is never seated.
+      Exchange<Origin> registered{{}, {CommandType::RegisterUser}};
+      for (int attempt = 0; attempt < 3; attempt++) {
+        registered.status = absl::OkStatus();
+        registered.command.user_id = botName();
+        execute_->process(std::span{&registered, 1});
+        if (registered.ok()) {
+          break;
+        }
+      }
+      if (!registered.ok()) {
+        return registered.status;
+      }
+      {
+        std::scoped_lock lock{mutex_};
+        bots_.insert(registered.command.user_id);
+        bots_by_game_[game_id].push_back(registered.command.user_id);
+      }
+
+      Exchange<Origin> joined{{}, {CommandType::JoinGame, registered.command.user_id, game_id}};
+      execute_->process(std::span{&joined, 1});
+      if (!joined.ok()) {
+        return joined.status;
+      }
+      publish_(joined);
+      latest = joined.game_state;
+    }
+    notify(latest);
+    return latest;
+  }
+
+  // Queues the game if a bot is to move in `state`. Only the newest state per game is kept, and
+  // the caller never waits on a search.
+  void notify(const golf::GameStatePtr& state) {
+    if (!state) {
+      return;
+    }
+    if (state->isOver()) {
+      release(state->getGameId());
+      return;
+    }
+    if (!isBot(state->getPlayer(state->getWhoseTurn()))) {
+      return;
+    }
+    {
+      std::scoped_lock lock{mutex_};
+      auto [it, inserted] = pending_.insert_or_assign(state->getGameId(), state);
+      if (inserted && !in_flight_.contains(state->getGameId())) {
+        queue_.push_back(state->getGameId());
+      }
+    }
+    cv_.notify_one();
+  }
+
+  bool isBot(const golf::Player& player) const {
+    std::scoped_lock lock{mutex_};
+    return player.getName().has_value() && bots_.contains(*player.getName());
+  }
+
+ private:
+  // Fits GameManager's 4 to 15 character user ids.
+  static string botName() {
+    static const char kChars[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+    thread_local std::mt19937 rng{std::random_device{}()};
+    string name = "bot-";
+    for (int i = 0; i < 8; i++) {
+      name += kChars[rng() % (sizeof(kChars) - 1)];
+    }
+    return name;
+  }
+
+  void run() {
+    for (;;) {
+      golf::GameStatePtr state;
+      {
+        std::unique_lock lock{mutex_};
+        auto ready = [this] {
+          return stopping_ || !queue_.empty() ||
+                 (!retries_.empty() && retries_.begin()->first <= Clock::now());
+        };
+        while (!ready()) {
+          if (retries_.empty()) {
+            cv_.wait(lock);
+          } else {
+            cv_.wait_until(lock, retries_.begin()->first);
+          }
+        }
+        if (stopping_) {
+          return;
+        }
+        if (queue_.empty()) {
+          string game_id = std::move(retries_.begin()->second);
+          retries_.erase(retries_.begin());
+          lock.unlock();
+          retry(game_id);
+          continue;
+        }
+        string game_id = std::move(queue_.front());
+        queue_.pop_front();
+        auto it = pending_.find(game_id);
+        state = std::move(it->second);
+        pending_.erase(it);
+        in_flight_.insert(game_id);
+      }
+
+      play(state);
+
+      std::scoped_lock lock{mutex_};
+      in_flight_.erase(state->getGameId());
+      // A state that arrived while this game was being played waits for its turn in the queue.
+      if (pending_.contains(state->getGameId())) {
+        queue_.push_back(state->getGameId());
+        cv_.notify_one();
+      }
+    }
+  }
+
+  void play(golf::GameStatePtr state) {
+    int seat = state->getWhoseTurn();
+    auto& game_id = state->getGameId();
+    auto& bot = *state->getPlayer(seat).getName();
+    auto action = engine_.chooseMove(*state, seat, move_budget_);
+    Exchange<Origin> exchange{{}, botCommand(action, bot, game_id)};
+    execute_->process(std::span{&exchange, 1});
+    if (exchange.ok()) {
+      {
+        std::scoped_lock lock{mutex_};
+        failures_.erase(game_id);
+      }
+      publish_(exchange);
+      notify(exchange.game_state);
+      return;
+    }
+
+    // The game may have moved on under the snapshot, but the store may also have failed or lost
+    // a version race, and then nothing else would ever notify this game again. Either way the
+    // stored game says what to do next.
+    scheduleRetry(game_id, exchange.status);
+  }
+
+  // Reads `game_id` afresh after a failure and carries on from there. Only a game the store no
+  // longer has lets its bots go; anything else is tried again later.
+  void retry(const string& game_id) {
+    string bot;
+    {
+      std::scoped_lock lock{mutex_};
+      auto it = bots_by_game_.find(game_id);
+      if (it == bots_by_game_.end()) {
+        return;
+      }
+      bot = it->second.front();
+    }
+    auto fresh = execute_->withGameManager(
+        [&](golf::GameManager& gm, uint64_t) { return gm.getGameStateForUser(game_id, bot); });
+    if (absl::IsNotFound(fresh.status())) {
+      LOG(WARNING) << "bots lost game " << game_id << ": " << fresh.status();
+      release(game_id);
+      return;
+    }
+    if (!fresh.ok()) {
+      scheduleRetry(game_id, fresh.status());
+      return;
+    }
+    notify(*fresh);
+  }
+
+  // Retries `game_id` after a delay that doubles with each failure in a row.
+  void scheduleRetry(const string& game_id, const absl::Status& status) {
+    std::chrono::milliseconds delay = kFirstRetryDelay;
+    {
+      std::scoped_lock lock{mutex_};
+      int failures = ++failures_[game_id];
+      for (int i = 1; i < failures && delay < kMaxRetryDelay; i++) {
+        delay *= 2;
+      }
+      delay = std::min<std::chrono::milliseconds>(delay, kMaxRetryDelay);
+      // Once the delay stops growing, say so now and then rather than on every attempt.
+      if (delay < kMaxRetryDelay || failures % 60 == 0) {
+        LOG(WARNING) << "bot move in game " << game_id << " failed " << failures
+                     << " times in a row: " << status;
+      }
+      retries_.emplace(Clock::now() + delay, game_id);
+    }
+    cv_.notify_one();
+  }
+
+  // Forgets and unregisters the bots seated in `game_id`.
+  void release(const string& game_id) {
+    std::vector<string> released;
+    {
+      std::scoped_lock lock{mutex_};
+      auto it = bots_by_game_.find(game_id);
+      if (it == bots_by_game_.end()) {
+        return;
+      }
+      released = std::move(it->second);
+      bots_by_game_.erase(it);
+      failures_.erase(game_id);
+      for (auto& bot : released) {
+        bots_.erase(bot);
+      }
+    }
+    execute_->withGameManager([&](golf::GameManager& gm, uint64_t) {
+      for (auto& bot : released) {
+        if (auto status = gm.unregisterUser(bot); !status.ok()) {
+          LOG(WARNING) << "cannot unregister bot " << bot << ": " << status;
+        }
+      }
+    });
+  }
+
+  std::shared_ptr<ExecuteStage<Origin>> execute_;
+  Publish publish_;
+  const std::chrono::microseconds move_budget_;
+  golf::BotEngine engine_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::unordered_set<string> bots_;
+  std::unordered_map<string, std::vector<string>> bots_by_game_;
+  std::unordered_map<string, int> failures_;  // rejected moves in a row, by game
+  std::set<std::pair<Clock::time_point, string>> retries_;  // games to read again, and when
+  std::unordered_map<string, golf::GameStatePtr> pending_;  // newest state per queued game
+  std::deque<string> queue_;
+  std::unordered_set<string> in_flight_;  // games a worker is playing right now
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+// Passes every committed state to a BotDriver, so bots move as soon as their turn comes up.
+template <typename Origin>
+class BotStage final : public Stage<Origin> {
+ public:
+  explicit BotStage(std::shared_ptr<BotDriver<Origin>> driver) : driver_(std::move(driver)) {}
+
+  void process(std::span<Exchange<Origin>> batch) override {
+    for (auto& exchange : batch) {
+      if (exchange.ok()) {
+        driver_->notify(exchange.game_state);
+      }
+    }
+  }
+
+ private:
+  std::shared_ptr<BotDriver<Origin>> driver_;
+};
+
+}  // namespace golf_pipeline
+
+#endif
@@ -0,0 +1,237 @@
+#include "cpp/golf_pipeline/bot_driver.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cpp/cards/golf/game_manager.h"
+#include "cpp/cards/golf/in_memory_game_store.h"
+#include "cpp/golf_pipeline/command.h"
+#include "cpp/golf_pipeline/execute_stage.h"
+#include "cpp/golf_pipeline/pipeline.h"
+
+using namespace golf_pipeline;
+using std::chrono::milliseconds;
+
+namespace {
+// Collects what the driver publishes and lets the test wait for it.
+struct Published {
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::vector<Exchange<int>> exchanges;
+
+  void add(const Exchange<int>& exchange) {
+    std::scoped_lock lock{mutex};
+    exchanges.push_back(exchange);
+    cv.notify_all();
+  }
+
+  // Waits until the human is to move again (or the game ends) and returns that state.
+  golf::GameStatePtr awaitTurn(const std::string& human) {
+    std::unique_lock lock{mutex};
+    golf::GameStatePtr state;
+    cv.wait_for(lock, std::chrono::seconds(5), [&] {
+      if (exchanges.empty()) {
+        return false;
+      }
+      state = exchanges.back().game_state;
+      return state->isOver() ||
+             state->getPlayer(state->getWhoseTurn()).nameMatches(human);
+    });
+    return state;
+  }
+};
+
+// Rejects bots' moves while fail_bot_moves is positive, counting each one down.
+class FlakyStore : public golf::GameStoreInterface {
+ public:
+  absl::Status AddUser(const string& user_id) override { return store.AddUser(user_id); }
+  absl::StatusOr<bool> UserExists(const string& user_id) const override {
+    return store.UserExists(user_id);
+  }
+  absl::Status RemoveUser(const string& user_id) override { return store.RemoveUser(user_id); }
+  absl::StatusOr<std::unordered_set<string>> GetUsers() const override {
+    return store.GetUsers();
+  }
+  absl::StatusOr<golf::GameStatePtr> NewGame(const golf::GameStatePtr game_state) override {
+    return store.NewGame(game_state);
+  }
+  absl::StatusOr<std::vector<golf::GameStatePtr>> NewGames(
+      const std::vector<golf::GameStatePtr>& game_states, const string& batch_key) override {
+    return store.NewGames(game_states, batch_key);
+  }
+  absl::StatusOr<golf::GameStatePtr> ReadGame(const string& game_id) const override {
+    return store.ReadGame(game_id);
+  }
+  absl::StatusOr<golf::GameStatePtr> ReadGameByUserId(const string& user_id) const override {
+    return store.ReadGameByUserId(user_id);
+  }
+  absl::StatusOr<golf::GameStatePtr> ReadGameForUser(const string& game_id,
+                                                     const string& user_id) const override {
+    return store.ReadGameForUser(game_id, user_id);
+  }
+  absl::StatusOr<std::unordered_set<golf::GameStatePtr>> ReadAllGames() const override {
+    return store.ReadAllGames();
+  }
+  absl::StatusOr<golf::GameStatePtr> UpdateGame(const golf::GameStatePtr game_state) override {
+    auto stored = store.ReadGame(game_state->getGameId());
+    if (stored.ok() && fail_bot_moves > 0) {
+      auto& mover = (*stored)->getPlayer((*stored)->getWhoseTurn()).getName();
+      if (mover.has_value() && mover->starts_with("bot-")) {
+        fail_bot_moves--;
+        bot_moves_rejected++;
+        return absl::UnavailableError("store unavailable");
+      }
+    }
+    return store.UpdateGame(game_state);
+  }
+
+  golf::InMemoryGameStore store;
+  std::atomic<int> fail_bot_moves = 0;
+  std::atomic<int> bot_moves_rejected = 0;
+};
+
+// Polls `done` for up to five seconds.
+template <typename F>
+bool eventually(F&& done) {
+  for (int i = 0; i < 500; i++) {
+    if (done()) {
+      return true;
+    }
+    std::this_thread::sleep_for(milliseconds(10));
+  }
+  return done();
+}
+}  // namespace
+
+TEST(BotDriver, FillsSeatsAndPlaysBotTurns) {
+  auto gm = std::make_shared<golf::GameManager>(std::make_shared<golf::InMemoryGameStore>());
+  auto execute = std::make_shared<ExecuteStage<int>>(gm);
+  Published published;
+  auto driver = std::make_shared<BotDriver<int>>(
+      execute, [&](const Exchange<int>& e) { published.add(e); }, milliseconds(1));
+  Pipeline<int> pipeline{{execute, std::make_shared<BotStage<int>>(driver)}};
+
+  std::vector<Exchange<int>> setup{
+      {1, {CommandType::RegisterUser, "alice"}},
+      {2, {CommandType::NewGame, "alice", "", 3}},
+  };
+  pipeline.process(setup);
+  ASSERT_TRUE(setup[1].ok());
+  auto game_id = setup[1].game_state->getGameId();
+
+  EXPECT_EQ(driver->fillSeats("bobby", game_id).status().code(),
+            absl::StatusCode::kPermissionDenied);  // not seated
+  auto filled = driver->fillSeats("alice", game_id);
+  ASSERT_TRUE(filled.ok());
+  ASSERT_TRUE((*filled)->allPlayersPresent());
+  EXPECT_TRUE(driver->isBot((*filled)->getPlayer(1)));
+  EXPECT_TRUE(driver->isBot((*filled)->getPlayer(2)));
+  EXPECT_FALSE(driver->isBot((*filled)->getPlayer(0)));
+
+  // Alice moves; both bots answer on their own, and every publish carries a fresh commit.
+  Exchange<int> move{3, {CommandType::DiscardDraw, "alice", game_id}};
+  pipeline.process(move);
+  ASSERT_TRUE(move.ok());
+  auto state = published.awaitTurn("alice");
+  ASSERT_NE(state, nullptr);
+  EXPECT_TRUE(state->isOver() || state->getWhoseTurn() == 0);
+
+  std::scoped_lock lock{published.mutex};
+  for (size_t i = 1; i < published.exchanges.size(); i++) {
+    EXPECT_GT(published.exchanges[i].commit_seq, published.exchanges[i - 1].commit_seq);
+  }
+}
+
+TEST(BotDriver, BotCommandMapsActions) {
+  auto command = botCommand({golf::ActionType::SwapForDiscard, 2}, "bot-x", "g");
+  EXPECT_EQ(command.type, CommandType::SwapForDiscard);
+  EXPECT_EQ(command.position, golf::Position::BottomLeft);
+  EXPECT_EQ(command.user_id, "bot-x");
+  EXPECT_EQ(command.game_id, "g");
+  EXPECT_EQ(botCommand({golf::ActionType::SwapDrawForDiscard}, "b", "g").type,
+            CommandType::DiscardDraw);
+}
+
+TEST(BotDriver, RetriesRejectedMovesAndReleasesBots) {
+  auto store = std::make_shared<FlakyStore>();
+  auto gm = std::make_shared<golf::GameManager>(store);
+  auto execute = std::make_shared<ExecuteStage<int>>(gm);
+  Published published;
+  auto driver = std::make_shared<BotDriver<int>>(
+      execute, [&](const Exchange<int>& e) { published.add(e); }, milliseconds(1));
+  Pipeline<int> pipeline{{execute, std::make_shared<BotStage<int>>(driver)}};
+
+  std::vector<Exchange<int>> setup{
+      {1, {CommandType::RegisterUser, "alice"}},
+      {2, {CommandType::NewGame, "alice", "", 2}},
+  };
+  pipeline.process(setup);
+  auto game_id = setup[1].game_state->getGameId();
+  auto filled = driver->fillSeats("alice", game_id);
+  ASSERT_TRUE(filled.ok());
+  auto& bot = (*filled)->getPlayer(1);
+  ASSERT_TRUE(driver->isBot(bot));
+  EXPECT_TRUE(*store->store.UserExists(*bot.getName()));
+  {
+    std::scoped_lock lock{published.mutex};
+    published.exchanges.clear();  // the bot's join
+  }
+
+  // The bot's last turn is rejected twice before it goes through, and that ends the game.
+  store->fail_bot_moves = 2;
+  Exchange<int> knock{3, {CommandType::Knock, "alice", game_id}};
+  pipeline.process(knock);
+  ASSERT_TRUE(knock.ok());
+  auto state = published.awaitTurn("alice");
+  ASSERT_NE(state, nullptr);
+  EXPECT_TRUE(state->isOver());
+  EXPECT_EQ(store->bot_moves_rejected, 2);
+
+  EXPECT_TRUE(eventually([&] { return !driver->isBot(bot); }));
+  EXPECT_FALSE(*store->store.UserExists(*bot.getName()));
+}
+
+TEST(BotDriver, KeepsTryingWhileTheGameGoesOn) {
+  auto store = std::make_shared<FlakyStore>();
+  auto gm = std::make_shared<golf::GameManager>(store);
+  auto execute = std::make_shared<ExecuteStage<int>>(gm);
+  Published published;
+  auto driver = std::make_shared<BotDriver<int>>(
+      execute, [&](const Exchange<int>& e) { published.add(e); }, milliseconds(1));
+  Pipeline<int> pipeline{{execute, std::make_shared<BotStage<int>>(driver)}};
+
+  std::vector<Exchange<int>> setup{
+      {1, {CommandType::RegisterUser, "alice"}},
+      {2, {CommandType::NewGame, "alice", "", 2}},
+  };
+  pipeline.process(setup);
+  auto game_id = setup[1].game_state->getGameId();
+  auto filled = driver->fillSeats("alice", game_id);
+  ASSERT_TRUE(filled.ok());
+  auto& bot = (*filled)->getPlayer(1);
+
+  {
+    std::scoped_lock lock{published.mutex};
+    published.exchanges.clear();  // the bot's join
+  }
+
+  // Long enough a run of rejections to reach the longer delays, and the seat is still played.
+  store->fail_bot_moves = 6;
+  Exchange<int> move{3, {CommandType::DiscardDraw, "alice", game_id}};
+  pipeline.process(move);
+  ASSERT_TRUE(move.ok());
+
+  auto state = published.awaitTurn("alice");
+  ASSERT_NE(state, nullptr);
+  EXPECT_FALSE(state->isOver());
+  EXPECT_EQ(store->bot_moves_rejected, 6);
+  EXPECT_TRUE(driver->isBot(bot));
+  EXPECT_TRUE(*store->store.UserExists(*bot.getName()));
+}
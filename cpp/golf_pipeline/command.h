@@ -0,0 +1,61 @@
+#ifndef CPP_GOLF_PIPELINE_COMMAND_H
+#define CPP_GOLF_PIPELINE_COMMAND_H
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "absl/status/status.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/player.h"
+
+namespace golf_pipeline {
+using std::string;
+
+enum class CommandType {
+  RegisterUser,
+  NewGame,
+  JoinGame,
+  Peek,
+  DiscardDraw,
+  SwapForDraw,
+  SwapForDiscard,
+  Knock
+};
+
+// A golf request with the transport stripped off.
+struct Command {
+  CommandType type;
+  string user_id;
+  string game_id;                                     // empty for RegisterUser and NewGame
+  int number_of_players = 0;                          // NewGame only
+  golf::Position position = golf::Position::TopLeft;  // SwapForDraw and SwapForDiscard only
+  std::optional<int> request_id;                      // echoed back by transports that have one
+};
+
+// One command on its way through the pipeline. Origin identifies where the command came from
+// (a websocket connection, a gRPC response slot) so that transport stages can answer it.
+template <typename Origin>
+struct Exchange {
+  Origin origin;
+  Command command;
+  absl::Status status;            // the first stage to fail sets this; later stages skip it
+  golf::GameStatePtr game_state;  // set by ExecuteStage on success, null for RegisterUser
+  uint64_t commit_seq = 0;        // increases with every successful commit, across all games
+
+  [[nodiscard]] bool ok() const { return status.ok(); }
+};
+
+// Stages are batch oriented: each one sees every exchange in the batch, so a stage can amortize
+// locks, store round-trips or sends across commands.
+template <typename Origin>
+class Stage {
+ public:
+  virtual ~Stage() = default;
+  virtual void process(std::span<Exchange<Origin>> batch) = 0;
+};
+
+}  // namespace golf_pipeline
+
+#endif
@@ -0,0 +1,35 @@
+#include "cpp/golf_pipeline/execute_stage.h"
+
+#include "absl/status/statusor.h"
+
+namespace golf_pipeline {
+using golf::GameStatePtr;
+
+absl::StatusOr<GameStatePtr> execute(golf::GameManager& gm, const Command& command) {
+  switch (command.type) {
+    case CommandType::RegisterUser: {
+      auto res = gm.registerUser(command.user_id);
+      if (!res.ok()) {
+        return res.status();
+      }
+      return GameStatePtr{};
+    }
+    case CommandType::NewGame:
+      return gm.newGame(command.user_id, command.number_of_players);
+    case CommandType::JoinGame:
+      return gm.joinGame(command.game_id, command.user_id);
+    case CommandType::Peek:
+      return gm.peekAtDrawPile(command.game_id, command.user_id);
+    case CommandType::DiscardDraw:
+      return gm.swapDrawForDiscardPile(command.game_id, command.user_id);
+    case CommandType::SwapForDraw:
+      return gm.swapForDrawPile(command.game_id, command.user_id, command.position);
+    case CommandType::SwapForDiscard:
+      return gm.swapForDiscardPile(command.game_id, command.user_id, command.position);
+    case CommandType::Knock:
+      return gm.knock(command.game_id, command.user_id);
+  }
+  return absl::InvalidArgumentError("unknown command");
+}
+
+}  // namespace golf_pipeline
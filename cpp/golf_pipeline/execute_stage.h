@@ -0,0 +1,56 @@
+#ifndef CPP_GOLF_PIPELINE_EXECUTE_STAGE_H
+#define CPP_GOLF_PIPELINE_EXECUTE_STAGE_H
+
+#include <memory>
+#include <mutex>
+#include <span>
+
+#include "absl/status/statusor.h"
+#include "cpp/cards/golf/game_manager.h"
+#include "cpp/golf_pipeline/command.h"
+#include "cpp/lock_profiling/profiled_mutex.h"
+
+namespace golf_pipeline {
+
+// Applies a single command to the GameManager. RegisterUser yields a null GameStatePtr.
+absl::StatusOr<golf::GameStatePtr> execute(golf::GameManager& gm, const Command& command);
+
+// Runs each exchange against the GameManager. GameManager needs external synchronization, so the
+// stage takes its lock once per batch rather than once per command.
+template <typename Origin>
+class ExecuteStage final : public Stage<Origin> {
+ public:
+  explicit ExecuteStage(std::shared_ptr<golf::GameManager> gm) : gm_(std::move(gm)) {}
+
+  void process(std::span<Exchange<Origin>> batch) override {
+    std::scoped_lock lock{mutex_};
+    for (auto& exchange : batch) {
+      if (!exchange.ok()) {
+        continue;
+      }
+      auto res = execute(*gm_, exchange.command);
+      if (!res.ok()) {
+        exchange.status = res.status();
+        continue;
+      }
+      exchange.game_state = *res;
+      exchange.commit_seq = ++commit_seq_;
+    }
+  }
+
+  // For reads that must not interleave with a batch, e.g. a stream's initial snapshot.
+  template <typename F>
+  auto withGameManager(F&& f) {
+    std::scoped_lock lock{mutex_};
+    return f(*gm_, commit_seq_);
+  }
+
+ private:
+  std::shared_ptr<golf::GameManager> gm_;
+  lock_profiling::ProfiledMutex mutex_{"golf_pipeline.ExecuteStage"};
+  uint64_t commit_seq_ = 0;
+};
+
+}  // namespace golf_pipeline
+
+#endif
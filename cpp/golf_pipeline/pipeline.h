@@ -0,0 +1,38 @@
+#ifndef CPP_GOLF_PIPELINE_PIPELINE_H
+#define CPP_GOLF_PIPELINE_PIPELINE_H
+
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "cpp/golf_pipeline/command.h"
+
+namespace golf_pipeline {
+
+// Runs batches through an ordered list of stages. The usual order is
+//   decode -> authenticate -> rate-limit -> execute -> encode -> publish
+// where decoding happens in the transport adapter that builds the Exchanges, and the
+// authenticate, encode and publish stages are supplied by the transport. A transport without
+// sessions, like gRPC where every request names its user, has no authenticate stage.
+template <typename Origin>
+class Pipeline {
+ public:
+  explicit Pipeline(std::vector<std::shared_ptr<Stage<Origin>>> stages)
+      : stages_(std::move(stages)) {}
+
+  void process(std::span<Exchange<Origin>> batch) const {
+    for (auto& stage : stages_) {
+      stage->process(batch);
+    }
+  }
+
+  void process(Exchange<Origin>& exchange) const { process(std::span{&exchange, 1}); }
+
+ private:
+  const std::vector<std::shared_ptr<Stage<Origin>>> stages_;
+};
+
+}  // namespace golf_pipeline
+
+#endif
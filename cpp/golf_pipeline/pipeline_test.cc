@@ -0,0 +1,117 @@
+#include "cpp/golf_pipeline/pipeline.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "cpp/cards/golf/in_memory_game_store.h"
+#include "cpp/golf_pipeline/command.h"
+#include "cpp/golf_pipeline/execute_stage.h"
+#include "cpp/golf_pipeline/rate_limit_stage.h"
+
+using namespace golf_pipeline;
+
+// Records which origins reached it, like a transport's encode stage would.
+class RecordingStage final : public Stage<int> {
+ public:
+  void process(std::span<Exchange<int>> batch) override {
+    for (auto& exchange : batch) {
+      seen.push_back(exchange.origin);
+    }
+  }
+  std::vector<int> seen;
+};
+
+Exchange<int> MakeExchange(int origin, Command command) {
+  return Exchange<int>{origin, std::move(command)};
+}
+
+TEST(Pipeline, ExecutesBatchInOrder) {
+  auto gm = std::make_shared<golf::GameManager>(std::make_shared<golf::InMemoryGameStore>());
+  auto recorder = std::make_shared<RecordingStage>();
+  Pipeline<int> pipeline{{std::make_shared<ExecuteStage<int>>(gm), recorder}};
+
+  std::vector<Exchange<int>> batch{
+      MakeExchange(1, {CommandType::RegisterUser, "alice"}),
+      MakeExchange(2, {CommandType::NewGame, "alice", "", 2}),
+      MakeExchange(3, {CommandType::NewGame, "alice", "", 13}),
+  };
+  pipeline.process(batch);
+
+  EXPECT_TRUE(batch[0].ok());
+  EXPECT_EQ(batch[0].game_state, nullptr);
+  EXPECT_EQ(batch[0].commit_seq, 1);
+
+  ASSERT_TRUE(batch[1].ok());
+  EXPECT_EQ(batch[1].game_state->getPlayers().size(), 2);
+  EXPECT_EQ(batch[1].commit_seq, 2);
+
+  EXPECT_FALSE(batch[2].ok());
+  EXPECT_EQ(batch[2].status.message(), "2 to 12 players, dealt from up to 3 decks");
+  EXPECT_EQ(batch[2].commit_seq, 0);
+
+  EXPECT_EQ(recorder->seen, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(Pipeline, FailedExchangesSkipExecution) {
+  auto gm = std::make_shared<golf::GameManager>(std::make_shared<golf::InMemoryGameStore>());
+  Pipeline<int> pipeline{{std::make_shared<ExecuteStage<int>>(gm)}};
+
+  auto exchange = MakeExchange(1, {CommandType::RegisterUser, "alice"});
+  exchange.status = absl::UnauthenticatedError("nope");
+  pipeline.process(exchange);
+
+  EXPECT_EQ(exchange.status.message(), "nope");
+  EXPECT_TRUE(gm->getUsersOnline().empty());
+}
+
+TEST(RateLimiter, RefillsOverTime) {
+  auto now = std::chrono::steady_clock::time_point{};
+  RateLimiter limiter{2.0, 2.0, [&now] { return now; }};
+
+  EXPECT_TRUE(limiter.allow("alice"));
+  EXPECT_TRUE(limiter.allow("alice"));
+  EXPECT_FALSE(limiter.allow("alice"));
+  EXPECT_TRUE(limiter.allow("bobby"));
+
+  now += std::chrono::milliseconds(500);
+  EXPECT_TRUE(limiter.allow("alice"));
+  EXPECT_FALSE(limiter.allow("alice"));
+}
+
+TEST(RateLimiter, ForgetsIdleUsers) {
+  auto now = std::chrono::steady_clock::time_point{};
+  RateLimiter limiter{2.0, 2.0, [&now] { return now; }};
+  EXPECT_TRUE(limiter.allow("alice"));
+  EXPECT_TRUE(limiter.allow("bobby"));
+  EXPECT_EQ(limiter.tracked(), 2);
+
+  // alice keeps going; bobby's bucket refills and is dropped on a later call.
+  now += std::chrono::milliseconds(600);
+  EXPECT_TRUE(limiter.allow("alice"));
+  now += std::chrono::milliseconds(600);
+  EXPECT_TRUE(limiter.allow("alice"));
+  EXPECT_EQ(limiter.tracked(), 1);
+
+  // A user that comes back starts with a full bucket, as before.
+  EXPECT_TRUE(limiter.allow("bobby"));
+  EXPECT_TRUE(limiter.allow("bobby"));
+  EXPECT_FALSE(limiter.allow("bobby"));
+}
+
+TEST(RateLimitStage, RejectsOverLimit) {
+  auto now = std::chrono::steady_clock::time_point{};
+  auto limiter = std::make_shared<RateLimiter>(1.0, 1.0, [&now] { return now; });
+  Pipeline<int> pipeline{{std::make_shared<RateLimitStage<int>>(limiter)}};
+
+  std::vector<Exchange<int>> batch{
+      MakeExchange(1, {CommandType::Knock, "alice", "0"}),
+      MakeExchange(2, {CommandType::Knock, "alice", "0"}),
+  };
+  pipeline.process(batch);
+
+  EXPECT_TRUE(batch[0].ok());
+  EXPECT_EQ(batch[1].status.code(), absl::StatusCode::kResourceExhausted);
+}
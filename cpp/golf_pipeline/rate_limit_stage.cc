@@ -0,0 +1,44 @@
+#include "cpp/golf_pipeline/rate_limit_stage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+namespace golf_pipeline {
+
+bool RateLimiter::allow(const std::string& user_id) {
+  const auto now = clock_();
+  std::scoped_lock lock{mutex_};
+  // One pass per refill time keeps the sweep's cost per call constant on average.
+  if (now - swept_at_ >= refill_time_) {
+    sweep(now);
+  }
+  auto [it, inserted] = buckets_.try_emplace(user_id, Bucket{burst_, now});
+  auto& bucket = it->second;
+  if (!inserted) {
+    std::chrono::duration<double> elapsed = now - bucket.refilled_at;
+    bucket.tokens = std::min(burst_, bucket.tokens + elapsed.count() * rate_);
+    bucket.refilled_at = now;
+  }
+  if (bucket.tokens < 1.0) {
+    return false;
+  }
+  bucket.tokens -= 1.0;
+  return true;
+}
+
+size_t RateLimiter::tracked() const {
+  std::scoped_lock lock{mutex_};
+  return buckets_.size();
+}
+
+void RateLimiter::sweep(std::chrono::steady_clock::time_point now) {
+  std::erase_if(buckets_, [&](const auto& entry) {
+    return now - entry.second.refilled_at >= refill_time_;
+  });
+  swept_at_ = now;
+}
+
+}  // namespace golf_pipeline
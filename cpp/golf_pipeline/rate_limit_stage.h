@@ -0,0 +1,80 @@
+#ifndef CPP_GOLF_PIPELINE_RATE_LIMIT_STAGE_H
+#define CPP_GOLF_PIPELINE_RATE_LIMIT_STAGE_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+#include "cpp/golf_pipeline/command.h"
+
+namespace golf_pipeline {
+
+// Token bucket per user id. A bucket left alone long enough to refill is no different from a new
+// one, so those are dropped every so often and memory follows the users active lately rather than
+// every user ever seen. Thread-safe.
+class RateLimiter {
+ public:
+  typedef std::function<std::chrono::steady_clock::time_point()> Clock;
+
+  // What the golf services allow a user unless told otherwise: a human's pace, with room for a
+  // client that sends a few moves at once.
+  static constexpr double kDefaultCommandsPerSecond = 10;
+  static constexpr double kDefaultBurst = 20;
+
+  RateLimiter(double commands_per_second, double burst,
+              Clock clock = [] { return std::chrono::steady_clock::now(); })
+      : rate_(commands_per_second),
+        burst_(burst),
+        clock_(std::move(clock)),
+        refill_time_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(burst / commands_per_second))),
+        swept_at_(clock_()) {}
+
+  [[nodiscard]] bool allow(const std::string& user_id);
+  // Users with a bucket, i.e. seen within about two refill times.
+  [[nodiscard]] size_t tracked() const;
+
+ private:
+  struct Bucket {
+    double tokens;
+    std::chrono::steady_clock::time_point refilled_at;
+  };
+
+  // Drops the buckets that have refilled. Requires mutex_.
+  void sweep(std::chrono::steady_clock::time_point now);
+
+  const double rate_;
+  const double burst_;
+  const Clock clock_;
+  // How long an empty bucket takes to fill.
+  const std::chrono::steady_clock::duration refill_time_;
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Bucket> buckets_;
+  std::chrono::steady_clock::time_point swept_at_;
+};
+
+template <typename Origin>
+class RateLimitStage final : public Stage<Origin> {
+ public:
+  explicit RateLimitStage(std::shared_ptr<RateLimiter> limiter) : limiter_(std::move(limiter)) {}
+
+  void process(std::span<Exchange<Origin>> batch) override {
+    for (auto& exchange : batch) {
+      if (exchange.ok() && !limiter_->allow(exchange.command.user_id)) {
+        exchange.status = absl::ResourceExhaustedError("slow down");
+      }
+    }
+  }
+
+ private:
+  std::shared_ptr<RateLimiter> limiter_;
+};
+
+}  // namespace golf_pipeline
+
+#endif
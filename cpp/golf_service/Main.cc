@@ -1,11 +1,18 @@
 #include <grpcpp/create_channel.h>
 
+#include <chrono>
 #include <iostream>
+#include <thread>
 
 #include "absl/log/initialize.h"
+#include "absl/log/log.h"
 #include "cpp/cards/golf/doc_db_game_store.h"
 #include "cpp/doc_db_client/doc_db_client.h"
+#include "cpp/grpc_instrumentation/interceptors.h"
+#include "cpp/grpc_instrumentation/log_exporter.h"
 #include "cpp/golf_service/router.h"
+#include "cpp/golf_stats/doc_db_stats_store.h"
+#include "cpp/golf_stats/stats_aggregator.h"
 #include "mongoose.h"
 
 namespace {
@@ -15,6 +22,12 @@ struct RouterHolder {
 
 RouterHolder rh;
 
+constexpr auto kStatsFlushInterval = std::chrono::seconds(30);
+// Starting without the saved stats would overwrite them at the first flush, so a restore that
+// fails for any reason but there being none is retried this many times and then fatal.
+constexpr int kStatsRestoreAttempts = 5;
+constexpr auto kStatsRestoreBackoff = std::chrono::seconds(2);
+
 void do_route(struct ::mg_connection *c, int ev, void *ev_data) {
   rh.router_.value().route(c, ev, ev_data);
 }
@@ -27,13 +40,34 @@ int main() {
   // init stuff here
   absl::InitializeLog();
 
-  auto channel = grpc::CreateChannel("localhost:50051", grpc::InsecureChannelCredentials());
+  grpc_instrumentation::LogExporter exporter{std::chrono::seconds(60)};
+
+  auto channel = grpc::experimental::CreateCustomChannelWithInterceptors(
+      "localhost:50051", grpc::InsecureChannelCredentials(), grpc::ChannelArguments(),
+      grpc_instrumentation::ClientInterceptors());
   auto stub = std::make_shared<doc_db::DocDb::Stub>(doc_db::DocDb::Stub(channel));
   auto client = std::make_shared<doc_db::DocDbClient>(doc_db::DocDbClient{stub, "golf"});
   auto game_store = std::make_shared<golf::DocDbGameStore>(golf::DocDbGameStore{client});
   golf::GameManager game_manager{game_store};
-  auto handler = std::make_shared<golf_service::Handler>(golf_service::Handler{game_manager});
-  rh.router_ = golf_service::Router{handler};
+
+  golf_stats::DocDbStatsStore stats_store{client, "golf"};
+  auto stats = std::make_shared<golf_stats::StatsAggregator>();
+  for (int attempt = 1;; attempt++) {
+    auto status = stats->restore(stats_store);
+    if (status.ok()) {
+      break;
+    }
+    if (attempt == kStatsRestoreAttempts) {
+      LOG(ERROR) << "cannot restore stats: " << status;
+      return 1;
+    }
+    LOG(WARNING) << "restoring stats failed, retrying: " << status;
+    std::this_thread::sleep_for(kStatsRestoreBackoff * attempt);
+  }
+
+  auto handler =
+      std::make_shared<golf_service::Handler>(golf_service::Handler{game_manager, stats});
+  rh.router_ = golf_service::Router{handler, stats};
 
   auto socket = mg_http_listen(&mgr, "http://0.0.0.0:8000", do_route, nullptr);
   if (socket == nullptr || !socket->is_listening) {
@@ -41,6 +75,18 @@ int main() {
     return 1;
   }
   std::cout << "listening on port 8000\n";
+  // Saving is a DocDb round-trip, so it runs off the event loop rather than stalling every
+  // websocket while it waits. The loop below never returns, so neither does this thread.
+  std::thread stats_flusher{[&stats_store, stats] {
+    for (;;) {
+      std::this_thread::sleep_for(kStatsFlushInterval);
+      // A failed save stays pending and is retried next time.
+      if (auto status = stats->flush(stats_store); !status.ok()) {
+        LOG(WARNING) << "saving stats failed: " << status;
+      }
+    }
+  }};
+  stats_flusher.detach();
   for (;;) {
     mg_mgr_poll(&mgr, 500);
   }
@@ -65,6 +65,7 @@ golf_ws::GameStateResponse GameStateMapper::gameStateToProto(const GameStatePtr&
   }
 
   proto.set_your_turn(state->getWhoseTurn() == index);
+  proto.set_legal_actions(state->legalActions(index));
 
   return proto;
 }
@@ -38,4 +38,5 @@ TEST(GameStateMapper, GameStateToProto) {
   EXPECT_EQ(proto.top_discard(), "8_H");
   EXPECT_FALSE(proto.has_top_draw());
   EXPECT_TRUE(proto.your_turn());
+  EXPECT_EQ(proto.legal_actions(), state->legalActions(0));
 }
@@ -2,71 +2,38 @@
 
 #include <google/protobuf/util/json_util.h>
 
+#include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "absl/status/statusor.h"
+#include "cpp/golf_pipeline/execute_stage.h"
+#include "cpp/golf_service/game_state_mapper.h"
+#include "cpp/golf_stats/stats_stage.h"
 #include "mongoose.h"
 
+using golf_pipeline::Command;
+using golf_pipeline::CommandType;
+using golf_pipeline::Exchange;
+using golf_pipeline::ExecuteStage;
+using golf_pipeline::RateLimitStage;
+using golf_pipeline::Stage;
 using golf_service::GolfServiceRequest;
-using golf_ws::RegisterUserRequest;
 using golf_ws::RequestWrapper;
 using std::string;
 
 namespace golf_service {
 
-template <RequestWrapper::KindCase T>
-auto Handler::validRequestType(const GolfServiceRequest &serviceRequest, struct mg_connection *c)
-    -> bool {
-  if (serviceRequest.kind_case() != T) {
-    string output("error|invalid request");
-    mg_ws_send(c, output.c_str(), output.size(), WEBSOCKET_OP_TEXT);
-    return false;
-  }
-  return true;
-}
-
-void Handler::registerUser(const GolfServiceRequest &serviceRequest, struct mg_connection *c) {
-  if (!validRequestType<RequestWrapper::KindCase::kRegisterUserRequest>(serviceRequest, c)) {
-    return;
-  }
+typedef struct ::mg_connection *Connection;
 
-  const RegisterUserRequest &registerUserRequest = serviceRequest.register_user_request();
-  // don't allow re-registration yet
-  for (auto i = connectionsByUser.begin(); i != connectionsByUser.end(); i++) {
-    if (connectionsByUser.at(i->first) == c) {
-      string output("error|already registered");
-      mg_ws_send(c, output.c_str(), output.size(), WEBSOCKET_OP_TEXT);
-      return;
-    }
-  }
-
-  auto res = gm.registerUser(registerUserRequest.username());
-  if (!res.ok()) {
-    string output("error|");
-    output.append(res.status().message());
-    mg_ws_send(c, output.c_str(), output.size(), WEBSOCKET_OP_TEXT);
-    return;
-  }
-
-  string user = *res;
-  connectionsByUser.insert({user, c});
-  string output(R"({"inGame":false,"username":")" + user + "\"}");
+namespace {
+void send(Connection c, const string &output) {
   mg_ws_send(c, output.c_str(), output.size(), WEBSOCKET_OP_TEXT);
 }
 
-bool Handler::usernameMismatch(const string &username, struct mg_connection *c) {
-  if (connectionsByUser.find(username) == connectionsByUser.end() ||
-      connectionsByUser.at(username) != c) {
-    string output("error|username mismatch");
-    mg_ws_send(c, output.c_str(), output.size(), WEBSOCKET_OP_TEXT);
-    return true;
-  }
-  return false;
-}
-
-auto Handler::validatePosition(const golf_ws::Position &position, struct mg_connection *c)
-    -> absl::StatusOr<golf::Position> {
+auto toPosition(const golf_ws::Position &position) -> absl::StatusOr<golf::Position> {
   switch (position) {
     case golf_ws::Position::TOP_LEFT:
       return golf::Position::TopLeft;
@@ -77,143 +44,196 @@ auto Handler::validatePosition(const golf_ws::Position &position, struct mg_conn
     case golf_ws::Position::BOTTOM_RIGHT:
       return golf::Position::BottomRight;
     default:
-      string output("error|invalid position");
-      mg_ws_send(c, output.c_str(), output.size(), WEBSOCKET_OP_TEXT);
       return absl::InvalidArgumentError("invalid position");
   }
 }
 
-string Handler::userStateToJson(const golf::GameStatePtr &gameStatePtr, const string &user) {
-  const auto stateForUser = gameStateMapper.gameStateToProto(gameStatePtr, user);
-  std::string userJson;
-  auto status = google::protobuf::util::MessageToJsonString(stateForUser, &userJson);
-  if (status.ok()) {
-    return userJson;
-  }
-  return "UNKNOWN";
-}
-
-void Handler::handleGameManagerResult(const absl::StatusOr<golf::GameStatePtr> &res,
-                                      struct mg_connection *c) {
-  if (!res.ok()) {
-    string output("error|");
-    output.append(res.status().message());
-    mg_ws_send(c, output.c_str(), output.size(), WEBSOCKET_OP_TEXT);
-    return;
-  }
-
-  const auto &gameStatePtr = *res;
-  for (auto &user : gm.getUsersByGameId(gameStatePtr->getGameId())) {
-    const auto userJson = userStateToJson(gameStatePtr, user);
-    auto userConnection = connectionsByUser.at(user);
-    mg_ws_send(userConnection, userJson.c_str(), userJson.size(), WEBSOCKET_OP_TEXT);
-  }
-}
-
-void Handler::newGame(const GolfServiceRequest &serviceRequest, struct mg_connection *c) {
-  if (!validRequestType<RequestWrapper::KindCase::kNewGameRequest>(serviceRequest, c)) {
-    return;
-  }
-
-  auto &newGameRequest = serviceRequest.new_game_request();
-  if (usernameMismatch(newGameRequest.username(), c)) {
-    return;
-  }
-
-  auto res = gm.newGame(newGameRequest.username(), newGameRequest.number_of_players());
-  handleGameManagerResult(res, c);
-}
-
-void Handler::joinGame(const GolfServiceRequest &serviceRequest, struct mg_connection *c) {
-  if (!validRequestType<RequestWrapper::KindCase::kJoinGameRequest>(serviceRequest, c)) {
-    return;
-  }
-
-  auto &joinGameRequest = serviceRequest.join_game_request();
-  if (usernameMismatch(joinGameRequest.username(), c)) {
-    return;
-  }
-  auto res = gm.joinGame(joinGameRequest.game_id(), joinGameRequest.username());
-  handleGameManagerResult(res, c);
-}
-
-void Handler::peekAtDrawPile(const GolfServiceRequest &serviceRequest, struct mg_connection *c) {
-  if (!validRequestType<RequestWrapper::KindCase::kPeekRequest>(serviceRequest, c)) {
-    return;
-  }
-
-  auto &peekRequest = serviceRequest.peek_request();
-  if (usernameMismatch(peekRequest.username(), c)) {
-    return;
-  }
-  auto res = gm.peekAtDrawPile(peekRequest.game_id(), peekRequest.username());
-  handleGameManagerResult(res, c);
-}
-
-void Handler::discardFromDrawPile(const GolfServiceRequest &serviceRequest,
-                                  struct mg_connection *c) {
-  if (!validRequestType<RequestWrapper::KindCase::kDiscardDrawRequest>(serviceRequest, c)) {
-    return;
-  }
-
-  auto &discardDrawRequest = serviceRequest.discard_draw_request();
-  if (usernameMismatch(discardDrawRequest.username(), c)) {
-    return;
-  }
-  auto res = gm.swapDrawForDiscardPile(discardDrawRequest.game_id(), discardDrawRequest.username());
-  handleGameManagerResult(res, c);
-}
-
-void Handler::swapForDrawPile(const GolfServiceRequest &serviceRequest, struct mg_connection *c) {
-  if (!validRequestType<RequestWrapper::KindCase::kSwapForDrawRequest>(serviceRequest, c)) {
-    return;
+struct CommandSpec {
+  CommandType type;
+  RequestWrapper::KindCase kind;
+};
+
+const std::unordered_map<string, CommandSpec> COMMANDS{
+    {"register", {CommandType::RegisterUser, RequestWrapper::KindCase::kRegisterUserRequest}},
+    {"new", {CommandType::NewGame, RequestWrapper::KindCase::kNewGameRequest}},
+    {"join", {CommandType::JoinGame, RequestWrapper::KindCase::kJoinGameRequest}},
+    {"peek", {CommandType::Peek, RequestWrapper::KindCase::kPeekRequest}},
+    {"discardDraw", {CommandType::DiscardDraw, RequestWrapper::KindCase::kDiscardDrawRequest}},
+    {"swapDraw", {CommandType::SwapForDraw, RequestWrapper::KindCase::kSwapForDrawRequest}},
+    {"swapDiscard",
+     {CommandType::SwapForDiscard, RequestWrapper::KindCase::kSwapForDiscardRequest}},
+    {"knock", {CommandType::Knock, RequestWrapper::KindCase::kKnockRequest}},
+};
+
+// A connection may register exactly one user, and may only act as that user.
+class WsAuthenticateStage final : public Stage<Connection> {
+ public:
+  explicit WsAuthenticateStage(std::shared_ptr<ConnectionsByUser> connections)
+      : connections_(std::move(connections)) {}
+
+  void process(std::span<Exchange<Connection>> batch) override {
+    for (auto &exchange : batch) {
+      if (!exchange.ok()) {
+        continue;
+      }
+      if (exchange.command.type == CommandType::RegisterUser) {
+        // don't allow re-registration yet
+        for (auto &[_, c] : *connections_) {
+          if (c == exchange.origin) {
+            exchange.status = absl::AlreadyExistsError("already registered");
+            break;
+          }
+        }
+        continue;
+      }
+      auto it = connections_->find(exchange.command.user_id);
+      if (it == connections_->end() || it->second != exchange.origin) {
+        exchange.status = absl::PermissionDeniedError("username mismatch");
+      }
+    }
   }
 
-  auto &swapForDrawRequest = serviceRequest.swap_for_draw_request();
-  if (usernameMismatch(swapForDrawRequest.username(), c)) {
-    return;
+ private:
+  std::shared_ptr<ConnectionsByUser> connections_;
+};
+
+// Answers the sender: errors and registrations. Game states go out through WsPublishStage.
+class WsEncodeStage final : public Stage<Connection> {
+ public:
+  explicit WsEncodeStage(std::shared_ptr<ConnectionsByUser> connections)
+      : connections_(std::move(connections)) {}
+
+  void process(std::span<Exchange<Connection>> batch) override {
+    for (auto &exchange : batch) {
+      if (!exchange.ok()) {
+        string output("error|");
+        output.append(exchange.status.message());
+        send(exchange.origin, output);
+      } else if (exchange.command.type == CommandType::RegisterUser) {
+        const string &user = exchange.command.user_id;
+        connections_->insert({user, exchange.origin});
+        send(exchange.origin, R"({"inGame":false,"username":")" + user + "\"}");
+      }
+    }
   }
 
-  auto positionRes = validatePosition(swapForDrawRequest.position(), c);
-  if (!positionRes.ok()) {
-    return;
+ private:
+  std::shared_ptr<ConnectionsByUser> connections_;
+};
+
+// Sends every player in the game their own view of the new state.
+class WsPublishStage final : public Stage<Connection> {
+ public:
+  explicit WsPublishStage(std::shared_ptr<ConnectionsByUser> connections)
+      : connections_(std::move(connections)) {}
+
+  void process(std::span<Exchange<Connection>> batch) override {
+    for (auto &exchange : batch) {
+      if (!exchange.ok() || exchange.game_state == nullptr) {
+        continue;
+      }
+      for (auto &p : exchange.game_state->getPlayers()) {
+        if (!p.getName().has_value()) {
+          continue;
+        }
+        auto userConnection = connections_->find(p.getName().value());
+        if (userConnection != connections_->end()) {
+          send(userConnection->second, userStateToJson(exchange.game_state, p.getName().value()));
+        }
+      }
+    }
   }
 
-  auto res =
-      gm.swapForDrawPile(swapForDrawRequest.game_id(), swapForDrawRequest.username(), *positionRes);
-  handleGameManagerResult(res, c);
-}
-
-void Handler::swapForDiscardPile(const GolfServiceRequest &serviceRequest,
-                                 struct mg_connection *c) {
-  if (!validRequestType<RequestWrapper::KindCase::kSwapForDiscardRequest>(serviceRequest, c)) {
-    return;
+ private:
+  string userStateToJson(const golf::GameStatePtr &gameStatePtr, const string &user) const {
+    const auto stateForUser = gameStateMapper.gameStateToProto(gameStatePtr, user);
+    std::string userJson;
+    auto status = google::protobuf::util::MessageToJsonString(stateForUser, &userJson);
+    if (status.ok()) {
+      return userJson;
+    }
+    return "UNKNOWN";
   }
 
-  auto &swapForDiscardRequest = serviceRequest.swap_for_discard_request();
-  if (usernameMismatch(swapForDiscardRequest.username(), c)) {
-    return;
+  std::shared_ptr<ConnectionsByUser> connections_;
+  golf::GameStateMapper gameStateMapper{{}};
+};
+}  // namespace
+
+Handler::Handler(golf::GameManager gm_, std::shared_ptr<golf_stats::StatsAggregator> stats,
+                 std::shared_ptr<golf_pipeline::RateLimiter> limiter)
+    : connectionsByUser(std::make_shared<ConnectionsByUser>()),
+      pipeline({std::make_shared<WsAuthenticateStage>(connectionsByUser),
+                std::make_shared<RateLimitStage<Connection>>(std::move(limiter)),
+                std::make_shared<ExecuteStage<Connection>>(
+                    std::make_shared<golf::GameManager>(std::move(gm_))),
+                std::make_shared<golf_stats::StatsStage<Connection>>(std::move(stats)),
+                std::make_shared<WsEncodeStage>(connectionsByUser),
+                std::make_shared<WsPublishStage>(connectionsByUser)}) {}
+
+auto Handler::decode(const GolfServiceRequest &serviceRequest) -> StatusOr<Command> {
+  auto spec = COMMANDS.find(serviceRequest.command());
+  if (spec == COMMANDS.end()) {
+    return absl::InvalidArgumentError("bad_command");
   }
-  auto positionRes = validatePosition(swapForDiscardRequest.position(), c);
-  if (!positionRes.ok()) {
-    return;
+  if (serviceRequest.kind_case() != spec->second.kind) {
+    return absl::InvalidArgumentError("invalid request");
   }
-  auto res = gm.swapForDiscardPile(swapForDiscardRequest.game_id(),
-                                   swapForDiscardRequest.username(), *positionRes);
-  handleGameManagerResult(res, c);
-}
 
-void Handler::knock(const GolfServiceRequest &serviceRequest, struct mg_connection *c) {
-  if (!validRequestType<RequestWrapper::KindCase::kKnockRequest>(serviceRequest, c)) {
-    return;
+  Command command{spec->second.type};
+  if (serviceRequest.has_id()) {
+    command.request_id = serviceRequest.id();
   }
-
-  auto &knockRequest = serviceRequest.knock_request();
-  if (usernameMismatch(knockRequest.username(), c)) {
-    return;
+  switch (serviceRequest.kind_case()) {
+    case RequestWrapper::KindCase::kRegisterUserRequest:
+      command.user_id = serviceRequest.register_user_request().username();
+      break;
+    case RequestWrapper::KindCase::kNewGameRequest:
+      command.user_id = serviceRequest.new_game_request().username();
+      command.number_of_players = serviceRequest.new_game_request().number_of_players();
+      break;
+    case RequestWrapper::KindCase::kJoinGameRequest:
+      command.user_id = serviceRequest.join_game_request().username();
+      command.game_id = serviceRequest.join_game_request().game_id();
+      break;
+    case RequestWrapper::KindCase::kPeekRequest:
+      command.user_id = serviceRequest.peek_request().username();
+      command.game_id = serviceRequest.peek_request().game_id();
+      break;
+    case RequestWrapper::KindCase::kDiscardDrawRequest:
+      command.user_id = serviceRequest.discard_draw_request().username();
+      command.game_id = serviceRequest.discard_draw_request().game_id();
+      break;
+    case RequestWrapper::KindCase::kSwapForDrawRequest: {
+      auto &request = serviceRequest.swap_for_draw_request();
+      auto position = toPosition(request.position());
+      if (!position.ok()) {
+        return position.status();
+      }
+      command.user_id = request.username();
+      command.game_id = request.game_id();
+      command.position = *position;
+      break;
+    }
+    case RequestWrapper::KindCase::kSwapForDiscardRequest: {
+      auto &request = serviceRequest.swap_for_discard_request();
+      auto position = toPosition(request.position());
+      if (!position.ok()) {
+        return position.status();
+      }
+      command.user_id = request.username();
+      command.game_id = request.game_id();
+      command.position = *position;
+      break;
+    }
+    case RequestWrapper::KindCase::kKnockRequest:
+      command.user_id = serviceRequest.knock_request().username();
+      command.game_id = serviceRequest.knock_request().game_id();
+      break;
+    default:
+      return absl::InvalidArgumentError("invalid request");
   }
-  auto res = gm.knock(knockRequest.game_id(), knockRequest.username());
-  handleGameManagerResult(res, c);
+  return command;
 }
 
 void Handler::handleMessage(struct mg_ws_message *wm, struct mg_connection *c) {
@@ -222,19 +242,20 @@ void Handler::handleMessage(struct mg_ws_message *wm, struct mg_connection *c) {
   auto status = google::protobuf::util::JsonStringToMessage(requestText, &requestWrapper);
   if (!status.ok()) {
     auto messageString = std::string{status.message()};
-    mg_ws_send(c, messageString.c_str(), messageString.size(), WEBSOCKET_OP_TEXT);
+    send(c, messageString);
     return;
   }
 
-  auto command = handlers.find(requestWrapper.command());
-  if (command == handlers.end()) {
-    std::string response = "error|bad_command";
-    mg_ws_send(c, response.c_str(), response.size(), WEBSOCKET_OP_TEXT);
+  auto command = decode(requestWrapper);
+  if (!command.ok()) {
+    string output("error|");
+    output.append(command.status().message());
+    send(c, output);
     return;
   }
 
-  auto handler = command->second;
-  (this->*(handler))(requestWrapper, c);
+  Exchange<Connection> exchange{c, std::move(*command)};
+  pipeline.process(exchange);
 }
 
 void Handler::handleDisconnect(struct ::mg_connection *c) {
@@ -2,12 +2,18 @@
 #define CPP_GOLF_SERVICE_HANDLERS_H
 
 #include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "absl/status/statusor.h"
 #include "cpp/cards/golf/game_manager.h"
-#include "cpp/golf_service/game_state_mapper.h"
+#include "cpp/golf_pipeline/command.h"
+#include "cpp/golf_pipeline/pipeline.h"
+#include "cpp/golf_pipeline/rate_limit_stage.h"
+#include "cpp/golf_stats/stats_aggregator.h"
 #include "mongoose.h"
 #include "protos/golf_ws/golf_ws.pb.h"
 
@@ -17,55 +23,31 @@ using golf_ws::RequestWrapper;
 using std::string;
 
 typedef golf_ws::RequestWrapper GolfServiceRequest;
-typedef std::function<void(const GolfServiceRequest &, struct ::mg_connection *)> handler;
-typedef std::function<absl::StatusOr<GolfServiceRequest>(std::vector<std::string>)> argReader;
 typedef absl::StatusOr<GolfServiceRequest> StatusOrRequest;
+typedef std::unordered_map<string, struct ::mg_connection *> ConnectionsByUser;
 
 void handleDisconnect(struct ::mg_connection *c);
 void handleMessage(struct ::mg_ws_message *wm, struct ::mg_connection *c);
 
+// Websocket adapter for the golf command pipeline: decodes JSON requests into
+// golf_pipeline::Commands and plugs in the websocket authenticate, encode and publish stages.
+// Each user's commands are rate limited by `limiter` once authenticated.
 class Handler {
  public:
-  explicit Handler(golf::GameManager gm_) : gm(std::move(gm_)) {}
+  Handler(golf::GameManager gm_, std::shared_ptr<golf_stats::StatsAggregator> stats,
+          std::shared_ptr<golf_pipeline::RateLimiter> limiter =
+              std::make_shared<golf_pipeline::RateLimiter>(
+                  golf_pipeline::RateLimiter::kDefaultCommandsPerSecond,
+                  golf_pipeline::RateLimiter::kDefaultBurst));
   void handleDisconnect(struct ::mg_connection *c);
   void handleMessage(struct ::mg_ws_message *wm, struct ::mg_connection *c);
 
  private:
-  template <RequestWrapper::KindCase T>
-  bool validRequestType(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
+  [[nodiscard]] static StatusOr<golf_pipeline::Command> decode(
+      const GolfServiceRequest &serviceRequest);
 
-  void registerUser(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
-  bool usernameMismatch(const string &username, struct mg_connection *c);
-  StatusOr<golf::Position> validatePosition(const golf_ws::Position &position,
-                                            struct mg_connection *c);
-  string userStateToJson(const golf::GameStatePtr &gameStatePtr, const string &user);
-
-  void handleGameManagerResult(const absl::StatusOr<golf::GameStatePtr> &res,
-                               struct mg_connection *c);
-  void newGame(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
-  void joinGame(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
-  void peekAtDrawPile(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
-  void discardFromDrawPile(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
-  void swapForDrawPile(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
-  void swapForDiscardPile(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
-  void knock(const GolfServiceRequest &serviceRequest, struct mg_connection *c);
-
-  // TODO: make this map<string, pair<handler, parser>> ?
-
-  typedef void (Handler::*handler_method_t)(const GolfServiceRequest &, struct ::mg_connection *);
-  std::unordered_map<string, handler_method_t> handlers{
-      {"register", &Handler::registerUser},
-      {"new", &Handler::newGame},
-      {"join", &Handler::joinGame},
-      {"peek", &Handler::peekAtDrawPile},
-      {"discardDraw", &Handler::discardFromDrawPile},
-      {"swapDraw", &Handler::swapForDrawPile},
-      {"swapDiscard", &Handler::swapForDiscardPile},
-      {"knock", &Handler::knock}};
-
-  golf::GameManager gm;
-  golf::GameStateMapper gameStateMapper{{}};
-  std::unordered_map<std::string, mg_connection *> connectionsByUser;
+  std::shared_ptr<ConnectionsByUser> connectionsByUser;
+  golf_pipeline::Pipeline<struct ::mg_connection *> pipeline;
 };
 
 }  // namespace golf_service
@@ -1,5 +1,6 @@
 #include "cpp/golf_service/router.h"
 
+#include "cpp/lock_profiling/profiled_mutex.h"
 #include "mongoose.h"
 
 namespace golf_service {
@@ -9,7 +10,11 @@ void Router::route(struct mg_connection *c, int ev, void *ev_data) const {
     if (mg_match(hm->uri, mg_str("/golf/ws"), nullptr)) {
       mg_ws_upgrade(c, hm, nullptr);
     } else if (mg_match(hm->uri, mg_str("/golf/stats"), nullptr)) {
-      mg_http_reply(c, 200, "", "\"stats\": []");
+      auto stats = stats_->snapshot().toJson();
+      mg_http_reply(c, 200, "Content-Type: application/json\r\n", "%s", stats.c_str());
+    } else if (mg_match(hm->uri, mg_str("/golf/stats/locks"), nullptr)) {
+      auto locks = lock_profiling::ToJson(lock_profiling::LockProfiler::Global().snapshot());
+      mg_http_reply(c, 200, "Content-Type: application/json\r\n", "%s", locks.c_str());
     } else if (mg_match(hm->uri, mg_str("/golf/ui"), nullptr)) {
       struct mg_http_serve_opts opts = {.root_dir = nullptr};
       mg_http_serve_file(c, hm, "web/golf_ui/index.html", &opts);
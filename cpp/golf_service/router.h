@@ -1,17 +1,23 @@
 #ifndef CPP_GOLF_SERVICE_ROUTER_H
 #define CPP_GOLF_SERVICE_ROUTER_H
 
+#include <memory>
+#include <utility>
+
 #include "cpp/golf_service/handlers.h"
+#include "cpp/golf_stats/stats_aggregator.h"
 #include "mongoose.h"
 
 namespace golf_service {
 class Router {
  public:
-  explicit Router(std::shared_ptr<Handler> handler) : handler_(handler) {}
+  Router(std::shared_ptr<Handler> handler, std::shared_ptr<golf_stats::StatsAggregator> stats)
+      : handler_(std::move(handler)), stats_(std::move(stats)) {}
   void route(struct ::mg_connection *c, int ev, void *ev_data) const;
 
  private:
   std::shared_ptr<Handler> handler_;
+  std::shared_ptr<golf_stats::StatsAggregator> stats_;
 };
 }  // namespace golf_service
 
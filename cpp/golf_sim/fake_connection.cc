@@ -0,0 +1,50 @@
+#include "cpp/golf_sim/fake_connection.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongoose.h"
+
+namespace golf_sim {
+
+FakeConnection::~FakeConnection() { mg_iobuf_free(&connection_.send); }
+
+struct ::mg_ws_message FakeConnection::message(const string& text) {
+  struct ::mg_ws_message message {};
+  message.data = mg_str_n(text.c_str(), text.size());
+  message.flags = WEBSOCKET_OP_TEXT;
+  return message;
+}
+
+std::vector<string> FakeConnection::takeMessages() {
+  std::vector<string> messages;
+  auto& sent = connection_.send;
+  size_t at = 0;
+  // Unmasked server frames: opcode byte, 7-bit length or 126/127 and a 16/64-bit big-endian one.
+  while (at + 2 <= sent.len) {
+    uint64_t len = sent.buf[at + 1] & 0x7f;
+    size_t header = 2;
+    int extended = len == 126 ? 2 : len == 127 ? 8 : 0;
+    if (at + header + extended > sent.len) {
+      break;
+    }
+    if (extended > 0) {
+      len = 0;
+      for (int i = 0; i < extended; i++) {
+        len = len << 8 | sent.buf[at + header + i];
+      }
+      header += extended;
+    }
+    if (at + header + len > sent.len) {
+      break;
+    }
+    messages.emplace_back(reinterpret_cast<const char*>(sent.buf + at + header), len);
+    at += header + len;
+  }
+  mg_iobuf_del(&sent, 0, at);
+  return messages;
+}
+
+}  // namespace golf_sim
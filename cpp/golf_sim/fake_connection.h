@@ -0,0 +1,39 @@
+#ifndef CPP_GOLF_SIM_FAKE_CONNECTION_H
+#define CPP_GOLF_SIM_FAKE_CONNECTION_H
+
+#include <string>
+#include <vector>
+
+#include "mongoose.h"
+
+namespace golf_sim {
+
+using std::string;
+
+// A websocket connection with no socket or event manager behind it, for driving
+// golf_service::Handler directly. mg_ws_send only frames a message into the connection's send
+// buffer, which the manager would flush on its next poll; here takeMessages() reads the frames
+// back out instead.
+class FakeConnection {
+ public:
+  FakeConnection() = default;
+  FakeConnection(const FakeConnection&) = delete;
+  FakeConnection& operator=(const FakeConnection&) = delete;
+  ~FakeConnection();
+
+  [[nodiscard]] struct ::mg_connection* get() { return &connection_; }
+
+  // A text frame from the client, as the router hands it to Handler::handleMessage. Handler
+  // reads the payload as a C string, so `text` must outlive the message.
+  [[nodiscard]] static struct ::mg_ws_message message(const string& text);
+
+  // The payloads sent since the last call, oldest first.
+  [[nodiscard]] std::vector<string> takeMessages();
+
+ private:
+  struct ::mg_connection connection_ {};
+};
+
+}  // namespace golf_sim
+
+#endif
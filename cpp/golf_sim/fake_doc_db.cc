@@ -0,0 +1,131 @@
+#include "cpp/golf_sim/fake_doc_db.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "absl/strings/str_format.h"
+
+namespace golf_sim {
+namespace {
+// The standard normal's 99th percentile.
+constexpr double kZ99 = 2.3263478740408408;
+}  // namespace
+
+Scheduler::Clock::duration LatencyModel::sample(std::mt19937_64& rng) const {
+  double median_us = static_cast<double>(median.count());
+  double sigma = p99 > median ? std::log(static_cast<double>(p99.count()) / median_us) / kZ99 : 0;
+  double us = median_us * std::exp(sigma * std::normal_distribution<double>{}(rng));
+  return std::chrono::duration_cast<Scheduler::Clock::duration>(
+      std::chrono::duration<double, std::micro>(us));
+}
+
+FakeDocDbStub::Outcome FakeDocDbStub::begin() {
+  calls_++;
+  scheduler_.advance(faults_.latency.sample(scheduler_.rng()));
+  double draw = std::uniform_real_distribution<double>{}(scheduler_.rng());
+  if (draw < faults_.failure_rate) {
+    return Outcome::kFail;
+  }
+  if (draw < faults_.failure_rate + faults_.lost_reply_rate) {
+    return Outcome::kLoseReply;
+  }
+  return Outcome::kOk;
+}
+
+grpc::Status FakeDocDbStub::finish(Outcome outcome) {
+  if (outcome == Outcome::kLoseReply) {
+    failures_++;
+    return {grpc::StatusCode::DEADLINE_EXCEEDED, "reply lost"};
+  }
+  return grpc::Status::OK;
+}
+
+grpc::Status FakeDocDbStub::InsertDoc(grpc::ClientContext* context,
+                                      const doc_db::InsertDocRequest& request,
+                                      doc_db::InsertDocResponse* response) {
+  auto outcome = begin();
+  if (outcome == Outcome::kFail) {
+    failures_++;
+    return {grpc::StatusCode::UNAVAILABLE, "injected failure"};
+  }
+  // Mongo ObjectIds print as 24 hex digits.
+  string id = absl::StrFormat("%024x", next_id_++);
+  auto& doc = collections_[request.collection()][id];
+  doc.set_id(id);
+  doc.set_version(nextVersion());
+  doc.set_bytes(request.doc().bytes());
+  *doc.mutable_tags() = request.doc().tags();
+  response->set_id(id);
+  response->set_version(doc.version());
+  return finish(outcome);
+}
+
+grpc::Status FakeDocDbStub::UpdateDoc(grpc::ClientContext* context,
+                                      const doc_db::UpdateDocRequest& request,
+                                      doc_db::UpdateDocResponse* response) {
+  auto outcome = begin();
+  if (outcome == Outcome::kFail) {
+    failures_++;
+    return {grpc::StatusCode::UNAVAILABLE, "injected failure"};
+  }
+  auto& docs = collections_[request.collection()];
+  auto it = docs.find(request.id());
+  // The service matches on id and version together, so a stale version reads as a missing doc.
+  if (it == docs.end() || it->second.version() != request.version()) {
+    return {grpc::StatusCode::NOT_FOUND, "unknown document"};
+  }
+  it->second.set_version(nextVersion());
+  it->second.set_bytes(request.doc().bytes());
+  *it->second.mutable_tags() = request.doc().tags();
+  response->set_id(request.id());
+  response->set_version(it->second.version());
+  return finish(outcome);
+}
+
+grpc::Status FakeDocDbStub::FindDocById(grpc::ClientContext* context,
+                                        const doc_db::FindDocByIdRequest& request,
+                                        doc_db::FindDocByIdResponse* response) {
+  auto outcome = begin();
+  if (outcome == Outcome::kFail) {
+    failures_++;
+    return {grpc::StatusCode::UNAVAILABLE, "injected failure"};
+  }
+  auto& docs = collections_[request.collection()];
+  auto it = docs.find(request.id());
+  if (it == docs.end()) {
+    return {grpc::StatusCode::NOT_FOUND, "not found"};
+  }
+  *response->mutable_doc() = it->second;
+  return finish(outcome);
+}
+
+grpc::Status FakeDocDbStub::FindDoc(grpc::ClientContext* context,
+                                    const doc_db::FindDocRequest& request,
+                                    doc_db::FindDocResponse* response) {
+  auto outcome = begin();
+  if (outcome == Outcome::kFail) {
+    failures_++;
+    return {grpc::StatusCode::UNAVAILABLE, "injected failure"};
+  }
+  for (auto& [id, doc] : collections_[request.collection()]) {
+    bool matches = true;
+    for (auto& [key, value] : request.tags()) {
+      auto tag = doc.tags().find(key);
+      if (tag == doc.tags().end() || tag->second != value) {
+        matches = false;
+        break;
+      }
+    }
+    if (matches) {
+      *response->mutable_doc() = doc;
+      return finish(outcome);
+    }
+  }
+  return {grpc::StatusCode::NOT_FOUND, "not found"};
+}
+
+}  // namespace golf_sim
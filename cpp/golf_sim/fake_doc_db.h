@@ -0,0 +1,120 @@
+#ifndef CPP_GOLF_SIM_FAKE_DOC_DB_H
+#define CPP_GOLF_SIM_FAKE_DOC_DB_H
+
+#include <grpcpp/grpcpp.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "cpp/golf_sim/scheduler.h"
+#include "protos/doc_db/doc_db.grpc.pb.h"
+
+namespace golf_sim {
+
+using std::string;
+
+// Log-normal RPC latency given by its median and 99th percentile, the two numbers a doc_db
+// dashboard shows.
+struct LatencyModel {
+  std::chrono::microseconds median{500};
+  std::chrono::microseconds p99{5000};
+
+  [[nodiscard]] Scheduler::Clock::duration sample(std::mt19937_64& rng) const;
+};
+
+struct DocDbFaults {
+  LatencyModel latency;
+  // Calls failed with UNAVAILABLE before they reach the database.
+  double failure_rate = 0;
+  // Calls that run and then fail with DEADLINE_EXCEEDED, as when the reply is lost. A write has
+  // then taken effect, which the caller cannot tell from a failure.
+  double lost_reply_rate = 0;
+};
+
+// doc_db as the Rust service behaves, in memory and in virtual time: every blocking call advances
+// the scheduler by a sampled latency and may fail as `faults` says. Documents are versioned and an
+// update must name the current version. Ids and versions come from counters, so runs with the
+// same seed see the same ones.
+//
+// Not thread-safe. requires external synchronization
+class FakeDocDbStub final : public doc_db::DocDb::StubInterface {
+ public:
+  FakeDocDbStub(Scheduler& scheduler, DocDbFaults faults)
+      : scheduler_(scheduler), faults_(faults) {}
+
+  grpc::Status InsertDoc(grpc::ClientContext* context, const doc_db::InsertDocRequest& request,
+                         doc_db::InsertDocResponse* response) override;
+  grpc::Status UpdateDoc(grpc::ClientContext* context, const doc_db::UpdateDocRequest& request,
+                         doc_db::UpdateDocResponse* response) override;
+  grpc::Status FindDocById(grpc::ClientContext* context, const doc_db::FindDocByIdRequest& request,
+                           doc_db::FindDocByIdResponse* response) override;
+  grpc::Status FindDoc(grpc::ClientContext* context, const doc_db::FindDocRequest& request,
+                       doc_db::FindDocResponse* response) override;
+
+  void setFaults(const DocDbFaults& faults) { faults_ = faults; }
+  [[nodiscard]] int64_t calls() const { return calls_; }
+  // Calls that failed, whether or not they took effect.
+  [[nodiscard]] int64_t failures() const { return failures_; }
+
+ private:
+  // How a call turns out, decided before it runs.
+  enum class Outcome { kOk, kFail, kLoseReply };
+
+  // Spends the call's latency and draws its outcome.
+  Outcome begin();
+  grpc::Status finish(Outcome outcome);
+  string nextVersion() { return "v" + std::to_string(next_version_++); }
+
+  // DocDbClient only makes blocking calls.
+  grpc::ClientAsyncResponseReaderInterface<doc_db::InsertDocResponse>* AsyncInsertDocRaw(
+      grpc::ClientContext*, const doc_db::InsertDocRequest&, grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  grpc::ClientAsyncResponseReaderInterface<doc_db::InsertDocResponse>* PrepareAsyncInsertDocRaw(
+      grpc::ClientContext*, const doc_db::InsertDocRequest&, grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  grpc::ClientAsyncResponseReaderInterface<doc_db::UpdateDocResponse>* AsyncUpdateDocRaw(
+      grpc::ClientContext*, const doc_db::UpdateDocRequest&, grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  grpc::ClientAsyncResponseReaderInterface<doc_db::UpdateDocResponse>* PrepareAsyncUpdateDocRaw(
+      grpc::ClientContext*, const doc_db::UpdateDocRequest&, grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  grpc::ClientAsyncResponseReaderInterface<doc_db::FindDocByIdResponse>* AsyncFindDocByIdRaw(
+      grpc::ClientContext*, const doc_db::FindDocByIdRequest&, grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  grpc::ClientAsyncResponseReaderInterface<doc_db::FindDocByIdResponse>*
+  PrepareAsyncFindDocByIdRaw(grpc::ClientContext*, const doc_db::FindDocByIdRequest&,
+                             grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  grpc::ClientAsyncResponseReaderInterface<doc_db::FindDocResponse>* AsyncFindDocRaw(
+      grpc::ClientContext*, const doc_db::FindDocRequest&, grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+  grpc::ClientAsyncResponseReaderInterface<doc_db::FindDocResponse>* PrepareAsyncFindDocRaw(
+      grpc::ClientContext*, const doc_db::FindDocRequest&, grpc::CompletionQueue*) override {
+    return nullptr;
+  }
+
+  Scheduler& scheduler_;
+  DocDbFaults faults_;
+  // Documents by collection and then id. Ids count up, so each collection is in insertion order
+  // and FindDoc's first match is the oldest, as with Mongo's natural order.
+  std::unordered_map<string, std::map<string, doc_db::Document>> collections_;
+  uint64_t next_id_ = 0;
+  uint64_t next_version_ = 0;
+  int64_t calls_ = 0;
+  int64_t failures_ = 0;
+};
+
+}  // namespace golf_sim
+
+#endif
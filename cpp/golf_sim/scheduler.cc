@@ -0,0 +1,35 @@
+#include "cpp/golf_sim/scheduler.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace golf_sim {
+
+void Scheduler::at(Clock::time_point due, Task task) {
+  queue_.push_back({due, rng_(), std::move(task)});
+  std::push_heap(queue_.begin(), queue_.end());
+}
+
+bool Scheduler::step() {
+  if (queue_.empty()) {
+    return false;
+  }
+  std::pop_heap(queue_.begin(), queue_.end());
+  Entry next = std::move(queue_.back());
+  queue_.pop_back();
+  now_ = std::max(now_, next.due);
+  next.task();
+  return true;
+}
+
+size_t Scheduler::run(Clock::time_point until, size_t max_tasks) {
+  size_t ran = 0;
+  while (ran < max_tasks && !queue_.empty() && queue_.front().due <= until) {
+    step();
+    ran++;
+  }
+  return ran;
+}
+
+}  // namespace golf_sim
@@ -0,0 +1,71 @@
+#ifndef CPP_GOLF_SIM_SCHEDULER_H
+#define CPP_GOLF_SIM_SCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace golf_sim {
+
+// A single-threaded event loop over virtual time. Tasks run in time order, and tasks due at the
+// same instant run in an order drawn from the seed, so each seed is one reproducible
+// interleaving. Time only moves when a task is due later than now or when something calls
+// advance(), e.g. a simulated RPC taking its latency; a task that falls due while that happens
+// runs late, as it would behind a busy server thread.
+//
+// Not thread-safe. requires external synchronization
+class Scheduler {
+ public:
+  // The clock whose time_point this scheduler hands out, and so what it can stand in for, e.g.
+  // golf_pipeline::RateLimiter's clock. Virtual time starts at its epoch.
+  using Clock = std::chrono::steady_clock;
+  using Task = std::function<void()>;
+
+  explicit Scheduler(uint64_t seed) : rng_(seed) {}
+
+  [[nodiscard]] Clock::time_point now() const { return now_; }
+  // A clock function reading this scheduler's time.
+  [[nodiscard]] std::function<Clock::time_point()> clock() const {
+    return [this] { return now_; };
+  }
+  // Moves time forward by `elapsed` inside the running task.
+  void advance(Clock::duration elapsed) { now_ += elapsed; }
+
+  void at(Clock::time_point due, Task task);
+  void after(Clock::duration delay, Task task) { at(now_ + delay, std::move(task)); }
+
+  // Runs the next task, first moving time up to when it is due. False if there was none.
+  bool step();
+  // Runs tasks until none are left, `until` is reached, or `max_tasks` have run. Returns how many
+  // ran.
+  size_t run(Clock::time_point until = Clock::time_point::max(),
+             size_t max_tasks = std::numeric_limits<size_t>::max());
+
+  [[nodiscard]] size_t pending() const { return queue_.size(); }
+  // The seeded generator for everything else the simulation draws.
+  [[nodiscard]] std::mt19937_64& rng() { return rng_; }
+
+ private:
+  struct Entry {
+    Clock::time_point due;
+    // Breaks ties between tasks due at the same time.
+    uint64_t order;
+    Task task;
+    // A min-heap on (due, order).
+    bool operator<(const Entry& o) const {
+      return due != o.due ? due > o.due : order > o.order;
+    }
+  };
+
+  Clock::time_point now_{};
+  std::mt19937_64 rng_;
+  std::vector<Entry> queue_;
+};
+
+}  // namespace golf_sim
+
+#endif
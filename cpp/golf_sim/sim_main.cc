@@ -0,0 +1,63 @@
+// Runs the golf service in simulation, one seed after another, e.g. to look for seeds that stall
+// a game under doc_db failures, or to see what doubling doc_db's p99 does to request latency:
+//   bazel run -c opt //cpp/golf_sim:sim -- --runs=1000 --lost_reply_rate=0.01
+//   bazel run -c opt //cpp/golf_sim:sim -- --players=200 --doc_db_p99_us=20000 --runs=20
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_format.h"
+#include "cpp/golf_sim/simulation.h"
+
+ABSL_FLAG(uint64_t, seed, 1, "Seed of the first run; later runs take the seeds after it");
+ABSL_FLAG(int, runs, 1, "Runs, one seed each");
+ABSL_FLAG(int, players, 8, "Simulated players per run");
+ABSL_FLAG(int, table_size, 2, "Players per game");
+ABSL_FLAG(int64_t, doc_db_median_us, 500, "Median doc_db call latency");
+ABSL_FLAG(int64_t, doc_db_p99_us, 5000, "99th percentile doc_db call latency");
+ABSL_FLAG(double, failure_rate, 0, "Share of doc_db calls that fail without taking effect");
+ABSL_FLAG(double, lost_reply_rate, 0, "Share of doc_db calls that take effect and then fail");
+ABSL_FLAG(bool, verbose, false, "Print every run's report, not only those that stalled");
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);
+
+  golf_sim::SimulationOptions options{
+      .players = absl::GetFlag(FLAGS_players),
+      .table_size = absl::GetFlag(FLAGS_table_size),
+  };
+  options.doc_db = {
+      .latency = {.median = std::chrono::microseconds(absl::GetFlag(FLAGS_doc_db_median_us)),
+                  .p99 = std::chrono::microseconds(absl::GetFlag(FLAGS_doc_db_p99_us))},
+      .failure_rate = absl::GetFlag(FLAGS_failure_rate),
+      .lost_reply_rate = absl::GetFlag(FLAGS_lost_reply_rate),
+  };
+
+  int runs = absl::GetFlag(FLAGS_runs);
+  int stalled_runs = 0;
+  int64_t requests = 0;
+  std::chrono::duration<double, std::milli> p99_sum{};
+  auto start = std::chrono::steady_clock::now();
+  for (int run = 0; run < runs; run++) {
+    options.seed = absl::GetFlag(FLAGS_seed) + run;
+    auto report = golf_sim::Simulate(options);
+    requests += report.requests;
+    p99_sum += report.p99_latency;
+    if (report.games_stalled > 0) {
+      stalled_runs++;
+    }
+    if (report.games_stalled > 0 || absl::GetFlag(FLAGS_verbose)) {
+      std::cout << "seed " << options.seed << ": " << report.toString() << "\n";
+    }
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << absl::StrFormat(
+      "%d runs in %.2fs (%.0f runs/s, %.0f requests/s), %d with stalled games, mean p99 "
+      "latency %.2fms\n",
+      runs, seconds, runs / seconds, static_cast<double>(requests) / seconds, stalled_runs,
+      p99_sum.count() / runs);
+  return stalled_runs == 0 ? 0 : 1;
+}
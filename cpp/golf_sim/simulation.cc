@@ -0,0 +1,313 @@
+#include "cpp/golf_sim/simulation.h"
+
+#include <google/protobuf/util/json_util.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+#include "cpp/cards/golf/doc_db_game_store.h"
+#include "cpp/cards/golf/game_manager.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/doc_db_client/doc_db_client.h"
+#include "cpp/golf_service/handlers.h"
+#include "cpp/golf_sim/fake_connection.h"
+#include "cpp/golf_sim/fake_doc_db.h"
+#include "cpp/golf_sim/scheduler.h"
+#include "cpp/golf_stats/stats_aggregator.h"
+#include "protos/golf_ws/golf_ws.pb.h"
+
+namespace golf_sim {
+namespace {
+
+using Clock = Scheduler::Clock;
+using golf_ws::GameStateResponse;
+using golf_ws::RequestWrapper;
+
+struct Player {
+  enum class Phase { kRegistering, kSeating, kPlaying, kDone };
+
+  int index;
+  string name;
+  FakeConnection connection;
+  Phase phase = Phase::kRegistering;
+  // Players are seated in the order they register: the first at each table starts the game and
+  // the rest join it.
+  int table = 0;
+  bool host = false;
+  std::optional<GameStateResponse> state;
+  // Requests rejected in a row.
+  int rejected = 0;
+  bool move_pending = false;
+  // When the last message each way arrives. Each message arrives strictly after the one before it,
+  // since the scheduler runs tasks due at the same time in random order.
+  Clock::time_point to_server{};
+  Clock::time_point to_client{};
+};
+
+class Simulation {
+ public:
+  explicit Simulation(const SimulationOptions& options)
+      : options_(options),
+        scheduler_(options.seed),
+        doc_db_(std::make_shared<FakeDocDbStub>(scheduler_, options.doc_db)),
+        handler_(golf::GameManager{std::make_shared<golf::DocDbGameStore>(
+                                       std::make_shared<doc_db::DocDbClient>(doc_db_, "sim")),
+                                   static_cast<std::mt19937::result_type>(options.seed)},
+                 std::make_shared<golf_stats::StatsAggregator>(),
+                 std::make_shared<golf_pipeline::RateLimiter>(
+                     golf_pipeline::RateLimiter::kDefaultCommandsPerSecond,
+                     golf_pipeline::RateLimiter::kDefaultBurst, scheduler_.clock())) {
+    for (int i = 0; i < options.players; i++) {
+      auto player = std::make_unique<Player>();
+      player->index = i;
+      player->name = absl::StrFormat("player%05d", i);
+      players_.push_back(std::move(player));
+    }
+  }
+
+  SimulationReport run() {
+    for (auto& player : players_) {
+      auto arrival = std::uniform_int_distribution<int64_t>{
+          0, std::max<int64_t>(0, options_.arrival_window.count() - 1)}(scheduler_.rng());
+      scheduler_.after(std::chrono::milliseconds(arrival), [this, p = player.get()] { act(*p); });
+    }
+    scheduler_.run(Clock::time_point{} + options_.time_limit);
+
+    report_.games_stalled = report_.games_started - report_.games_finished;
+    report_.doc_db_calls = doc_db_->calls();
+    report_.doc_db_failures = doc_db_->failures();
+    report_.elapsed = scheduler_.now() - Clock::time_point{};
+    if (!latencies_.empty()) {
+      std::sort(latencies_.begin(), latencies_.end());
+      auto at = [&](double q) {
+        return latencies_[std::min(latencies_.size() - 1,
+                                   static_cast<size_t>(q * static_cast<double>(latencies_.size())))];
+      };
+      report_.p50_latency = at(0.5);
+      report_.p99_latency = at(0.99);
+      report_.max_latency = latencies_.back();
+    }
+    return report_;
+  }
+
+ private:
+  Clock::duration uniform(Clock::duration low, Clock::duration high) {
+    return Clock::duration{
+        std::uniform_int_distribution<Clock::rep>{low.count(), high.count()}(scheduler_.rng())};
+  }
+  Clock::duration networkDelay() { return uniform({}, options_.max_network_delay); }
+  Clock::duration thinkTime() { return uniform(options_.min_think, options_.max_think); }
+
+  // Whatever `player` should do next in its phase.
+  void act(Player& player) {
+    RequestWrapper request;
+    switch (player.phase) {
+      case Player::Phase::kRegistering:
+        request.set_command("register");
+        request.mutable_register_user_request()->set_username(player.name);
+        break;
+      case Player::Phase::kSeating:
+        if (player.host) {
+          request.set_command("new");
+          request.mutable_new_game_request()->set_username(player.name);
+          request.mutable_new_game_request()->set_number_of_players(options_.table_size);
+        } else if (auto& game_id = game_ids_[player.table]; game_id.has_value()) {
+          request.set_command("join");
+          request.mutable_join_game_request()->set_username(player.name);
+          request.mutable_join_game_request()->set_game_id(*game_id);
+        } else {
+          // The host has not heard back yet.
+          scheduler_.after(thinkTime(), [this, &player] { act(player); });
+          return;
+        }
+        break;
+      case Player::Phase::kPlaying:
+        if (!move(player, request)) {
+          return;
+        }
+        break;
+      case Player::Phase::kDone:
+        return;
+    }
+    string text;
+    (void)google::protobuf::util::MessageToJsonString(request, &text);
+    send(player, std::move(text));
+  }
+
+  // A random move from those the last state offered, if it is `player`'s turn.
+  bool move(Player& player, RequestWrapper& request) {
+    auto& state = *player.state;
+    if (!state.your_turn() || state.game_over() || state.legal_actions() == 0) {
+      return false;
+    }
+    uint32_t actions = state.legal_actions();
+    int pick = std::uniform_int_distribution<int>{0, std::popcount(actions) - 1}(scheduler_.rng());
+    for (; pick > 0; pick--) {
+      actions &= actions - 1;
+    }
+    uint32_t bit = actions & -actions;
+    auto position = [](uint32_t bits) {
+      return static_cast<golf_ws::Position>(std::countr_zero(bits));
+    };
+    if (bit == golf::kPeekAtDrawPile) {
+      request.set_command("peek");
+      request.mutable_peek_request()->set_username(player.name);
+      request.mutable_peek_request()->set_game_id(state.game_id());
+    } else if (bit == golf::kSwapDrawForDiscardPile) {
+      request.set_command("discardDraw");
+      request.mutable_discard_draw_request()->set_username(player.name);
+      request.mutable_discard_draw_request()->set_game_id(state.game_id());
+    } else if (bit == golf::kKnock) {
+      request.set_command("knock");
+      request.mutable_knock_request()->set_username(player.name);
+      request.mutable_knock_request()->set_game_id(state.game_id());
+    } else if (bit >> golf::kSwapForDiscardPileShift != 0) {
+      auto& swap = *request.mutable_swap_for_discard_request();
+      request.set_command("swapDiscard");
+      swap.set_username(player.name);
+      swap.set_game_id(state.game_id());
+      swap.set_position(position(bit >> golf::kSwapForDiscardPileShift));
+    } else {
+      auto& swap = *request.mutable_swap_for_draw_request();
+      request.set_command("swapDraw");
+      swap.set_username(player.name);
+      swap.set_game_id(state.game_id());
+      swap.set_position(position(bit >> golf::kSwapForDrawPileShift));
+    }
+    return true;
+  }
+
+  void send(Player& player, string text) {
+    auto sent_at = scheduler_.now();
+    player.to_server = std::max(player.to_server + Clock::duration{1}, sent_at + networkDelay());
+    scheduler_.at(player.to_server, [this, &player, sent_at, text = std::move(text)] {
+      report_.requests++;
+      auto message = FakeConnection::message(text);
+      handler_.handleMessage(&message, player.connection.get());
+      latencies_.push_back(scheduler_.now() - sent_at);
+      deliver();
+    });
+  }
+
+  // Sends on everything the service has written to the players' connections.
+  void deliver() {
+    for (auto& player : players_) {
+      for (auto& text : player->connection.takeMessages()) {
+        player->to_client =
+            std::max(player->to_client + Clock::duration{1}, scheduler_.now() + networkDelay());
+        scheduler_.at(player->to_client,
+                      [this, p = player.get(), text = std::move(text)] { receive(*p, text); });
+      }
+    }
+  }
+
+  void receive(Player& player, const string& text) {
+    fingerprint(player.index);
+    fingerprint((scheduler_.now() - Clock::time_point{}).count());
+    for (char c : text) {
+      fingerprint(static_cast<unsigned char>(c));
+    }
+
+    if (text.starts_with("error|")) {
+      report_.errors++;
+      if (++player.rejected > options_.retries) {
+        player.phase = Player::Phase::kDone;
+      } else {
+        scheduler_.after(thinkTime(), [this, &player] { act(player); });
+      }
+      return;
+    }
+    player.rejected = 0;
+    if (text.starts_with(R"({"inGame")")) {
+      player.phase = Player::Phase::kSeating;
+      player.table = registered_ / options_.table_size;
+      player.host = registered_ % options_.table_size == 0;
+      registered_++;
+      if (player.host) {
+        game_ids_.emplace_back();
+      }
+      scheduler_.after(thinkTime(), [this, &player] { act(player); });
+      return;
+    }
+
+    GameStateResponse state;
+    google::protobuf::util::JsonParseOptions parse_options;
+    parse_options.ignore_unknown_fields = true;
+    if (!google::protobuf::util::JsonStringToMessage(text, &state, parse_options).ok()) {
+      report_.errors++;
+      return;
+    }
+    if (player.phase == Player::Phase::kSeating) {
+      player.phase = Player::Phase::kPlaying;
+      if (player.host) {
+        game_ids_[player.table] = state.game_id();
+      }
+    }
+    if (state.all_here() && started_.insert(state.game_id()).second) {
+      report_.games_started++;
+    }
+    if (state.game_over()) {
+      if (finished_.insert(state.game_id()).second) {
+        report_.games_finished++;
+      }
+      player.phase = Player::Phase::kDone;
+    }
+    player.state = std::move(state);
+    if (player.phase == Player::Phase::kPlaying && player.state->your_turn() &&
+        !player.move_pending) {
+      player.move_pending = true;
+      scheduler_.after(thinkTime(), [this, &player] {
+        player.move_pending = false;
+        act(player);
+      });
+    }
+  }
+
+  // FNV-1a, one value at a time.
+  void fingerprint(uint64_t value) {
+    report_.fingerprint = (report_.fingerprint ^ value) * 0x100000001b3;
+  }
+
+  const SimulationOptions options_;
+  Scheduler scheduler_;
+  std::shared_ptr<FakeDocDbStub> doc_db_;
+  golf_service::Handler handler_;
+  std::vector<std::unique_ptr<Player>> players_;
+  int registered_ = 0;
+  // Each table's game once its host has heard back.
+  std::vector<std::optional<string>> game_ids_;
+  std::unordered_set<string> started_;
+  std::unordered_set<string> finished_;
+  std::vector<Clock::duration> latencies_;
+  SimulationReport report_{.fingerprint = 0xcbf29ce484222325};
+};
+
+string Milliseconds(Clock::duration d) {
+  return absl::StrFormat("%.2fms", std::chrono::duration<double, std::milli>(d).count());
+}
+}  // namespace
+
+string SimulationReport::toString() const {
+  return absl::StrFormat(
+      "%d requests, %d errors; %d games started, %d finished, %d stalled; %d doc_db calls, %d "
+      "failed; latency p50 %s p99 %s max %s; %s elapsed; fingerprint %016x",
+      requests, errors, games_started, games_finished, games_stalled, doc_db_calls,
+      doc_db_failures, Milliseconds(p50_latency), Milliseconds(p99_latency),
+      Milliseconds(max_latency), Milliseconds(elapsed), fingerprint);
+}
+
+SimulationReport Simulate(const SimulationOptions& options) {
+  return Simulation{options}.run();
+}
+
+}  // namespace golf_sim
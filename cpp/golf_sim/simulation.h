@@ -0,0 +1,69 @@
+#ifndef CPP_GOLF_SIM_SIMULATION_H
+#define CPP_GOLF_SIM_SIMULATION_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "cpp/golf_sim/fake_doc_db.h"
+#include "cpp/golf_sim/scheduler.h"
+
+namespace golf_sim {
+
+using std::string;
+
+// A run of the websocket golf service — Handler, its pipeline, GameManager, DocDbGameStore and
+// DocDbClient — against FakeDocDbStub, with simulated players on FakeConnections, all on one
+// thread in virtual time. Everything random is drawn from `seed`, so a run is replayed exactly by
+// running it again with the same options.
+struct SimulationOptions {
+  uint64_t seed = 1;
+  int players = 8;
+  // Players per game. Each player registers, is seated in registration order, and plays random
+  // legal moves until its game ends. Players left over from the last full table wait unseated.
+  int table_size = 2;
+  // Players connect at uniformly random times in [0, arrival_window).
+  std::chrono::milliseconds arrival_window{1000};
+  // How long a player waits before each move, uniform in [min_think, max_think].
+  std::chrono::milliseconds min_think{50};
+  std::chrono::milliseconds max_think{500};
+  // Each way, uniform in [0, max_network_delay]. Every connection stays in order.
+  std::chrono::milliseconds max_network_delay{20};
+  // Times a player repeats a rejected request before giving up on its game.
+  int retries = 3;
+  DocDbFaults doc_db;
+  // The run stops here, finished or not.
+  std::chrono::seconds time_limit{600};
+};
+
+struct SimulationReport {
+  int64_t requests = 0;
+  // Requests answered with an error.
+  int64_t errors = 0;
+  // Games whose seats all filled.
+  int64_t games_started = 0;
+  int64_t games_finished = 0;
+  // Games started but not over when the run stopped: nobody could move, a player gave up, or the
+  // run hit its time limit.
+  int64_t games_stalled = 0;
+  int64_t doc_db_calls = 0;
+  int64_t doc_db_failures = 0;
+  // From a request leaving the client to the service finishing it, waiting behind earlier
+  // requests included.
+  Scheduler::Clock::duration p50_latency{};
+  Scheduler::Clock::duration p99_latency{};
+  Scheduler::Clock::duration max_latency{};
+  // Virtual time when the last event ran.
+  Scheduler::Clock::duration elapsed{};
+  // A hash of every message every player received, when, in order. Equal seeds give equal
+  // fingerprints.
+  uint64_t fingerprint = 0;
+
+  [[nodiscard]] string toString() const;
+};
+
+[[nodiscard]] SimulationReport Simulate(const SimulationOptions& options);
+
+}  // namespace golf_sim
+
+#endif
@@ -0,0 +1,85 @@
+#include "cpp/golf_sim/simulation.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "cpp/golf_sim/scheduler.h"
+
+using namespace golf_sim;
+using namespace std::chrono_literals;
+
+TEST(Scheduler, RunsInTimeOrderAndShufflesTies) {
+  std::vector<std::string> first_orders;
+  for (uint64_t seed = 0; seed < 8; seed++) {
+    Scheduler scheduler{seed};
+    std::string order;
+    scheduler.after(2ms, [&] { order += "c"; });
+    scheduler.after(1ms, [&] { order += "a"; });
+    scheduler.after(1ms, [&] { order += "b"; });
+    EXPECT_EQ(scheduler.run(), 3);
+    EXPECT_EQ(order.back(), 'c');
+    EXPECT_EQ(scheduler.now() - Scheduler::Clock::time_point{}, 2ms);
+    first_orders.push_back(order);
+  }
+  // Both orders of the tie come up.
+  EXPECT_NE(std::count(first_orders.begin(), first_orders.end(), "abc"), 8);
+  EXPECT_NE(std::count(first_orders.begin(), first_orders.end(), "bac"), 8);
+}
+
+TEST(Scheduler, TasksDueDuringAnAdvanceRunLate) {
+  Scheduler scheduler{1};
+  Scheduler::Clock::time_point ran_at;
+  scheduler.after(1ms, [&] { scheduler.advance(10ms); });
+  scheduler.after(2ms, [&] { ran_at = scheduler.now(); });
+  scheduler.run(Scheduler::Clock::time_point{} + 1ms);
+  EXPECT_EQ(scheduler.pending(), 1);
+  scheduler.run();
+  EXPECT_EQ(ran_at - Scheduler::Clock::time_point{}, 11ms);
+}
+
+TEST(Simulation, SameSeedSameRun) {
+  SimulationOptions options{.seed = 42, .players = 6, .table_size = 3};
+  auto first = Simulate(options);
+  auto second = Simulate(options);
+  EXPECT_EQ(first.fingerprint, second.fingerprint) << first.toString();
+  EXPECT_EQ(first.requests, second.requests);
+  EXPECT_EQ(first.p99_latency, second.p99_latency);
+
+  options.seed = 43;
+  EXPECT_NE(Simulate(options).fingerprint, first.fingerprint);
+}
+
+TEST(Simulation, EveryGameFinishesWithoutFaults) {
+  for (uint64_t seed = 0; seed < 20; seed++) {
+    auto report = Simulate({.seed = seed, .players = 8, .table_size = 2});
+    EXPECT_EQ(report.games_started, 4) << report.toString();
+    EXPECT_EQ(report.games_finished, 4) << report.toString();
+    EXPECT_EQ(report.games_stalled, 0) << report.toString();
+    EXPECT_EQ(report.doc_db_failures, 0);
+  }
+}
+
+TEST(Simulation, SlowerDocDbShowsInLatency) {
+  SimulationOptions options{.seed = 7, .players = 40, .table_size = 4};
+  options.doc_db.latency = {.median = 1ms, .p99 = 20ms};
+  auto baseline = Simulate(options);
+  options.doc_db.latency.p99 = 40ms;
+  auto slower = Simulate(options);
+  EXPECT_GT(slower.p99_latency, baseline.p99_latency)
+      << baseline.toString() << "\n"
+      << slower.toString();
+}
+
+TEST(Simulation, FailuresAreInjected) {
+  SimulationOptions options{.seed = 3, .players = 8, .table_size = 2};
+  options.doc_db.failure_rate = 0.05;
+  options.doc_db.lost_reply_rate = 0.05;
+  auto report = Simulate(options);
+  EXPECT_GT(report.doc_db_failures, 0) << report.toString();
+  EXPECT_GT(report.errors, 0);
+  EXPECT_EQ(Simulate(options).fingerprint, report.fingerprint);
+}
@@ -0,0 +1,47 @@
+#include "cpp/golf_stats/doc_db_stats_store.h"
+
+#include <optional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+namespace golf_stats {
+
+using doc_db::DocEgg;
+
+absl::StatusOr<std::optional<string>> DocDbStatsStore::Load() {
+  auto status = client_->FindDocByTags("stats", {{"stats", name_}});
+  if (status.status().code() == absl::StatusCode::kNotFound) {
+    return std::nullopt;
+  }
+  if (!status.ok()) {
+    return status.status();
+  }
+  doc_ = doc_db::DocIdAndVersion{status->id, status->version};
+  return status->bytes;
+}
+
+absl::Status DocDbStatsStore::Save(const string& bytes) {
+  if (!doc_) {
+    // Without a Load to go on, find the document before inserting a second one beside it.
+    auto existing = client_->FindDocByTags("stats", {{"stats", name_}});
+    if (existing.ok()) {
+      doc_ = doc_db::DocIdAndVersion{existing->id, existing->version};
+    } else if (existing.status().code() != absl::StatusCode::kNotFound) {
+      return existing.status();
+    }
+  }
+  DocEgg doc_egg;
+  doc_egg.bytes = bytes;
+  doc_egg.tags = {{"stats", name_}};
+  auto status =
+      doc_ ? client_->UpdateDoc("stats", *doc_, doc_egg) : client_->InsertDoc("stats", doc_egg);
+  if (!status.ok()) {
+    return status.status();
+  }
+  doc_ = *status;
+  return absl::OkStatus();
+}
+
+}  // namespace golf_stats
@@ -0,0 +1,37 @@
+#ifndef CPP_GOLF_STATS_DOC_DB_STATS_STORE_H
+#define CPP_GOLF_STATS_DOC_DB_STATS_STORE_H
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "cpp/doc_db_client/doc_db_client.h"
+#include "cpp/golf_stats/stats_store.h"
+
+namespace golf_stats {
+
+using doc_db::DocDbClient;
+
+// Keeps the stats blob as a single document in the "stats" collection, tagged with `name`. Save
+// replaces that document, looking it up first if Load has not found it.
+// Not thread-safe. requires external synchronization
+class DocDbStatsStore final : public StatsStoreInterface {
+ public:
+  DocDbStatsStore(std::shared_ptr<DocDbClient> client, string name)
+      : client_(std::move(client)), name_(std::move(name)) {}
+
+  absl::StatusOr<std::optional<string>> Load() override;
+  absl::Status Save(const string& bytes) override;
+
+ private:
+  std::shared_ptr<DocDbClient> client_;
+  string name_;
+  // The document as of the last Load or Save, once there is one.
+  std::optional<doc_db::DocIdAndVersion> doc_;
+};
+
+}  // namespace golf_stats
+
+#endif
@@ -0,0 +1,247 @@
+#include "cpp/golf_stats/stats_aggregator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/leaderboard.h"
+#include "protos/golf/golf_model.pb.h"
+
+namespace golf_stats {
+
+using golf::Leaderboard;
+
+void ScoreHistogram::add(int score, int64_t times) {
+  counts_[std::clamp(score, 0, kMaxScore)] += times;
+  count_ += times;
+  sum_ += score * times;
+}
+
+double ScoreHistogram::mean() const {
+  return count_ == 0 ? 0 : static_cast<double>(sum_) / static_cast<double>(count_);
+}
+
+int ScoreHistogram::quantile(double q) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  int64_t seen = 0;
+  for (int score = 0; score <= kMaxScore; score++) {
+    seen += counts_[score];
+    if (static_cast<double>(seen) >= q * static_cast<double>(count_)) {
+      return score;
+    }
+  }
+  return kMaxScore;
+}
+
+namespace {
+void AppendStandings(string& out, const std::vector<Leaderboard::Standing>& standings,
+                     double scale) {
+  out += "[";
+  for (size_t i = 0; i < standings.size(); i++) {
+    auto& s = standings[i];
+    absl::StrAppendFormat(&out, R"(%s{"rank":%d,"user":"%s","value":%.2f})", i == 0 ? "" : ",",
+                          s.rank, s.user_id, s.total / scale);
+  }
+  out += "]";
+}
+}  // namespace
+
+string StatsSnapshot::toJson() const {
+  string out = absl::StrFormat(R"({"gamesCompleted":%d,"gamesInProgress":%d,"winRate":)",
+                               games_completed, games_in_progress);
+  AppendStandings(out, top_win_rate, 10000.0);
+  out += R"(,"averageScore":)";
+  AppendStandings(out, top_average_score, 100.0);
+  absl::StrAppendFormat(&out, R"(,"scores":{"mean":%.2f,"p50":%d,"p90":%d,"p99":%d}})",
+                        mean_score, p50_score, p90_score, p99_score);
+  return out;
+}
+
+StatsAggregator::StatsAggregator(size_t top_k, int min_games, std::chrono::milliseconds idle_ttl,
+                                 std::function<Clock::time_point()> now)
+    : top_k_(top_k), min_games_(min_games), idle_ttl_(idle_ttl), now_(std::move(now)) {}
+
+void StatsAggregator::observe(const golf::GameState& state) {
+  std::scoped_lock lock{mutex_};
+  expireIdle();
+  auto it = in_progress_.find(state.getGameId());
+  if (it != in_progress_.end()) {
+    idle_index_.erase({it->second, it->first});
+  }
+  if (!state.isOver()) {
+    auto seen = now_();
+    if (it == in_progress_.end()) {
+      it = in_progress_.emplace(state.getGameId(), seen).first;
+      dirty_ = true;
+    }
+    it->second = seen;
+    idle_index_.emplace(seen, it->first);
+    return;
+  }
+  if (it != in_progress_.end()) {
+    in_progress_.erase(it);
+  }
+  recordFinished(state);
+  dirty_ = true;
+}
+
+void StatsAggregator::expireIdle() {
+  auto cutoff = now_() - idle_ttl_;
+  while (!idle_index_.empty() && idle_index_.begin()->first <= cutoff) {
+    in_progress_.erase(idle_index_.begin()->second);
+    idle_index_.erase(idle_index_.begin());
+    dirty_ = true;
+  }
+}
+
+void StatsAggregator::recordFinished(const golf::GameState& state) {
+  games_completed_++;
+  auto winners = state.winners();
+  auto& players = state.getPlayers();
+  for (int i = 0; i < static_cast<int>(players.size()); i++) {
+    int score = players[i].score();
+    scores_.add(score);
+    auto& name = players[i].getName();
+    if (!name.has_value()) {
+      continue;
+    }
+    auto& stats = users_[*name];
+    stats.games++;
+    stats.wins += winners.contains(i) ? 1 : 0;
+    stats.total_score += score;
+    rank(*name, stats);
+  }
+}
+
+void StatsAggregator::rank(const string& user_id, const UserStats& stats) {
+  if (stats.games < min_games_) {
+    return;
+  }
+  int win_rate = static_cast<int>(stats.wins * 10000 / stats.games);
+  int average_score = static_cast<int>(stats.total_score * 100 / stats.games);
+  // Leaderboards take deltas; a user enters each one at 0.
+  auto [it, _] = ranked_.try_emplace(user_id, 0, 0);
+  win_rates_.add(user_id, win_rate - it->second.first);
+  average_scores_.add(user_id, average_score - it->second.second);
+  it->second = {win_rate, average_score};
+}
+
+StatsSnapshot StatsAggregator::snapshot() const {
+  std::scoped_lock lock{mutex_};
+  StatsSnapshot snapshot;
+  snapshot.games_completed = games_completed_;
+  // Games gone idle since the last observe are not counted, though only observe drops them.
+  int64_t idle = 0;
+  auto cutoff = now_() - idle_ttl_;
+  for (auto it = idle_index_.begin(); it != idle_index_.end() && it->first <= cutoff; ++it) {
+    idle++;
+  }
+  snapshot.games_in_progress = static_cast<int64_t>(in_progress_.size()) - idle;
+  snapshot.top_win_rate = win_rates_.top(top_k_);
+  snapshot.top_average_score = average_scores_.top(top_k_);
+  snapshot.mean_score = scores_.mean();
+  snapshot.p50_score = scores_.quantile(0.5);
+  snapshot.p90_score = scores_.quantile(0.9);
+  snapshot.p99_score = scores_.quantile(0.99);
+  return snapshot;
+}
+
+std::optional<UserStats> StatsAggregator::userStats(const string& user_id) const {
+  std::scoped_lock lock{mutex_};
+  auto it = users_.find(user_id);
+  if (it == users_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+string StatsAggregator::serialize() const {
+  golf_proto::GolfStats proto;
+  for (auto& [user_id, stats] : users_) {
+    auto* user = proto.add_users();
+    user->set_user_id(user_id);
+    user->set_games(stats.games);
+    user->set_wins(stats.wins);
+    user->set_total_score(stats.total_score);
+  }
+  for (auto count : scores_.counts()) {
+    proto.add_score_counts(count);
+  }
+  proto.set_games_completed(games_completed_);
+  for (auto& [game_id, _] : in_progress_) {
+    proto.add_games_in_progress(game_id);
+  }
+  return proto.SerializeAsString();
+}
+
+absl::Status StatsAggregator::restore(StatsStoreInterface& store) {
+  auto loaded = store.Load();
+  if (!loaded.ok()) {
+    return loaded.status();
+  }
+  if (!loaded->has_value()) {
+    return absl::OkStatus();
+  }
+  golf_proto::GolfStats proto;
+  if (!proto.ParseFromString(**loaded)) {
+    return absl::InternalError("could not parse saved stats");
+  }
+
+  std::scoped_lock lock{mutex_};
+  users_.clear();
+  ranked_.clear();
+  win_rates_ = Leaderboard{Leaderboard::Order::HighestFirst};
+  average_scores_ = Leaderboard{Leaderboard::Order::LowestFirst};
+  for (auto& user : proto.users()) {
+    auto& stats = users_[user.user_id()];
+    stats = {user.games(), user.wins(), user.total_score()};
+    rank(user.user_id(), stats);
+  }
+  scores_ = ScoreHistogram{};
+  for (int score = 0; score < proto.score_counts_size(); score++) {
+    scores_.add(score, proto.score_counts(score));
+  }
+  games_completed_ = proto.games_completed();
+  // Restored games get a full idle_ttl_ from now to show they are still being played.
+  in_progress_.clear();
+  idle_index_.clear();
+  auto now = now_();
+  for (auto& game_id : proto.games_in_progress()) {
+    if (in_progress_.emplace(game_id, now).second) {
+      idle_index_.emplace(now, game_id);
+    }
+  }
+  dirty_ = false;
+  return absl::OkStatus();
+}
+
+absl::Status StatsAggregator::flush(StatsStoreInterface& store) {
+  string bytes;
+  {
+    std::scoped_lock lock{mutex_};
+    expireIdle();
+    if (!dirty_) {
+      return absl::OkStatus();
+    }
+    bytes = serialize();
+    dirty_ = false;
+  }
+  auto status = store.Save(bytes);
+  if (!status.ok()) {
+    std::scoped_lock lock{mutex_};
+    dirty_ = true;
+  }
+  return status;
+}
+
+}  // namespace golf_stats
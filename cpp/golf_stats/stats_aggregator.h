@@ -0,0 +1,128 @@
+#ifndef CPP_GOLF_STATS_STATS_AGGREGATOR_H
+#define CPP_GOLF_STATS_STATS_AGGREGATOR_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/leaderboard.h"
+#include "cpp/golf_stats/stats_store.h"
+
+namespace golf_stats {
+
+using std::string;
+
+// How often each hand score has come up. Hand scores are small integers, so one counter per value
+// gives exact quantiles in constant space where a general-purpose sketch would only approximate
+// them.
+class ScoreHistogram {
+ public:
+  // Scores at or above this share the last counter.
+  static constexpr int kMaxScore = 127;
+
+  void add(int score, int64_t times = 1);
+  [[nodiscard]] int64_t count() const { return count_; }
+  [[nodiscard]] double mean() const;
+  // The smallest score with at least `q` of all scores at or below it; 0 when empty.
+  [[nodiscard]] int quantile(double q) const;
+  [[nodiscard]] const std::array<int64_t, kMaxScore + 1>& counts() const { return counts_; }
+
+ private:
+  std::array<int64_t, kMaxScore + 1> counts_{};
+  int64_t count_ = 0;
+  int64_t sum_ = 0;
+};
+
+struct UserStats {
+  int64_t games = 0;
+  int64_t wins = 0;
+  int64_t total_score = 0;
+};
+
+struct StatsSnapshot {
+  int64_t games_completed = 0;
+  int64_t games_in_progress = 0;
+  // Totals are win rates in basis points, highest first.
+  std::vector<golf::Leaderboard::Standing> top_win_rate;
+  // Totals are average scores in hundredths, lowest first.
+  std::vector<golf::Leaderboard::Standing> top_average_score;
+  double mean_score = 0;
+  int p50_score = 0;
+  int p90_score = 0;
+  int p99_score = 0;
+
+  [[nodiscard]] string toJson() const;
+};
+
+// Live golf stats kept up to date from the stream of committed game states, so that reading them
+// costs O(top_k) rather than a walk over every game. Each finished game updates its players'
+// counters, their places in two order-statistics leaderboards and the score histogram.
+//
+// Players join the leaderboards once they have finished `min_games` games, so that one lucky hand
+// does not top the win rates.
+//
+// Thread-safe.
+class StatsAggregator {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // An unfinished game stops counting as in progress once `idle_ttl` passes without a state for
+  // it, by default when InMemoryGameStore would evict it as abandoned.
+  explicit StatsAggregator(size_t top_k = 10, int min_games = 5,
+                           std::chrono::milliseconds idle_ttl = std::chrono::hours(2),
+                           std::function<Clock::time_point()> now = Clock::now);
+
+  // Feeds one committed state. A game is in progress from the first state seen until one that is
+  // over, or until it goes idle; a game store commits exactly one over state per game, and it is
+  // counted then.
+  void observe(const golf::GameState& state);
+
+  [[nodiscard]] StatsSnapshot snapshot() const;
+  [[nodiscard]] std::optional<UserStats> userStats(const string& user_id) const;
+
+  // Replaces everything with what a previous aggregator saved, if `store` holds anything.
+  absl::Status restore(StatsStoreInterface& store);
+  // Saves to `store` if anything changed since the last save.
+  absl::Status flush(StatsStoreInterface& store);
+
+ private:
+  void recordFinished(const golf::GameState& state);
+  // Drops in-progress games that have been idle for idle_ttl_. Requires mutex_.
+  void expireIdle();
+  void rank(const string& user_id, const UserStats& stats);
+  [[nodiscard]] string serialize() const;
+
+  const size_t top_k_;
+  const int min_games_;
+  const std::chrono::milliseconds idle_ttl_;
+  std::function<Clock::time_point()> now_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<string, UserStats> users_;
+  // Each ranked user's key in the leaderboards, to turn a new value into a delta.
+  std::unordered_map<string, std::pair<int, int>> ranked_;
+  golf::Leaderboard win_rates_{golf::Leaderboard::Order::HighestFirst};
+  golf::Leaderboard average_scores_{golf::Leaderboard::Order::LowestFirst};
+  ScoreHistogram scores_;
+  // When each game in progress was last seen, and the same times in order so that expiry only
+  // ever looks at games that are due.
+  std::unordered_map<string, Clock::time_point> in_progress_;
+  std::set<std::pair<Clock::time_point, string>> idle_index_;
+  int64_t games_completed_ = 0;
+  bool dirty_ = false;
+};
+
+}  // namespace golf_stats
+
+#endif
@@ -0,0 +1,164 @@
+#include "cpp/golf_stats/stats_aggregator.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cpp/cards/card.h"
+#include "cpp/cards/golf/game_state.h"
+#include "cpp/cards/golf/player.h"
+#include "cpp/golf_stats/stats_store.h"
+
+using namespace cards;
+using namespace golf;
+using namespace golf_stats;
+
+namespace {
+class FakeStatsStore final : public StatsStoreInterface {
+ public:
+  absl::StatusOr<std::optional<std::string>> Load() override { return saved; }
+  absl::Status Save(const std::string& bytes) override {
+    saves++;
+    saved = bytes;
+    return absl::OkStatus();
+  }
+
+  std::optional<std::string> saved;
+  int saves = 0;
+};
+
+// A hand of `winner` against `loser`: the winner's pairs score 0, the loser holds a 5, 6, 7 and 8.
+GameState Hand(const std::string& game_id, const std::string& winner, const std::string& loser,
+               bool over) {
+  Player w{winner, Card(Suit::Clubs, Rank::Two), Card(Suit::Diamonds, Rank::Two),
+           Card(Suit::Hearts, Rank::Three), Card(Suit::Spades, Rank::Three)};
+  Player l{loser, Card(Suit::Clubs, Rank::Five), Card(Suit::Diamonds, Rank::Six),
+           Card(Suit::Hearts, Rank::Seven), Card(Suit::Spades, Rank::Eight)};
+  std::deque<Card> draw;
+  if (!over) {
+    draw.emplace_back(Suit::Clubs, Rank::Ace);
+  }
+  return GameState{draw, {Card(Suit::Clubs, Rank::Ace)}, {w, l}, false, 0, -1, game_id, "v"};
+}
+}  // namespace
+
+TEST(ScoreHistogram, Quantiles) {
+  ScoreHistogram histogram;
+  EXPECT_EQ(histogram.quantile(0.5), 0);
+  for (int score = 1; score <= 100; score++) {
+    histogram.add(score);
+  }
+  histogram.add(500);  // shares the last counter
+  EXPECT_EQ(histogram.count(), 101);
+  EXPECT_EQ(histogram.quantile(0.5), 51);
+  EXPECT_EQ(histogram.quantile(0.9), 91);
+  EXPECT_EQ(histogram.quantile(1.0), ScoreHistogram::kMaxScore);
+}
+
+TEST(StatsAggregator, CountsFinishedGames) {
+  StatsAggregator stats{10, 2};
+  stats.observe(Hand("1", "andy", "mercy", false));
+  stats.observe(Hand("2", "andy", "mercy", false));
+  EXPECT_EQ(stats.snapshot().games_in_progress, 2);
+
+  stats.observe(Hand("1", "andy", "mercy", true));
+  auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.games_in_progress, 1);
+  EXPECT_EQ(snapshot.games_completed, 1);
+  // Nobody has played two games yet.
+  EXPECT_TRUE(snapshot.top_win_rate.empty());
+
+  stats.observe(Hand("2", "mercy", "andy", true));
+  stats.observe(Hand("3", "andy", "bob1", true));
+  snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.games_in_progress, 0);
+  EXPECT_EQ(snapshot.games_completed, 3);
+
+  std::vector<Leaderboard::Standing> win_rate{{"andy", 6666, 1}, {"mercy", 5000, 2}};
+  EXPECT_EQ(snapshot.top_win_rate, win_rate);
+  int loser_score = Hand("1", "andy", "mercy", true).getPlayer(1).score();
+  std::vector<Leaderboard::Standing> average{{"andy", loser_score * 100 / 3, 1},
+                                             {"mercy", loser_score * 100 / 2, 2}};
+  EXPECT_EQ(snapshot.top_average_score, average);
+  EXPECT_EQ(snapshot.p50_score, 0);
+  EXPECT_EQ(snapshot.p90_score, loser_score);
+
+  auto andy = stats.userStats("andy");
+  ASSERT_TRUE(andy.has_value());
+  EXPECT_EQ(andy->games, 3);
+  EXPECT_EQ(andy->wins, 2);
+  EXPECT_FALSE(stats.userStats("nobody").has_value());
+
+  auto json = snapshot.toJson();
+  EXPECT_NE(json.find(R"("gamesCompleted":3)"), std::string::npos);
+  EXPECT_NE(json.find(R"({"rank":1,"user":"andy","value":0.67})"), std::string::npos);
+}
+
+TEST(StatsAggregator, RestoresWhatItFlushed) {
+  FakeStatsStore store;
+  StatsAggregator stats{10, 1};
+  EXPECT_TRUE(stats.flush(store).ok());
+  EXPECT_EQ(store.saves, 0);  // nothing to save yet
+
+  stats.observe(Hand("1", "andy", "mercy", true));
+  stats.observe(Hand("2", "andy", "mercy", false));
+  ASSERT_TRUE(stats.flush(store).ok());
+  EXPECT_EQ(store.saves, 1);
+  EXPECT_TRUE(stats.flush(store).ok());
+  EXPECT_EQ(store.saves, 1);
+
+  StatsAggregator restarted{10, 1};
+  ASSERT_TRUE(restarted.restore(store).ok());
+  auto before = stats.snapshot();
+  auto after = restarted.snapshot();
+  EXPECT_EQ(after.games_completed, before.games_completed);
+  EXPECT_EQ(after.games_in_progress, 1);
+  EXPECT_EQ(after.top_win_rate, before.top_win_rate);
+  EXPECT_EQ(after.top_average_score, before.top_average_score);
+  EXPECT_EQ(after.p90_score, before.p90_score);
+  EXPECT_EQ(after.mean_score, before.mean_score);
+
+  // The restored in-progress game is counted when it ends.
+  restarted.observe(Hand("2", "andy", "mercy", true));
+  EXPECT_EQ(restarted.snapshot().games_in_progress, 0);
+  EXPECT_EQ(restarted.userStats("andy")->wins, 2);
+}
+
+TEST(StatsAggregator, ForgetsAbandonedGames) {
+  FakeStatsStore store;
+  auto now = StatsAggregator::Clock::time_point{};
+  StatsAggregator stats{10, 1, std::chrono::minutes(5), [&] { return now; }};
+  stats.observe(Hand("1", "andy", "mercy", false));
+  now += std::chrono::minutes(3);
+  stats.observe(Hand("2", "andy", "mercy", false));
+  EXPECT_EQ(stats.snapshot().games_in_progress, 2);
+  ASSERT_TRUE(stats.flush(store).ok());
+  EXPECT_EQ(store.saves, 1);
+
+  // Game 1 has gone five minutes without a move; game 2 was last seen two minutes ago.
+  now += std::chrono::minutes(2);
+  EXPECT_EQ(stats.snapshot().games_in_progress, 1);
+  ASSERT_TRUE(stats.flush(store).ok());
+  EXPECT_EQ(store.saves, 2);
+  StatsAggregator restarted{10, 1};
+  ASSERT_TRUE(restarted.restore(store).ok());
+  EXPECT_EQ(restarted.snapshot().games_in_progress, 1);
+
+  // A move keeps a game in progress.
+  now += std::chrono::minutes(2);
+  stats.observe(Hand("2", "andy", "mercy", false));
+  now += std::chrono::minutes(4);
+  EXPECT_EQ(stats.snapshot().games_in_progress, 1);
+  now += std::chrono::minutes(1);
+  EXPECT_EQ(stats.snapshot().games_in_progress, 0);
+
+  // A game that finishes after going idle still counts as completed.
+  stats.observe(Hand("1", "andy", "mercy", true));
+  auto snapshot = stats.snapshot();
+  EXPECT_EQ(snapshot.games_in_progress, 0);
+  EXPECT_EQ(snapshot.games_completed, 1);
+}
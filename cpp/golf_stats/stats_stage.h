@@ -0,0 +1,33 @@
+#ifndef CPP_GOLF_STATS_STATS_STAGE_H
+#define CPP_GOLF_STATS_STATS_STAGE_H
+
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "cpp/golf_pipeline/command.h"
+#include "cpp/golf_stats/stats_aggregator.h"
+
+namespace golf_stats {
+
+// Feeds every committed state to a StatsAggregator. Goes after the execute stage.
+template <typename Origin>
+class StatsStage final : public golf_pipeline::Stage<Origin> {
+ public:
+  explicit StatsStage(std::shared_ptr<StatsAggregator> stats) : stats_(std::move(stats)) {}
+
+  void process(std::span<golf_pipeline::Exchange<Origin>> batch) override {
+    for (auto& exchange : batch) {
+      if (exchange.ok() && exchange.game_state != nullptr) {
+        stats_->observe(*exchange.game_state);
+      }
+    }
+  }
+
+ private:
+  std::shared_ptr<StatsAggregator> stats_;
+};
+
+}  // namespace golf_stats
+
+#endif
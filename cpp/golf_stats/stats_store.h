@@ -0,0 +1,25 @@
+#ifndef CPP_GOLF_STATS_STATS_STORE_H
+#define CPP_GOLF_STATS_STATS_STORE_H
+
+#include <optional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+
+namespace golf_stats {
+
+using std::string;
+
+// Where a StatsAggregator keeps its aggregates between restarts: one opaque blob.
+class StatsStoreInterface {
+ public:
+  virtual ~StatsStoreInterface() {}
+  // The last blob saved, or nullopt if nothing has been.
+  virtual absl::StatusOr<std::optional<string>> Load() = 0;
+  virtual absl::Status Save(const string& bytes) = 0;
+};
+
+}  // namespace golf_stats
+
+#endif
@@ -0,0 +1,105 @@
+#include "cpp/grpc_instrumentation/interceptors.h"
+
+#include <google/protobuf/message_lite.h>
+#include <grpcpp/support/client_interceptor.h>
+#include <grpcpp/support/interceptor.h>
+#include <grpcpp/support/server_interceptor.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace grpc_instrumentation {
+using grpc::experimental::InterceptionHookPoints;
+using grpc::experimental::Interceptor;
+using grpc::experimental::InterceptorBatchMethods;
+
+namespace {
+// Every service in this repo uses protobuf codegen, so message payloads are MessageLites.
+// ByteSizeLong is cached by the serializer, so this does not serialize twice.
+uint64_t messageBytes(const void* message) {
+  if (message == nullptr) {
+    return 0;
+  }
+  return static_cast<const google::protobuf::MessageLite*>(message)->ByteSizeLong();
+}
+
+class MetricsInterceptor final : public Interceptor {
+ public:
+  MetricsInterceptor(RpcMetrics* metrics, const char* method, bool is_server)
+      : metrics_(metrics),
+        method_(method),
+        is_server_(is_server),
+        start_(std::chrono::steady_clock::now()) {
+    metrics_->recordStart(method_);
+  }
+
+  void Intercept(InterceptorBatchMethods* methods) override {
+    if (methods->QueryInterceptionHookPoint(InterceptionHookPoints::PRE_SEND_MESSAGE)) {
+      (is_server_ ? response_bytes_ : request_bytes_) += messageBytes(methods->GetSendMessage());
+    }
+    if (methods->QueryInterceptionHookPoint(InterceptionHookPoints::POST_RECV_MESSAGE)) {
+      (is_server_ ? request_bytes_ : response_bytes_) += messageBytes(methods->GetRecvMessage());
+    }
+    if (is_server_ &&
+        methods->QueryInterceptionHookPoint(InterceptionHookPoints::PRE_SEND_STATUS)) {
+      finish(methods->GetSendStatus().error_code());
+    }
+    if (!is_server_ &&
+        methods->QueryInterceptionHookPoint(InterceptionHookPoints::POST_RECV_STATUS)) {
+      finish(methods->GetRecvStatus()->error_code());
+    }
+    methods->Proceed();
+  }
+
+  ~MetricsInterceptor() override {
+    // a call torn down without a status (e.g. server shutdown) still leaves the in-flight count
+    finish(grpc::StatusCode::CANCELLED);
+  }
+
+ private:
+  void finish(grpc::StatusCode code) {
+    if (finished_.exchange(true)) {
+      return;
+    }
+    metrics_->recordFinish(method_, std::chrono::steady_clock::now() - start_,
+                           static_cast<int>(code), request_bytes_.load(), response_bytes_.load());
+  }
+
+  RpcMetrics* metrics_;
+  const char* method_;
+  const bool is_server_;
+  const std::chrono::steady_clock::time_point start_;
+  // sends and receives on a stream can run concurrently
+  std::atomic<uint64_t> request_bytes_{0};
+  std::atomic<uint64_t> response_bytes_{0};
+  std::atomic<bool> finished_{false};
+};
+}  // namespace
+
+Interceptor* ServerMetricsInterceptorFactory::CreateServerInterceptor(
+    grpc::experimental::ServerRpcInfo* info) {
+  return new MetricsInterceptor(metrics_, info->method(), true);
+}
+
+Interceptor* ClientMetricsInterceptorFactory::CreateClientInterceptor(
+    grpc::experimental::ClientRpcInfo* info) {
+  return new MetricsInterceptor(metrics_, info->method(), false);
+}
+
+std::vector<std::unique_ptr<grpc::experimental::ServerInterceptorFactoryInterface>>
+ServerInterceptors(RpcMetrics* metrics) {
+  std::vector<std::unique_ptr<grpc::experimental::ServerInterceptorFactoryInterface>> creators;
+  creators.push_back(std::make_unique<ServerMetricsInterceptorFactory>(metrics));
+  return creators;
+}
+
+std::vector<std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>>
+ClientInterceptors(RpcMetrics* metrics) {
+  std::vector<std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>> creators;
+  creators.push_back(std::make_unique<ClientMetricsInterceptorFactory>(metrics));
+  return creators;
+}
+
+}  // namespace grpc_instrumentation
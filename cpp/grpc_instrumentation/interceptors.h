@@ -0,0 +1,51 @@
+#ifndef CPP_GRPC_INSTRUMENTATION_INTERCEPTORS_H
+#define CPP_GRPC_INSTRUMENTATION_INTERCEPTORS_H
+
+#include <grpcpp/support/client_interceptor.h>
+#include <grpcpp/support/interceptor.h>
+#include <grpcpp/support/server_interceptor.h>
+
+#include <memory>
+#include <vector>
+
+#include "cpp/grpc_instrumentation/rpc_metrics.h"
+
+namespace grpc_instrumentation {
+
+// Records latency, payload bytes, in-flight count and status code for every RPC a server handles.
+// Install with ServerBuilder::experimental().SetInterceptorCreators(ServerInterceptors()).
+class ServerMetricsInterceptorFactory final
+    : public grpc::experimental::ServerInterceptorFactoryInterface {
+ public:
+  explicit ServerMetricsInterceptorFactory(RpcMetrics* metrics = &RpcMetrics::Global())
+      : metrics_(metrics) {}
+  grpc::experimental::Interceptor* CreateServerInterceptor(
+      grpc::experimental::ServerRpcInfo* info) override;
+
+ private:
+  RpcMetrics* metrics_;
+};
+
+// The same measurements for calls made through a channel. Install with
+// grpc::experimental::CreateCustomChannelWithInterceptors(..., ClientInterceptors()).
+class ClientMetricsInterceptorFactory final
+    : public grpc::experimental::ClientInterceptorFactoryInterface {
+ public:
+  explicit ClientMetricsInterceptorFactory(RpcMetrics* metrics = &RpcMetrics::Global())
+      : metrics_(metrics) {}
+  grpc::experimental::Interceptor* CreateClientInterceptor(
+      grpc::experimental::ClientRpcInfo* info) override;
+
+ private:
+  RpcMetrics* metrics_;
+};
+
+std::vector<std::unique_ptr<grpc::experimental::ServerInterceptorFactoryInterface>>
+ServerInterceptors(RpcMetrics* metrics = &RpcMetrics::Global());
+
+std::vector<std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>>
+ClientInterceptors(RpcMetrics* metrics = &RpcMetrics::Global());
+
+}  // namespace grpc_instrumentation
+
+#endif
@@ -0,0 +1,53 @@
+#include "cpp/grpc_instrumentation/interceptors.h"
+
+#include <grpcpp/client_context.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <gtest/gtest.h>
+
+#include "cpp/example_service/example_service.h"
+#include "cpp/grpc_instrumentation/rpc_metrics.h"
+#include "protos/example_service/helloworld.grpc.pb.h"
+
+using example_service::Greeter;
+using example_service::HelloReply;
+using example_service::HelloRequest;
+using grpc::ClientContext;
+using grpc::Server;
+using grpc::ServerBuilder;
+using namespace grpc_instrumentation;
+
+TEST(Interceptors, ServerAndClientRecordCalls) {
+  RpcMetrics server_metrics;
+  RpcMetrics client_metrics;
+  GreeterServiceImpl service;
+
+  ServerBuilder builder;
+  builder.RegisterService(&service);
+  builder.experimental().SetInterceptorCreators(ServerInterceptors(&server_metrics));
+  std::unique_ptr<Server> server(builder.BuildAndStart());
+
+  auto channel = server->experimental().InProcessChannelWithInterceptors(
+      {}, ClientInterceptors(&client_metrics));
+  auto stub = Greeter::NewStub(channel);
+
+  ClientContext context;
+  HelloRequest req;
+  req.set_name("Test Name");
+  HelloReply res;
+  ASSERT_TRUE(stub->SayHello(&context, req, &res).ok());
+
+  server->Shutdown();
+
+  for (auto* metrics : {&server_metrics, &client_metrics}) {
+    auto snapshot = metrics->snapshot();
+    ASSERT_EQ(snapshot.size(), 1);
+    EXPECT_EQ(snapshot[0].method, "/example_service.Greeter/SayHello");
+    EXPECT_EQ(snapshot[0].finished, 1);
+    EXPECT_EQ(snapshot[0].in_flight, 0);
+    EXPECT_EQ(snapshot[0].status_codes[0], 1);
+    EXPECT_EQ(snapshot[0].request_bytes, req.ByteSizeLong());
+    EXPECT_EQ(snapshot[0].response_bytes, res.ByteSizeLong());
+  }
+}
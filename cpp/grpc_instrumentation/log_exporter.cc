@@ -0,0 +1,75 @@
+#include "cpp/grpc_instrumentation/log_exporter.h"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+namespace grpc_instrumentation {
+
+static const char* const STATUS_NAMES[kStatusCodes] = {
+    "OK",
+    "CANCELLED",
+    "UNKNOWN",
+    "INVALID_ARGUMENT",
+    "DEADLINE_EXCEEDED",
+    "NOT_FOUND",
+    "ALREADY_EXISTS",
+    "PERMISSION_DENIED",
+    "RESOURCE_EXHAUSTED",
+    "FAILED_PRECONDITION",
+    "ABORTED",
+    "OUT_OF_RANGE",
+    "UNIMPLEMENTED",
+    "INTERNAL",
+    "UNAVAILABLE",
+    "DATA_LOSS",
+    "UNAUTHENTICATED",
+};
+
+std::string FormatSnapshot(const std::vector<MethodSnapshot>& snapshot) {
+  std::string out;
+  for (auto& s : snapshot) {
+    absl::StrAppendFormat(&out,
+                          "%s started=%d finished=%d in_flight=%d req_bytes=%d resp_bytes=%d "
+                          "p50_us<=%d p90_us<=%d p99_us<=%d",
+                          s.method, s.started, s.finished, s.in_flight, s.request_bytes,
+                          s.response_bytes, s.latencyQuantileMicros(0.5),
+                          s.latencyQuantileMicros(0.9), s.latencyQuantileMicros(0.99));
+    for (size_t code = 0; code < kStatusCodes; code++) {
+      if (s.status_codes[code] != 0) {
+        absl::StrAppend(&out, " ", STATUS_NAMES[code], "=", s.status_codes[code]);
+      }
+    }
+    out.append("\n");
+  }
+  return out;
+}
+
+LogExporter::LogExporter(std::chrono::seconds interval, RpcMetrics* metrics)
+    : interval_(interval), metrics_(metrics), thread_([this] { run(); }) {}
+
+LogExporter::~LogExporter() {
+  {
+    std::scoped_lock lock{mutex_};
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+void LogExporter::run() {
+  std::unique_lock lock{mutex_};
+  while (!cv_.wait_for(lock, interval_, [this] { return stopping_; })) {
+    auto snapshot = metrics_->snapshot();
+    if (!snapshot.empty()) {
+      LOG(INFO) << "rpc metrics\n" << FormatSnapshot(snapshot);
+    }
+  }
+}
+
+}  // namespace grpc_instrumentation
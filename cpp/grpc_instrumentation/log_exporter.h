@@ -0,0 +1,39 @@
+#ifndef CPP_GRPC_INSTRUMENTATION_LOG_EXPORTER_H
+#define CPP_GRPC_INSTRUMENTATION_LOG_EXPORTER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cpp/grpc_instrumentation/rpc_metrics.h"
+
+namespace grpc_instrumentation {
+
+// One line per method: counts, in-flight, bytes, non-OK status codes and p50/p90/p99 latency.
+std::string FormatSnapshot(const std::vector<MethodSnapshot>& snapshot);
+
+// Periodically logs a snapshot of an RpcMetrics registry. Stops and joins on destruction.
+class LogExporter {
+ public:
+  explicit LogExporter(std::chrono::seconds interval, RpcMetrics* metrics = &RpcMetrics::Global());
+  ~LogExporter();
+  LogExporter(const LogExporter&) = delete;
+  LogExporter& operator=(const LogExporter&) = delete;
+
+ private:
+  void run();
+
+  const std::chrono::seconds interval_;
+  RpcMetrics* metrics_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopping_ = false;
+  std::thread thread_;
+};
+
+}  // namespace grpc_instrumentation
+
+#endif
@@ -0,0 +1,175 @@
+#include "cpp/grpc_instrumentation/rpc_metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace grpc_instrumentation {
+
+namespace {
+std::atomic<uint64_t> next_registry_id{1};
+
+size_t latencyBucket(std::chrono::nanoseconds latency) {
+  auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+  if (micros <= 1) {
+    return 0;
+  }
+  size_t bucket = std::bit_width(static_cast<uint64_t>(micros)) - 1;
+  return std::min(bucket, kLatencyBuckets - 1);
+}
+}  // namespace
+
+uint64_t MethodSnapshot::latencyQuantileMicros(double q) const {
+  uint64_t total = 0;
+  for (auto count : latency_buckets) {
+    total += count;
+  }
+  if (total == 0) {
+    return 0;
+  }
+  auto target = static_cast<uint64_t>(q * static_cast<double>(total));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kLatencyBuckets; i++) {
+    seen += latency_buckets[i];
+    if (seen > target) {
+      return uint64_t{1} << (i + 1);
+    }
+  }
+  return uint64_t{1} << kLatencyBuckets;
+}
+
+RpcMetrics::RpcMetrics()
+    : id_(next_registry_id.fetch_add(1)), pool_(std::make_shared<ShardPool>()) {
+  method_by_slot_.reserve(kMaxMethods + 1);
+}
+
+RpcMetrics& RpcMetrics::Global() {
+  static RpcMetrics* metrics = new RpcMetrics();
+  return *metrics;
+}
+
+RpcMetrics::Shard& RpcMetrics::localShard() {
+  // Returns this thread's shards to their pools when it exits.
+  struct LocalShards {
+    struct Entry {
+      std::weak_ptr<ShardPool> pool;
+      Shard* shard;
+    };
+    // Registry ids are never reused, so a stale entry for a destroyed registry is never looked up.
+    std::unordered_map<uint64_t, Entry> by_registry;
+
+    ~LocalShards() {
+      for (auto& [id, entry] : by_registry) {
+        if (auto pool = entry.pool.lock()) {
+          std::scoped_lock lock{pool->mutex};
+          pool->free.push_back(entry.shard);
+        }
+      }
+    }
+  };
+  thread_local LocalShards local;
+  thread_local uint64_t last_id = 0;
+  thread_local Shard* last_shard = nullptr;
+  if (last_id == id_) {
+    return *last_shard;
+  }
+
+  auto it = local.by_registry.find(id_);
+  if (it == local.by_registry.end()) {
+    Shard* shard;
+    {
+      std::scoped_lock lock{pool_->mutex};
+      if (pool_->free.empty()) {
+        shard = pool_->shards.emplace_back(std::make_unique<Shard>()).get();
+      } else {
+        shard = pool_->free.back();
+        pool_->free.pop_back();
+      }
+    }
+    // The last owner's method pointers may since have been freed; its counts stay.
+    shard->slot_by_name.clear();
+    it = local.by_registry.emplace(id_, LocalShards::Entry{pool_, shard}).first;
+  }
+  last_id = id_;
+  last_shard = it->second.shard;
+  return *last_shard;
+}
+
+size_t RpcMetrics::slotFor(const std::string& method) {
+  std::scoped_lock lock{mutex_};
+  auto it = slot_by_method_.find(method);
+  if (it != slot_by_method_.end()) {
+    return it->second;
+  }
+  if (method_by_slot_.size() == kMaxMethods) {
+    return kMaxMethods;
+  }
+  size_t slot = method_by_slot_.size();
+  method_by_slot_.push_back(method);
+  slot_by_method_.emplace(method, slot);
+  return slot;
+}
+
+RpcMetrics::MethodCounters& RpcMetrics::counters(const char* method) {
+  auto& shard = localShard();
+  auto it = shard.slot_by_name.find(method);
+  if (it == shard.slot_by_name.end()) {
+    it = shard.slot_by_name.emplace(method, slotFor(method == nullptr ? "" : method)).first;
+  }
+  return shard.methods[it->second];
+}
+
+void RpcMetrics::recordStart(const char* method) {
+  counters(method).started.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RpcMetrics::recordFinish(const char* method, std::chrono::nanoseconds latency,
+                              int status_code, uint64_t request_bytes, uint64_t response_bytes) {
+  auto& c = counters(method);
+  c.finished.fetch_add(1, std::memory_order_relaxed);
+  c.request_bytes.fetch_add(request_bytes, std::memory_order_relaxed);
+  c.response_bytes.fetch_add(response_bytes, std::memory_order_relaxed);
+  if (status_code >= 0 && static_cast<size_t>(status_code) < kStatusCodes) {
+    c.status_codes[status_code].fetch_add(1, std::memory_order_relaxed);
+  }
+  c.latency_buckets[latencyBucket(latency)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<MethodSnapshot> RpcMetrics::snapshot() {
+  std::scoped_lock lock{mutex_, pool_->mutex};
+  std::vector<MethodSnapshot> out(method_by_slot_.size() + 1);
+  for (size_t slot = 0; slot < out.size(); slot++) {
+    out[slot].method = slot < method_by_slot_.size() ? method_by_slot_[slot] : "(other)";
+  }
+  for (auto& shard : pool_->shards) {
+    for (size_t slot = 0; slot < out.size(); slot++) {
+      // the overflow slot lives at kMaxMethods, not at method_by_slot_.size()
+      const auto& c = shard->methods[slot < method_by_slot_.size() ? slot : kMaxMethods];
+      auto& s = out[slot];
+      s.started += c.started.load(std::memory_order_relaxed);
+      s.finished += c.finished.load(std::memory_order_relaxed);
+      s.request_bytes += c.request_bytes.load(std::memory_order_relaxed);
+      s.response_bytes += c.response_bytes.load(std::memory_order_relaxed);
+      for (size_t i = 0; i < kStatusCodes; i++) {
+        s.status_codes[i] += c.status_codes[i].load(std::memory_order_relaxed);
+      }
+      for (size_t i = 0; i < kLatencyBuckets; i++) {
+        s.latency_buckets[i] += c.latency_buckets[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::erase_if(out, [](const MethodSnapshot& s) { return s.started == 0 && s.finished == 0; });
+  for (auto& s : out) {
+    s.in_flight = static_cast<int64_t>(s.started) - static_cast<int64_t>(s.finished);
+  }
+  return out;
+}
+
+}  // namespace grpc_instrumentation
@@ -0,0 +1,94 @@
+#ifndef CPP_GRPC_INSTRUMENTATION_RPC_METRICS_H
+#define CPP_GRPC_INSTRUMENTATION_RPC_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace grpc_instrumentation {
+
+// Latency bucket i counts calls that took [2^i, 2^(i+1)) microseconds; bucket 0 also holds
+// anything under 1us and the last bucket holds everything slower.
+inline constexpr size_t kLatencyBuckets = 32;
+inline constexpr size_t kStatusCodes = 17;  // grpc::StatusCode OK through UNAUTHENTICATED
+inline constexpr size_t kMaxMethods = 128;  // methods past this share one "(other)" slot
+
+struct MethodSnapshot {
+  std::string method;
+  uint64_t started = 0;
+  uint64_t finished = 0;
+  int64_t in_flight = 0;
+  uint64_t request_bytes = 0;
+  uint64_t response_bytes = 0;
+  std::array<uint64_t, kStatusCodes> status_codes{};
+  std::array<uint64_t, kLatencyBuckets> latency_buckets{};
+
+  // Upper bound of the bucket holding the given quantile, in microseconds.
+  [[nodiscard]] uint64_t latencyQuantileMicros(double q) const;
+};
+
+// Per-method RPC counters. Each thread records into its own shard with relaxed atomic adds, so
+// the hot path takes no lock and shares no cache lines with other threads. Only the first call
+// for a method on a thread, a thread's exit, and snapshots take a mutex. An exited thread's shard
+// goes to the next new thread, so shards grow with the most threads recording at once.
+class RpcMetrics {
+ public:
+  RpcMetrics();
+  RpcMetrics(const RpcMetrics&) = delete;
+  RpcMetrics& operator=(const RpcMetrics&) = delete;
+
+  // Process-wide instance used by the interceptor factories unless one is passed in.
+  static RpcMetrics& Global();
+
+  void recordStart(const char* method);
+  void recordFinish(const char* method, std::chrono::nanoseconds latency, int status_code,
+                    uint64_t request_bytes, uint64_t response_bytes);
+
+  [[nodiscard]] std::vector<MethodSnapshot> snapshot();
+
+ private:
+  struct alignas(64) MethodCounters {
+    std::atomic<uint64_t> started{0};
+    std::atomic<uint64_t> finished{0};
+    std::atomic<uint64_t> request_bytes{0};
+    std::atomic<uint64_t> response_bytes{0};
+    std::array<std::atomic<uint64_t>, kStatusCodes> status_codes{};
+    std::array<std::atomic<uint64_t>, kLatencyBuckets> latency_buckets{};
+  };
+
+  struct Shard {
+    std::array<MethodCounters, kMaxMethods + 1> methods;
+    // Method name pointers are stable for the life of a server or channel, so lookups hash the
+    // pointer rather than the string.
+    std::unordered_map<const char*, size_t> slot_by_name;
+  };
+
+  // Shared with the threads recording, so that a thread exiting after the registry is destroyed
+  // does not return its shard to a freed pool.
+  struct ShardPool {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Shard>> shards;
+    // Shards of exited threads, handed to the next thread that records.
+    std::vector<Shard*> free;
+  };
+
+  Shard& localShard();
+  MethodCounters& counters(const char* method);
+  size_t slotFor(const std::string& method);
+
+  const uint64_t id_;
+  const std::shared_ptr<ShardPool> pool_;
+  std::mutex mutex_;
+  std::unordered_map<std::string, size_t> slot_by_method_;
+  std::vector<std::string> method_by_slot_;
+};
+
+}  // namespace grpc_instrumentation
+
+#endif
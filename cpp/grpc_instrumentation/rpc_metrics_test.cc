@@ -0,0 +1,85 @@
+#include "cpp/grpc_instrumentation/rpc_metrics.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace grpc_instrumentation;
+using std::chrono::microseconds;
+
+static const char* const kHello = "/example_service.Greeter/SayHello";
+
+TEST(RpcMetrics, RecordsPerMethod) {
+  RpcMetrics metrics;
+  metrics.recordStart(kHello);
+  metrics.recordFinish(kHello, microseconds(100), 0, 10, 20);
+  metrics.recordStart(kHello);
+
+  auto snapshot = metrics.snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  auto& s = snapshot[0];
+  EXPECT_EQ(s.method, kHello);
+  EXPECT_EQ(s.started, 2);
+  EXPECT_EQ(s.finished, 1);
+  EXPECT_EQ(s.in_flight, 1);
+  EXPECT_EQ(s.request_bytes, 10);
+  EXPECT_EQ(s.response_bytes, 20);
+  EXPECT_EQ(s.status_codes[0], 1);
+  EXPECT_EQ(s.latency_buckets[6], 1);  // 64us <= 100us < 128us
+  EXPECT_EQ(s.latencyQuantileMicros(0.5), 128);
+}
+
+TEST(RpcMetrics, MergesThreadShards) {
+  RpcMetrics metrics;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&metrics] {
+      for (int i = 0; i < 1000; i++) {
+        metrics.recordStart(kHello);
+        metrics.recordFinish(kHello, microseconds(3), 5, 1, 1);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  auto snapshot = metrics.snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].finished, 4000);
+  EXPECT_EQ(snapshot[0].in_flight, 0);
+  EXPECT_EQ(snapshot[0].status_codes[5], 4000);
+}
+
+TEST(RpcMetrics, KeepsCountsOfExitedThreads) {
+  RpcMetrics metrics;
+  for (int t = 0; t < 50; t++) {
+    std::thread([&metrics] {
+      metrics.recordStart(kHello);
+      metrics.recordFinish(kHello, microseconds(3), 0, 1, 1);
+    }).join();
+  }
+
+  auto snapshot = metrics.snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].finished, 50);
+  EXPECT_EQ(snapshot[0].in_flight, 0);
+}
+
+TEST(RpcMetrics, OverflowMethodsShareOneSlot) {
+  RpcMetrics metrics;
+  std::vector<std::string> names;
+  for (size_t i = 0; i < kMaxMethods + 3; i++) {
+    names.push_back("/m" + std::to_string(i));
+  }
+  for (auto& name : names) {
+    metrics.recordStart(name.c_str());
+  }
+
+  auto snapshot = metrics.snapshot();
+  ASSERT_EQ(snapshot.size(), kMaxMethods + 1);
+  EXPECT_EQ(snapshot.back().method, "(other)");
+  EXPECT_EQ(snapshot.back().started, 3);
+}
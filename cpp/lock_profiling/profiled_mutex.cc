@@ -0,0 +1,208 @@
+#include "cpp/lock_profiling/profiled_mutex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+
+namespace lock_profiling {
+
+namespace {
+std::atomic<uint64_t> next_profiler_id{1};
+
+size_t timeBucket(std::chrono::nanoseconds time) {
+  auto nanos = time.count();
+  if (nanos <= 1) {
+    return 0;
+  }
+  size_t bucket = std::bit_width(static_cast<uint64_t>(nanos)) - 1;
+  return std::min(bucket, kTimeBuckets - 1);
+}
+
+uint64_t quantileNanos(const std::array<uint64_t, kTimeBuckets>& buckets, double q) {
+  uint64_t total = 0;
+  for (auto count : buckets) {
+    total += count;
+  }
+  if (total == 0) {
+    return 0;
+  }
+  auto target = static_cast<uint64_t>(q * static_cast<double>(total));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kTimeBuckets; i++) {
+    seen += buckets[i];
+    if (seen > target) {
+      return uint64_t{1} << (i + 1);
+    }
+  }
+  return uint64_t{1} << kTimeBuckets;
+}
+
+// Site names come from callers, so quotes, backslashes and control characters are escaped.
+std::string jsonEscape(const std::string& text) {
+  std::string out;
+  out.reserve(text.size());
+  for (char c : text) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          absl::StrAppendFormat(&out, "\\u%04x", static_cast<int>(c));
+        } else {
+          out += c;
+        }
+    }
+  }
+  return out;
+}
+}  // namespace
+
+uint64_t SiteSnapshot::waitQuantileNanos(double q) const { return quantileNanos(wait_buckets, q); }
+
+uint64_t SiteSnapshot::holdQuantileNanos(double q) const { return quantileNanos(hold_buckets, q); }
+
+LockProfiler::LockProfiler()
+    : id_(next_profiler_id.fetch_add(1)), pool_(std::make_shared<ShardPool>()) {
+  site_by_slot_.reserve(kMaxSites + 1);
+}
+
+LockProfiler& LockProfiler::Global() {
+  static LockProfiler* profiler = new LockProfiler();
+  return *profiler;
+}
+
+LockProfiler::Shard& LockProfiler::localShard() {
+  // Returns this thread's shards to their pools when it exits.
+  struct LocalShards {
+    struct Entry {
+      std::weak_ptr<ShardPool> pool;
+      Shard* shard;
+    };
+    // Profiler ids are never reused, so a stale entry for a destroyed profiler is never looked up.
+    std::unordered_map<uint64_t, Entry> by_profiler;
+
+    ~LocalShards() {
+      for (auto& [id, entry] : by_profiler) {
+        if (auto pool = entry.pool.lock()) {
+          std::scoped_lock lock{pool->mutex};
+          pool->free.push_back(entry.shard);
+        }
+      }
+    }
+  };
+  thread_local LocalShards local;
+  thread_local uint64_t last_id = 0;
+  thread_local Shard* last_shard = nullptr;
+  if (last_id == id_) {
+    return *last_shard;
+  }
+
+  auto it = local.by_profiler.find(id_);
+  if (it == local.by_profiler.end()) {
+    Shard* shard;
+    {
+      std::scoped_lock lock{pool_->mutex};
+      if (pool_->free.empty()) {
+        shard = pool_->shards.emplace_back(std::make_unique<Shard>()).get();
+      } else {
+        shard = pool_->free.back();
+        pool_->free.pop_back();
+      }
+    }
+    it = local.by_profiler.emplace(id_, LocalShards::Entry{pool_, shard}).first;
+  }
+  last_id = id_;
+  last_shard = it->second.shard;
+  return *last_shard;
+}
+
+size_t LockProfiler::site(const std::string& name) {
+  std::scoped_lock lock{mutex_};
+  auto it = slot_by_site_.find(name);
+  if (it != slot_by_site_.end()) {
+    return it->second;
+  }
+  if (site_by_slot_.size() == kMaxSites) {
+    return kMaxSites;
+  }
+  size_t slot = site_by_slot_.size();
+  site_by_slot_.push_back(name);
+  slot_by_site_.emplace(name, slot);
+  return slot;
+}
+
+void LockProfiler::record(size_t site, bool contended, std::chrono::nanoseconds wait,
+                          std::chrono::nanoseconds hold) {
+  auto& c = localShard().sites[site];
+  c.acquisitions.fetch_add(1, std::memory_order_relaxed);
+  if (contended) {
+    c.contended.fetch_add(1, std::memory_order_relaxed);
+    c.wait_nanos.fetch_add(wait.count(), std::memory_order_relaxed);
+  }
+  c.hold_nanos.fetch_add(hold.count(), std::memory_order_relaxed);
+  c.wait_buckets[timeBucket(wait)].fetch_add(1, std::memory_order_relaxed);
+  c.hold_buckets[timeBucket(hold)].fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<SiteSnapshot> LockProfiler::snapshot() {
+  std::scoped_lock lock{mutex_, pool_->mutex};
+  std::vector<SiteSnapshot> out(site_by_slot_.size() + 1);
+  for (size_t slot = 0; slot < out.size(); slot++) {
+    out[slot].site = slot < site_by_slot_.size() ? site_by_slot_[slot] : "(other)";
+  }
+  for (auto& shard : pool_->shards) {
+    for (size_t slot = 0; slot < out.size(); slot++) {
+      // the overflow slot lives at kMaxSites, not at site_by_slot_.size()
+      const auto& c = shard->sites[slot < site_by_slot_.size() ? slot : kMaxSites];
+      auto& s = out[slot];
+      s.acquisitions += c.acquisitions.load(std::memory_order_relaxed);
+      s.contended += c.contended.load(std::memory_order_relaxed);
+      s.wait_nanos += c.wait_nanos.load(std::memory_order_relaxed);
+      s.hold_nanos += c.hold_nanos.load(std::memory_order_relaxed);
+      for (size_t i = 0; i < kTimeBuckets; i++) {
+        s.wait_buckets[i] += c.wait_buckets[i].load(std::memory_order_relaxed);
+        s.hold_buckets[i] += c.hold_buckets[i].load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::erase_if(out, [](const SiteSnapshot& s) { return s.acquisitions == 0; });
+  std::stable_sort(out.begin(), out.end(), [](const SiteSnapshot& a, const SiteSnapshot& b) {
+    return a.wait_nanos > b.wait_nanos;
+  });
+  return out;
+}
+
+std::string ToJson(const std::vector<SiteSnapshot>& sites) {
+#ifdef LOCK_PROFILING_DISABLED
+  std::string out = R"({"enabled":false,"locks":[)";
+#else
+  std::string out = R"({"enabled":true,"locks":[)";
+#endif
+  for (size_t i = 0; i < sites.size(); i++) {
+    auto& s = sites[i];
+    absl::StrAppendFormat(
+        &out,
+        R"(%s{"site":"%s","acquisitions":%d,"contended":%d,"waitNanos":%d,"holdNanos":%d,)"
+        R"("waitP50Nanos":%d,"waitP99Nanos":%d,"holdP50Nanos":%d,"holdP99Nanos":%d})",
+        i == 0 ? "" : ",", jsonEscape(s.site), s.acquisitions, s.contended, s.wait_nanos, s.hold_nanos,
+        s.waitQuantileNanos(0.5), s.waitQuantileNanos(0.99), s.holdQuantileNanos(0.5),
+        s.holdQuantileNanos(0.99));
+  }
+  out += "]}";
+  return out;
+}
+
+}  // namespace lock_profiling
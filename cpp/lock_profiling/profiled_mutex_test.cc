@@ -0,0 +1,140 @@
+#include "cpp/lock_profiling/profiled_mutex.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace lock_profiling;
+using namespace std::chrono_literals;
+
+#ifndef LOCK_PROFILING_DISABLED
+TEST(LockProfiler, RecordsPerSite) {
+  LockProfiler profiler;
+  auto games = profiler.site("games");
+  profiler.record(games, false, 0ns, 100ns);
+  profiler.record(games, true, 5000ns, 300ns);
+  profiler.record(profiler.site("users"), false, 0ns, 10ns);
+
+  auto snapshot = profiler.snapshot();
+  ASSERT_EQ(snapshot.size(), 2);
+  auto& s = snapshot[0];
+  EXPECT_EQ(s.site, "games");
+  EXPECT_EQ(s.acquisitions, 2);
+  EXPECT_EQ(s.contended, 1);
+  EXPECT_EQ(s.wait_nanos, 5000);
+  EXPECT_EQ(s.hold_nanos, 400);
+  EXPECT_EQ(s.wait_buckets[0], 1);
+  EXPECT_EQ(s.wait_buckets[12], 1);  // 4096ns <= 5000ns < 8192ns
+  EXPECT_EQ(s.waitQuantileNanos(0.99), 8192);
+  EXPECT_EQ(s.holdQuantileNanos(0.5), 512);
+  EXPECT_EQ(snapshot[1].site, "users");
+}
+
+TEST(LockProfiler, OverflowSitesShareOneSlot) {
+  LockProfiler profiler;
+  for (size_t i = 0; i < kMaxSites + 3; i++) {
+    profiler.record(profiler.site("site" + std::to_string(i)), false, 0ns, 1ns);
+  }
+  auto snapshot = profiler.snapshot();
+  ASSERT_EQ(snapshot.size(), kMaxSites + 1);
+  EXPECT_EQ(snapshot.back().site, "(other)");
+  EXPECT_EQ(snapshot.back().acquisitions, 3);
+}
+
+TEST(ProfiledMutex, MeasuresWaitAndHold) {
+  LockProfiler profiler;
+  ProfiledMutex mutex{"slow", profiler};
+  std::unique_lock held{mutex};
+  std::thread waiter([&mutex] { std::scoped_lock lock{mutex}; });
+  std::this_thread::sleep_for(20ms);
+  held.unlock();
+  waiter.join();
+  EXPECT_TRUE(mutex.try_lock());
+  mutex.unlock();
+
+  auto snapshot = profiler.snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  auto& s = snapshot[0];
+  EXPECT_EQ(s.acquisitions, 3);
+  EXPECT_EQ(s.contended, 1);
+  EXPECT_GE(s.wait_nanos, 10'000'000);
+  EXPECT_GE(s.hold_nanos, 20'000'000);
+  EXPECT_GE(s.waitQuantileNanos(1.0), 16'777'216);
+}
+
+TEST(ProfiledMutex, MergesThreadShards) {
+  LockProfiler profiler;
+  ProfiledMutex mutex{"counter", profiler};
+  int64_t counter = 0;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 1000; i++) {
+        std::scoped_lock lock{mutex};
+        counter++;
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(counter, 4000);
+  auto snapshot = profiler.snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].acquisitions, 4000);
+}
+
+TEST(ProfiledMutex, KeepsCountsOfExitedThreads) {
+  LockProfiler profiler;
+  ProfiledMutex mutex{"short-lived", profiler};
+  for (int t = 0; t < 50; t++) {
+    std::thread([&mutex] { std::scoped_lock lock{mutex}; }).join();
+  }
+  auto snapshot = profiler.snapshot();
+  ASSERT_EQ(snapshot.size(), 1);
+  EXPECT_EQ(snapshot[0].acquisitions, 50);
+}
+
+TEST(ProfiledMutex, ThreadMayOutliveProfiler) {
+  auto profiler = std::make_unique<LockProfiler>();
+  std::promise<void> recorded;
+  std::promise<void> destroyed;
+  std::thread thread([&] {
+    profiler->record(profiler->site("gone"), false, 0ns, 1ns);
+    recorded.set_value();
+    destroyed.get_future().wait();
+  });
+  recorded.get_future().wait();
+  profiler.reset();
+  destroyed.set_value();
+  thread.join();
+}
+#endif
+
+TEST(LockProfiler, ToJson) {
+  SiteSnapshot s{.site = "games", .acquisitions = 2, .contended = 1};
+  s.wait_buckets[3] = 2;
+  auto json = ToJson({s});
+#ifdef LOCK_PROFILING_DISABLED
+  EXPECT_TRUE(json.starts_with(R"({"enabled":false,)")) << json;
+#else
+  EXPECT_TRUE(json.starts_with(R"({"enabled":true,)")) << json;
+#endif
+  EXPECT_NE(json.find(R"("site":"games","acquisitions":2,"contended":1,)"), std::string::npos)
+      << json;
+  EXPECT_NE(json.find(R"("waitP99Nanos":16,)"), std::string::npos) << json;
+  EXPECT_TRUE(ToJson({}).ends_with(R"("locks":[]})"));
+}
+
+TEST(LockProfiler, ToJsonEscapesSites) {
+  SiteSnapshot s{.site = "say \"hi\"\\\n", .acquisitions = 1};
+  auto json = ToJson({s});
+  EXPECT_NE(json.find(R"("site":"say \"hi\"\\\u000a",)"), std::string::npos) << json;
+}
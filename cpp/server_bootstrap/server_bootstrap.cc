@@ -0,0 +1,145 @@
+#include "cpp/server_bootstrap/server_bootstrap.h"
+
+#include <grpcpp/resource_quota.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "absl/flags/flag.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_format.h"
+
+// -1 means "not set on the command line"; see ServerConfigFromFlags.
+ABSL_FLAG(int, grpc_num_cqs, -1, "Sync server completion queues (env GRPC_SERVER_NUM_CQS)");
+ABSL_FLAG(int, grpc_min_pollers, -1,
+          "Minimum pollers per completion queue (env GRPC_SERVER_MIN_POLLERS)");
+ABSL_FLAG(int, grpc_max_pollers, -1,
+          "Maximum pollers per completion queue (env GRPC_SERVER_MAX_POLLERS)");
+ABSL_FLAG(int, grpc_max_threads, -1,
+          "ResourceQuota thread limit for the sync server (env GRPC_SERVER_MAX_THREADS)");
+ABSL_FLAG(int64_t, grpc_quota_bytes, -1,
+          "ResourceQuota memory limit, 0 for unbounded (env GRPC_SERVER_QUOTA_BYTES)");
+ABSL_FLAG(int, grpc_max_concurrent_streams, -1,
+          "Streams per HTTP/2 connection, 0 for gRPC's default "
+          "(env GRPC_SERVER_MAX_CONCURRENT_STREAMS)");
+ABSL_FLAG(int, grpc_max_receive_message_size, -1,
+          "Largest accepted message in bytes, 0 for gRPC's default "
+          "(env GRPC_SERVER_MAX_RECEIVE_MESSAGE_SIZE)");
+ABSL_FLAG(int, grpc_max_send_message_size, -1,
+          "Largest sent message in bytes, 0 for gRPC's default "
+          "(env GRPC_SERVER_MAX_SEND_MESSAGE_SIZE)");
+
+namespace server_bootstrap {
+
+namespace {
+template <typename T>
+T Resolve(const absl::Flag<T>& flag, const char* env, T auto_value) {
+  if (T value = absl::GetFlag(flag); value >= 0) {
+    return value;
+  }
+  if (const char* env_p = std::getenv(env)) {
+    T value;
+    if (absl::SimpleAtoi(env_p, &value) && value >= 0) {
+      return value;
+    }
+    std::cerr << "ignoring invalid " << env << "=" << env_p << std::endl;
+  }
+  return auto_value;
+}
+
+std::string OrDefault(int64_t value) {
+  return value == 0 ? "default" : absl::StrFormat("%d", value);
+}
+}  // namespace
+
+ServerConfig AutoSizedServerConfig(unsigned cores) {
+  int n = static_cast<int>(std::max(1u, cores));
+  // One completion queue per core keeps pollers from contending on a single queue; gRPC's own
+  // default is a single queue. Handler threads may block (e.g. on DocDb), so allow several per core.
+  return ServerConfig{
+      .num_cqs = n,
+      .min_pollers = 1,
+      .max_pollers = 2,
+      .max_threads = 8 * n,
+      .quota_bytes = 0,
+      .max_concurrent_streams = 0,
+      .max_receive_message_size = 0,
+      .max_send_message_size = 0,
+  };
+}
+
+ServerConfig ServerConfigFromFlags() {
+  auto defaults = AutoSizedServerConfig(std::thread::hardware_concurrency());
+  ServerConfig config{
+      .num_cqs = Resolve(FLAGS_grpc_num_cqs, "GRPC_SERVER_NUM_CQS", defaults.num_cqs),
+      .min_pollers =
+          Resolve(FLAGS_grpc_min_pollers, "GRPC_SERVER_MIN_POLLERS", defaults.min_pollers),
+      .max_pollers =
+          Resolve(FLAGS_grpc_max_pollers, "GRPC_SERVER_MAX_POLLERS", defaults.max_pollers),
+      .max_threads =
+          Resolve(FLAGS_grpc_max_threads, "GRPC_SERVER_MAX_THREADS", defaults.max_threads),
+      .quota_bytes =
+          Resolve(FLAGS_grpc_quota_bytes, "GRPC_SERVER_QUOTA_BYTES", defaults.quota_bytes),
+      .max_concurrent_streams =
+          Resolve(FLAGS_grpc_max_concurrent_streams, "GRPC_SERVER_MAX_CONCURRENT_STREAMS",
+                  defaults.max_concurrent_streams),
+      .max_receive_message_size =
+          Resolve(FLAGS_grpc_max_receive_message_size, "GRPC_SERVER_MAX_RECEIVE_MESSAGE_SIZE",
+                  defaults.max_receive_message_size),
+      .max_send_message_size =
+          Resolve(FLAGS_grpc_max_send_message_size, "GRPC_SERVER_MAX_SEND_MESSAGE_SIZE",
+                  defaults.max_send_message_size),
+  };
+  config.num_cqs = std::max(1, config.num_cqs);
+  config.min_pollers = std::max(1, config.min_pollers);
+  config.max_pollers = std::max(config.min_pollers, config.max_pollers);
+  // The sync server needs a thread for every minimum poller before it can run any handler.
+  config.max_threads = std::max(config.max_threads, config.num_cqs * config.min_pollers + 1);
+  return config;
+}
+
+void ApplyServerConfig(const ServerConfig& config, grpc::ServerBuilder& builder) {
+  builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS, config.num_cqs);
+  builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MIN_POLLERS,
+                              config.min_pollers);
+  builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MAX_POLLERS,
+                              config.max_pollers);
+
+  grpc::ResourceQuota quota("server_bootstrap");
+  quota.SetMaxThreads(config.max_threads);
+  if (config.quota_bytes > 0) {
+    quota.Resize(static_cast<size_t>(config.quota_bytes));
+  }
+  builder.SetResourceQuota(quota);
+
+  if (config.max_concurrent_streams > 0) {
+    builder.AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS, config.max_concurrent_streams);
+  }
+  if (config.max_receive_message_size > 0) {
+    builder.SetMaxReceiveMessageSize(config.max_receive_message_size);
+  }
+  if (config.max_send_message_size > 0) {
+    builder.SetMaxSendMessageSize(config.max_send_message_size);
+  }
+}
+
+std::string ToString(const ServerConfig& config) {
+  return absl::StrFormat(
+      "num_cqs=%d min_pollers=%d max_pollers=%d max_threads=%d quota_bytes=%s "
+      "max_concurrent_streams=%s max_receive_message_size=%s max_send_message_size=%s",
+      config.num_cqs, config.min_pollers, config.max_pollers, config.max_threads,
+      config.quota_bytes == 0 ? "unbounded" : absl::StrFormat("%d", config.quota_bytes),
+      OrDefault(config.max_concurrent_streams), OrDefault(config.max_receive_message_size),
+      OrDefault(config.max_send_message_size));
+}
+
+ServerConfig ConfigureServer(grpc::ServerBuilder& builder) {
+  auto config = ServerConfigFromFlags();
+  ApplyServerConfig(config, builder);
+  std::cout << "Server config: " << ToString(config) << std::endl;
+  return config;
+}
+
+}  // namespace server_bootstrap
@@ -0,0 +1,43 @@
+#ifndef CPP_SERVER_BOOTSTRAP_SERVER_BOOTSTRAP_H
+#define CPP_SERVER_BOOTSTRAP_SERVER_BOOTSTRAP_H
+
+#include <grpcpp/server_builder.h>
+
+#include <cstdint>
+#include <string>
+
+namespace server_bootstrap {
+
+// Threading and resource limits for a gRPC server. A value of 0 for the stream and message limits
+// keeps gRPC's own default.
+struct ServerConfig {
+  // Sync server completion queues and the pollers serving each of them.
+  int num_cqs;
+  int min_pollers;
+  int max_pollers;
+  // Upper bound on threads the ResourceQuota lets the sync server spawn for handlers.
+  int max_threads;
+  // Memory the ResourceQuota allows the server's buffers to use; 0 is unbounded.
+  int64_t quota_bytes;
+  int max_concurrent_streams;
+  int max_receive_message_size;
+  int max_send_message_size;
+};
+
+// Defaults sized for `cores` hardware threads.
+ServerConfig AutoSizedServerConfig(unsigned cores);
+
+// Resolves every field from its --grpc_* flag if set, else its GRPC_SERVER_* environment
+// variable, else AutoSizedServerConfig(std::thread::hardware_concurrency()).
+ServerConfig ServerConfigFromFlags();
+
+void ApplyServerConfig(const ServerConfig& config, grpc::ServerBuilder& builder);
+
+std::string ToString(const ServerConfig& config);
+
+// ServerConfigFromFlags, applied to `builder` and printed to stdout.
+ServerConfig ConfigureServer(grpc::ServerBuilder& builder);
+
+}  // namespace server_bootstrap
+
+#endif
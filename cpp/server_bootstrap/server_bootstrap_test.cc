@@ -0,0 +1,67 @@
+#include "cpp/server_bootstrap/server_bootstrap.h"
+
+#include <grpcpp/server.h>
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+#include <memory>
+
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "cpp/example_service/example_service.h"
+
+ABSL_DECLARE_FLAG(int, grpc_num_cqs);
+ABSL_DECLARE_FLAG(int, grpc_max_pollers);
+
+using namespace server_bootstrap;
+
+TEST(ServerBootstrap, AutoSizesFromCores) {
+  auto config = AutoSizedServerConfig(16);
+  EXPECT_EQ(config.num_cqs, 16);
+  EXPECT_EQ(config.max_threads, 128);
+  EXPECT_EQ(config.max_concurrent_streams, 0);
+
+  EXPECT_EQ(AutoSizedServerConfig(0).num_cqs, 1);
+}
+
+TEST(ServerBootstrap, FlagsOverrideEnvironment) {
+  setenv("GRPC_SERVER_NUM_CQS", "3", 1);
+  setenv("GRPC_SERVER_MAX_CONCURRENT_STREAMS", "50", 1);
+  setenv("GRPC_SERVER_MAX_THREADS", "not a number", 1);
+  absl::SetFlag(&FLAGS_grpc_max_pollers, 4);
+
+  auto config = ServerConfigFromFlags();
+  EXPECT_EQ(config.num_cqs, 3);
+  EXPECT_EQ(config.max_pollers, 4);
+  EXPECT_EQ(config.max_concurrent_streams, 50);
+  EXPECT_GE(config.max_threads, config.num_cqs * config.min_pollers + 1);
+
+  absl::SetFlag(&FLAGS_grpc_num_cqs, 2);
+  EXPECT_EQ(ServerConfigFromFlags().num_cqs, 2);
+
+  absl::SetFlag(&FLAGS_grpc_num_cqs, -1);
+  absl::SetFlag(&FLAGS_grpc_max_pollers, -1);
+  unsetenv("GRPC_SERVER_NUM_CQS");
+  unsetenv("GRPC_SERVER_MAX_CONCURRENT_STREAMS");
+  unsetenv("GRPC_SERVER_MAX_THREADS");
+}
+
+TEST(ServerBootstrap, AppliedConfigBuildsServer) {
+  auto config = AutoSizedServerConfig(2);
+  config.quota_bytes = 64 << 20;
+  config.max_concurrent_streams = 10;
+  config.max_receive_message_size = 1 << 20;
+
+  GreeterServiceImpl service;
+  grpc::ServerBuilder builder;
+  builder.RegisterService(&service);
+  ApplyServerConfig(config, builder);
+  std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+  ASSERT_NE(server, nullptr);
+  server->Shutdown();
+
+  EXPECT_EQ(ToString(config),
+            "num_cqs=2 min_pollers=1 max_pollers=2 max_threads=16 quota_bytes=67108864 "
+            "max_concurrent_streams=10 max_receive_message_size=1048576 "
+            "max_send_message_size=default");
+}
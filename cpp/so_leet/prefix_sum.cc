@@ -0,0 +1,81 @@
+#include "cpp/so_leet/prefix_sum.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SO_LEET_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace so_leet::prefix_sum {
+
+int scalar(const int* in, int* out, size_t n, int carry) {
+  // Unsigned so that overflow wraps like the vector kernels instead of being undefined.
+  auto sum = static_cast<uint32_t>(carry);
+  for (size_t i = 0; i < n; i++) {
+    sum += static_cast<uint32_t>(in[i]);
+    out[i] = static_cast<int>(sum);
+  }
+  return static_cast<int>(sum);
+}
+
+#ifdef SO_LEET_X86_KERNELS
+
+// Log-step scan of 8 lanes: shift-and-add inside each 128-bit half, then add the low half's total
+// to the high half.
+__attribute__((target("avx2"))) int avx2(const int* in, int* out, size_t n, int carry) {
+  __m256i running = _mm256_set1_epi32(carry);
+  const __m256i last = _mm256_set1_epi32(7);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+    __m256i low_total = _mm256_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    x = _mm256_add_epi32(x, _mm256_permute2x128_si256(low_total, low_total, 0x08));
+    x = _mm256_add_epi32(x, running);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), x);
+    running = _mm256_permutevar8x32_epi32(x, last);
+  }
+  return scalar(in + i, out + i, n - i, _mm256_extract_epi32(running, 0));
+}
+
+// Same idea over 16 lanes; alignr against zero shifts whole elements across the 128-bit halves.
+__attribute__((target("avx512f"))) int avx512(const int* in, int* out, size_t n, int carry) {
+  __m512i running = _mm512_set1_epi32(carry);
+  const __m512i zero = _mm512_setzero_si512();
+  const __m512i last = _mm512_set1_epi32(15);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i x = _mm512_loadu_si512(in + i);
+    x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 15));
+    x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 14));
+    x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 12));
+    x = _mm512_add_epi32(x, _mm512_alignr_epi32(x, zero, 8));
+    x = _mm512_add_epi32(x, running);
+    _mm512_storeu_si512(out + i, x);
+    running = _mm512_permutexvar_epi32(last, x);
+  }
+  return scalar(in + i, out + i, n - i, _mm_cvtsi128_si32(_mm512_castsi512_si128(running)));
+}
+
+bool supports_avx2() { return __builtin_cpu_supports("avx2"); }
+bool supports_avx512() { return __builtin_cpu_supports("avx512f"); }
+
+#else
+
+int avx2(const int* in, int* out, size_t n, int carry) { return scalar(in, out, n, carry); }
+int avx512(const int* in, int* out, size_t n, int carry) { return scalar(in, out, n, carry); }
+
+bool supports_avx2() { return false; }
+bool supports_avx512() { return false; }
+
+#endif
+
+int dispatch(const int* in, int* out, size_t n, int carry) {
+  using Kernel = int (*)(const int*, int*, size_t, int);
+  static const Kernel kernel = supports_avx512() ? avx512 : supports_avx2() ? avx2 : scalar;
+  return kernel(in, out, n, carry);
+}
+
+}  // namespace so_leet::prefix_sum
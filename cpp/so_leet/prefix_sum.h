@@ -0,0 +1,25 @@
+#ifndef CPP_SO_LEET_PREFIX_SUM_H
+#define CPP_SO_LEET_PREFIX_SUM_H
+
+#include <cstddef>
+
+// Inclusive prefix-sum kernels behind so_leet::running_sum. Each writes out[i] = carry + in[0] +
+// ... + in[i] for i < n and returns the last sum (or `carry` when n is 0). `in` and `out` may be
+// the same array. Sums wrap on overflow.
+namespace so_leet::prefix_sum {
+
+int scalar(const int* in, int* out, size_t n, int carry);
+
+// Only defined on x86-64 GCC/Clang builds; call only when the matching supports_*() is true.
+int avx2(const int* in, int* out, size_t n, int carry);
+int avx512(const int* in, int* out, size_t n, int carry);
+
+bool supports_avx2();
+bool supports_avx512();
+
+// The widest kernel this CPU supports, chosen once on first use.
+int dispatch(const int* in, int* out, size_t n, int carry);
+
+}  // namespace so_leet::prefix_sum
+
+#endif
@@ -1,19 +1,86 @@
 #include "cpp/so_leet/so_leet.h"
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <functional>
-#include <iterator>
 #include <limits>
 #include <numeric>
+#include <span>
+#include <thread>
 #include <vector>
 
+#include "cpp/so_leet/prefix_sum.h"
+
 namespace so_leet {
+namespace {
+// Smallest block worth handing to its own thread.
+constexpr size_t kMinBlock = kParallelRunningSumThreshold / 4;
+
+// Runs f(0) .. f(blocks - 1) on `blocks` threads, one of them the caller's.
+template <typename F>
+void for_each_block(size_t blocks, F&& f) {
+  std::vector<std::thread> workers;
+  workers.reserve(blocks - 1);
+  for (size_t b = 1; b < blocks; b++) {
+    workers.emplace_back(f, b);
+  }
+  f(0);
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+// Splits `n` elements into at most `threads` blocks of at least `min_block` elements.
+size_t block_count(size_t n, unsigned threads, size_t min_block) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return std::max<size_t>(1, std::min<size_t>(threads, n / min_block));
+}
+}  // namespace
+
 std::vector<int> running_sum(std::vector<int>& nums) {
-  std::vector<int> output;
-  std::inclusive_scan(nums.cbegin(), nums.cend(), std::back_inserter(output), std::plus<>());
+  std::vector<int> output(nums.size());
+  parallel_running_sum(nums, output);
   return output;
 }
 
+void running_sum(std::span<const int> nums, std::span<int> out) {
+  assert(out.size() >= nums.size());
+  prefix_sum::dispatch(nums.data(), out.data(), nums.size(), 0);
+}
+
+void parallel_running_sum(std::span<const int> nums, std::span<int> out, unsigned threads) {
+  assert(out.size() >= nums.size());
+  size_t blocks = block_count(nums.size(), threads, kMinBlock);
+  if (nums.size() < kParallelRunningSumThreshold || blocks < 2) {
+    running_sum(nums, out);
+    return;
+  }
+
+  size_t block_size = (nums.size() + blocks - 1) / blocks;
+  auto block = [&](size_t b) {
+    size_t begin = std::min(b * block_size, nums.size());
+    return nums.subspan(begin, std::min(block_size, nums.size() - begin));
+  };
+
+  // Pass 1 reads each block without writing, so `out` may alias `nums`. Totals are unsigned to
+  // wrap like the kernels do.
+  std::vector<uint32_t> offsets(blocks);
+  for_each_block(blocks, [&](size_t b) {
+    auto in = block(b);
+    offsets[b] = std::accumulate(in.begin(), in.end(), uint32_t{0},
+                                 [](uint32_t acc, int x) { return acc + static_cast<uint32_t>(x); });
+  });
+  std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), uint32_t{0});
+  for_each_block(blocks, [&](size_t b) {
+    auto in = block(b);
+    prefix_sum::dispatch(in.data(), out.data() + b * block_size, in.size(),
+                         static_cast<int>(offsets[b]));
+  });
+}
+
 int buy_and_sell_stock(std::vector<int>& prices) {
   int minSoFar = std::numeric_limits<int>::max();
   int bestProfit = 0;
@@ -24,4 +91,42 @@ int buy_and_sell_stock(std::vector<int>& prices) {
   return bestProfit;
 }
 
+PriceSummary PriceSummary::none() {
+  return {std::numeric_limits<int>::max(), std::numeric_limits<int>::min(), 0};
+}
+
+PriceSummary PriceSummary::of(std::span<const int> prices) {
+  PriceSummary summary = none();
+  for (auto price : prices) {
+    summary.min = std::min(summary.min, price);
+    summary.max = std::max(summary.max, price);
+    summary.best = std::max(summary.best, price - summary.min);
+  }
+  return summary;
+}
+
+PriceSummary combine(const PriceSummary& earlier, const PriceSummary& later) {
+  if (earlier.empty()) {
+    return later;
+  }
+  if (later.empty()) {
+    return earlier;
+  }
+  return {std::min(earlier.min, later.min), std::max(earlier.max, later.max),
+          std::max({earlier.best, later.best, later.max - earlier.min})};
+}
+
+int parallel_buy_and_sell_stock(std::span<const int> prices, unsigned threads) {
+  size_t blocks = block_count(prices.size(), threads, kMinBlock);
+  size_t block_size = (prices.size() + blocks - 1) / blocks;
+  std::vector<PriceSummary> summaries(blocks);
+  for_each_block(blocks, [&](size_t b) {
+    size_t begin = std::min(b * block_size, prices.size());
+    summaries[b] =
+        PriceSummary::of(prices.subspan(begin, std::min(block_size, prices.size() - begin)));
+  });
+  // combine is associative but not commutative, so fold in order rather than std::reduce.
+  return std::accumulate(summaries.begin(), summaries.end(), PriceSummary::none(), combine).best;
+}
+
 }  // namespace so_leet
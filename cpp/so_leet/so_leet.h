@@ -1,14 +1,63 @@
 #ifndef CPP_SO_LEET_SO_LEET_H
 #define CPP_SO_LEET_SO_LEET_H
 
+#include <cstddef>
+#include <span>
 #include <vector>
 
 namespace so_leet {
 
 std::vector<int> running_sum(std::vector<int>& nums);
 
+// Writes the inclusive prefix sums of `nums` into `out`, which must be at least as long and may
+// alias `nums` exactly. Uses the widest SIMD kernel the CPU supports.
+void running_sum(std::span<const int> nums, std::span<int> out);
+
+// Inputs shorter than this are not worth waking threads for.
+inline constexpr size_t kParallelRunningSumThreshold = 1 << 18;
+
+// running_sum split into one block per thread: each block's total is reduced in parallel, the
+// totals are scanned serially into per-block offsets, and every block is then scanned from its
+// offset in parallel. `threads` of 0 means std::thread::hardware_concurrency().
+void parallel_running_sum(std::span<const int> nums, std::span<int> out, unsigned threads = 0);
+
 int buy_and_sell_stock(std::vector<int>& prices);
 
+// What buy_and_sell_stock needs to know about a run of prices. Summaries of adjacent runs combine
+// associatively, so a series can be reduced in any grouping: across threads, or chunk by chunk
+// as it arrives.
+struct PriceSummary {
+  int min;
+  int max;
+  // Best single buy-then-sell profit within the run.
+  int best;
+
+  bool empty() const { return min > max; }
+
+  // The identity for combine().
+  static PriceSummary none();
+  static PriceSummary of(std::span<const int> prices);
+};
+
+// Summary of `earlier` followed immediately by `later`.
+PriceSummary combine(const PriceSummary& earlier, const PriceSummary& later);
+
+// buy_and_sell_stock with the series split into one chunk per thread. `threads` of 0 means
+// std::thread::hardware_concurrency().
+int parallel_buy_and_sell_stock(std::span<const int> prices, unsigned threads = 0);
+
+// buy_and_sell_stock over a series fed in consecutive chunks, e.g. reads from a file or socket.
+// Only the running summary is kept.
+class PriceStream {
+ public:
+  void add(std::span<const int> chunk) { summary_ = combine(summary_, PriceSummary::of(chunk)); }
+  int best() const { return summary_.best; }
+  const PriceSummary& summary() const { return summary_; }
+
+ private:
+  PriceSummary summary_ = PriceSummary::none();
+};
+
 }  // namespace so_leet
 
 #endif
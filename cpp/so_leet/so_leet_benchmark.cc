@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "cpp/so_leet/prefix_sum.h"
+#include "cpp/so_leet/so_leet.h"
+
+namespace {
+std::vector<int> RandomInts(size_t n) {
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  std::vector<int> nums(n);
+  for (auto& x : nums) {
+    x = dist(rng);
+  }
+  return nums;
+}
+}  // namespace
+
+// The original implementation, kept as the baseline.
+static void BM_RunningSumBackInserter(benchmark::State& state) {
+  auto nums = RandomInts(state.range(0));
+  for (auto _ : state) {
+    std::vector<int> output;
+    std::inclusive_scan(nums.cbegin(), nums.cend(), std::back_inserter(output), std::plus<>());
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RunningSumBackInserter)->Range(1 << 10, 1 << 24);
+
+template <int (*Kernel)(const int*, int*, size_t, int)>
+static void BM_PrefixSumKernel(benchmark::State& state) {
+  auto nums = RandomInts(state.range(0));
+  std::vector<int> output(nums.size());
+  for (auto _ : state) {
+    Kernel(nums.data(), output.data(), nums.size(), 0);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PrefixSumKernel<so_leet::prefix_sum::scalar>)->Range(1 << 10, 1 << 24);
+BENCHMARK(BM_PrefixSumKernel<so_leet::prefix_sum::dispatch>)->Range(1 << 10, 1 << 24);
+
+static void BM_ParallelRunningSum(benchmark::State& state) {
+  auto nums = RandomInts(state.range(0));
+  std::vector<int> output(nums.size());
+  for (auto _ : state) {
+    so_leet::parallel_running_sum(nums, output, static_cast<unsigned>(state.range(1)));
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelRunningSum)
+    ->ArgsProduct({{1 << 20, 1 << 24}, {2, 4, 8}})
+    ->ArgNames({"n", "threads"})
+    ->UseRealTime();
+
+static void BM_BuyAndSellStock(benchmark::State& state) {
+  auto prices = RandomInts(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(so_leet::buy_and_sell_stock(prices));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuyAndSellStock)->Range(1 << 10, 1 << 26);
+
+static void BM_ParallelBuyAndSellStock(benchmark::State& state) {
+  auto prices = RandomInts(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        so_leet::parallel_buy_and_sell_stock(prices, static_cast<unsigned>(state.range(1))));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParallelBuyAndSellStock)
+    ->ArgsProduct({{1 << 20, 1 << 23, 1 << 26}, {2, 4, 8}})
+    ->ArgNames({"n", "threads"})
+    ->UseRealTime();
+
+// The series fed to a PriceStream in fixed-size chunks, as it would be read from a socket.
+static void BM_StreamingBuyAndSellStock(benchmark::State& state) {
+  auto prices = RandomInts(state.range(0));
+  auto chunk = static_cast<size_t>(state.range(1));
+  for (auto _ : state) {
+    so_leet::PriceStream stream;
+    for (size_t i = 0; i < prices.size(); i += chunk) {
+      stream.add(std::span<const int>(prices).subspan(i, std::min(chunk, prices.size() - i)));
+    }
+    benchmark::DoNotOptimize(stream.best());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StreamingBuyAndSellStock)
+    ->ArgsProduct({{1 << 20, 1 << 23}, {256, 4096, 65536}})
+    ->ArgNames({"n", "chunk"});
+
+BENCHMARK_MAIN();
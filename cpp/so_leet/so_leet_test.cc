@@ -2,8 +2,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "cpp/so_leet/prefix_sum.h"
+
 using namespace so_leet;
 
 TEST(SoLeet, RunningSum) {
@@ -20,3 +27,97 @@ TEST(SoLeet, BuyAndSellStock) {
   int maxProfit = buy_and_sell_stock(prices);
   EXPECT_EQ(maxProfit, 5);
 }
+
+static std::vector<int> RandomInts(size_t n) {
+  std::mt19937 rng(static_cast<uint32_t>(n));
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  std::vector<int> nums(n);
+  for (auto& x : nums) {
+    x = dist(rng);
+  }
+  return nums;
+}
+
+TEST(SoLeet, PrefixSumKernelsMatchScalar) {
+  std::vector<std::pair<bool, int (*)(const int*, int*, size_t, int)>> kernels{
+      {prefix_sum::supports_avx2(), prefix_sum::avx2},
+      {prefix_sum::supports_avx512(), prefix_sum::avx512},
+      {true, prefix_sum::dispatch},
+  };
+  for (size_t n : {0, 1, 7, 8, 9, 15, 16, 17, 33, 100, 1000}) {
+    auto nums = RandomInts(n);
+    std::vector<int> expected(n);
+    int expected_last = prefix_sum::scalar(nums.data(), expected.data(), n, 42);
+    for (auto [supported, kernel] : kernels) {
+      if (!supported) {
+        continue;
+      }
+      std::vector<int> output(n);
+      EXPECT_EQ(kernel(nums.data(), output.data(), n, 42), expected_last) << n;
+      EXPECT_EQ(output, expected) << n;
+    }
+  }
+}
+
+TEST(SoLeet, RunningSumIntoSpan) {
+  std::vector<int> nums{1, 2, 3, 4};
+  running_sum(nums, nums);
+  EXPECT_EQ(nums, (std::vector<int>{1, 3, 6, 10}));
+
+  std::vector<int> empty;
+  running_sum(empty, empty);
+}
+
+TEST(SoLeet, ParallelRunningSumMatchesSerial) {
+  auto nums = RandomInts(kParallelRunningSumThreshold * 3 + 5);
+  std::vector<int> expected(nums.size());
+  std::inclusive_scan(nums.begin(), nums.end(), expected.begin());
+
+  for (unsigned threads : {1, 3, 8}) {
+    std::vector<int> output(nums.size());
+    parallel_running_sum(nums, output, threads);
+    EXPECT_EQ(output, expected) << threads;
+  }
+
+  parallel_running_sum(nums, nums, 4);
+  EXPECT_EQ(nums, expected);
+}
+
+TEST(SoLeet, PriceSummariesCombineInAnyGrouping) {
+  auto prices = RandomInts(1000);
+  int expected = buy_and_sell_stock(prices);
+  std::span<const int> all = prices;
+
+  EXPECT_EQ(PriceSummary::of(all).best, expected);
+  for (size_t split : {0, 1, 499, 999, 1000}) {
+    auto joined = combine(PriceSummary::of(all.first(split)), PriceSummary::of(all.subspan(split)));
+    EXPECT_EQ(joined.best, expected) << split;
+  }
+
+  // Profit can only come from buying before selling.
+  std::vector<int> falling{9, 7, 4, 1};
+  EXPECT_EQ(combine(PriceSummary::of(std::span(falling).first(2)),
+                    PriceSummary::of(std::span(falling).subspan(2)))
+                .best,
+            0);
+}
+
+TEST(SoLeet, ParallelAndStreamingBuyAndSellStock) {
+  auto prices = RandomInts(kParallelRunningSumThreshold * 2 + 3);
+  int expected = buy_and_sell_stock(prices);
+
+  for (unsigned threads : {1, 3, 8}) {
+    EXPECT_EQ(parallel_buy_and_sell_stock(prices, threads), expected) << threads;
+  }
+
+  PriceStream stream;
+  std::span<const int> rest = prices;
+  while (!rest.empty()) {
+    auto chunk = rest.first(std::min<size_t>(4096, rest.size()));
+    stream.add(chunk);
+    rest = rest.subspan(chunk.size());
+  }
+  EXPECT_EQ(stream.best(), expected);
+
+  EXPECT_EQ(PriceStream().best(), 0);
+}